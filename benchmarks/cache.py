@@ -0,0 +1,28 @@
+"""ASV benchmarks of the benchmarks with warm and cold caches.
+
+With ITKPERFORMANCEBENCHMARK_CACHE_MODE=Cold the benchmark executables stream
+through a buffer larger than the last level cache and flush the input images
+before each iteration, as when each volume arrives from disk; the cache mode
+is a parameter of the suite, so that both timings are tracked side by side.
+"""
+
+from itk_perf_shim import run_benchmark
+
+
+class CacheModeSuite:
+    timeout = 600.0
+    unit = "seconds"
+    number = 1
+    repeat = 1
+    params = ["Warm", "Cold"]
+    param_names = ["cache"]
+
+    def track_median(self, cache):
+        return run_benchmark("filtering.median", cache=cache)
+
+    track_median.unit = "seconds"
+
+    def track_unary_add(self, cache):
+        return run_benchmark("filtering.unary_add", cache=cache)
+
+    track_unary_add.unit = "seconds"
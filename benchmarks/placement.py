@@ -0,0 +1,31 @@
+"""ASV benchmarks of the ITK thread pool placement policies.
+
+The workers of ITK's global thread pool are pinned by the benchmark
+executables according to ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT; each
+policy is a parameter of the suite, so that its timings are tracked side by
+side.
+"""
+
+from itk_perf_shim import run_benchmark
+from itk_perf_shim.placement import POLICIES
+
+
+class ThreadPlacementSuite:
+    timeout = 600.0
+    unit = "seconds"
+    number = 1
+    repeat = 1
+    params = list(POLICIES)
+    param_names = ["placement"]
+
+    def track_gradient_magnitude(self, placement):
+        return run_benchmark("filtering.gradient_magnitude",
+                             environment={"ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT": placement})
+
+    track_gradient_magnitude.unit = "seconds"
+
+    def track_median(self, placement):
+        return run_benchmark("filtering.median",
+                             environment={"ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT": placement})
+
+    track_median.unit = "seconds"
@@ -9,6 +9,9 @@ import json
 
 import glob
 
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), 'python'))
+from itk_perf_shim import compare
+
 
 def get_shell_output_as_string(commandlist):
     """
@@ -44,6 +47,8 @@ run_parser.add_argument('benchmark_bin',
 run_parser.add_argument('-r', '--rev-list',
         help='Arguments for "git rev-list" to select the range of commits to benchmark, for example: "--first-parent v4.10.0..v5.0rc1"',
         default='--first-parent HEAD~1..')
+run_parser.add_argument('--thread-placements', nargs='+', default=[],
+        help='run the benchmarks once per ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT policy, e.g. "None Compact ScatterCores ScatterCaches SMTSiblings"')
 
 upload_parser = subparsers.add_parser('upload',
         help='upload the benchmarks to data.kitware.com')
@@ -62,9 +67,15 @@ revisions_parser.add_argument('-d', '--descriptions', nargs='*',
         help='descriptions for the sha revisions, used in the legend')
 revisions_parser.add_argument('-t', '--title', default='Revision Comparison',
         help='plot title')
+revisions_parser.add_argument('--statistics', nargs='*', default=['Mean', 'Percentile99'],
+        help='probe statistics printed for each revision, e.g. Mean Median MedianAbsoluteDeviation Percentile99')
 revisions_parser.add_argument('benchmark_bin',
         help='ITK performance benchmarks build directory', action = FullPaths)
 
+compare_parser = subparsers.add_parser('compare',
+        help='statistical comparison of two sets of benchmark results, exits with 1 on a regression')
+compare.add_arguments(compare_parser)
+
 args = parser.parse_args()
 
 def check_for_required_programs(command):
@@ -192,9 +203,17 @@ def build_benchmarks(benchmark_src, benchmark_bin,
         benchmark_src])
     subprocess.check_call(['ninja'])
 
-def run_benchmarks(benchmark_bin, itk_information):
+def run_benchmarks(benchmark_bin, itk_information, thread_placements=None):
     os.chdir(benchmark_bin)
-    subprocess.check_call(['ctest'])
+    if not thread_placements:
+        subprocess.check_call(['ctest'])
+        return
+    # The policy in effect is recorded in the ExecutionContext of each result
+    for placement in thread_placements:
+        print('\nThread placement: ' + placement)
+        environment = dict(os.environ)
+        environment['ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT'] = placement
+        subprocess.check_call(['ctest'], env=environment)
 
 def upload_benchmark_results(benchmark_bin, api_key=None):
     hostname = socket.gethostname().lower()
@@ -213,7 +232,7 @@ def upload_benchmark_results(benchmark_bin, api_key=None):
             leafFoldersAsItems=False, reuseExisting=True)
 
 def visualize_revisions(benchmark_results_dir, shas, benchmark_names=None,
-        title='Revision Comparison', sha_descriptions=None):
+        title='Revision Comparison', sha_descriptions=None, statistics=None):
     import plotly.plotly as py
     import plotly.graph_objs as go
 
@@ -256,6 +275,13 @@ def visualize_revisions(benchmark_results_dir, shas, benchmark_names=None,
                 if benchmark_names:
                     if not benchmark_name in benchmark_names:
                         continue
+                if statistics:
+                    # Older results predate the percentile fields
+                    summary = ['{0}={1}'.format(statistic,
+                        data['Probes'][0].get(statistic, 'n/a'))
+                        for statistic in statistics]
+                    print('{0:40} {1:30} {2}'.format(name, benchmark_name,
+                        ' '.join(summary)))
                 max_time = max(max_time, max(benchmark_values))
                 for value in benchmark_values:
                     dataset['x'].append(benchmark_name)
@@ -356,7 +382,8 @@ if args.command == 'run':
                 itk_has_buildinformation, itk_has_NumberOfThreads)
 
         print('\nRunning benchmarks...')
-        run_benchmarks(args.benchmark_bin, itk_information)
+        run_benchmarks(args.benchmark_bin, itk_information,
+                args.thread_placements)
 
         print('\nDone running performance benchmarks.')
 elif args.command == 'upload':
@@ -366,4 +393,7 @@ elif args.command == 'revisions':
             args.sha,
             benchmark_names=args.names,
             title=args.title,
-            sha_descriptions=args.descriptions)
+            sha_descriptions=args.descriptions,
+            statistics=args.statistics)
+elif args.command == 'compare':
+    sys.exit(compare.run(args))
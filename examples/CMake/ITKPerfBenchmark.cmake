@@ -0,0 +1,13 @@
+# itk_perf_add_benchmark(<name> <source>)
+#
+# Adds the executable <name> of the benchmark defined with ITK_PERF_BENCHMARK
+# in <source>, and records <source> and the ITK libraries it links to, to also
+# be linked into ITKPerfRunner.
+set(ITK_PERF_BENCHMARK_MAIN ${CMAKE_CURRENT_LIST_DIR}/../Common/BenchmarkMain.cxx)
+
+function(itk_perf_add_benchmark name source)
+  add_executable(${name} ${source} ${ITK_PERF_BENCHMARK_MAIN})
+  target_link_libraries(${name} ${ITK_LIBRARIES})
+  set_property(GLOBAL APPEND PROPERTY ITK_PERF_BENCHMARK_SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/${source})
+  set_property(GLOBAL APPEND PROPERTY ITK_PERF_BENCHMARK_LIBRARIES ${ITK_LIBRARIES})
+endfunction()
@@ -0,0 +1,203 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkImageFixture_h
+#define itkBenchmarkImageFixture_h
+
+#include "itkContinuousIndex.h"
+#include "itkImageDuplicator.h"
+#include "itkImageFileReader.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkResampleImageFilter.h"
+#include "PerformanceBenchmarkingUtilities.h"
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace itk
+{
+/** \class BenchmarkImageFixture
+ * \brief The input images of the benchmarks of a process, each read once.
+ *
+ * ReadImage() reads an image file the first time a benchmark asks for it as
+ * an image type, and then returns copies of it, so that a benchmark can not
+ * change the input of the next one. The benchmarks run by ITKPerfRunner
+ * share the fixture, and do not read and decode the same file again.
+ *
+ * With the --size of the options, see ParseBenchmarkOptions(), the image is
+ * resampled to that size over the same physical extent, so that a benchmark
+ * runs on the same anatomy at any problem size. MapIndex() maps an index of
+ * the file, e.g. a seed, to the resampled image. CreateImage() generates a
+ * synthetic image of any size, for the benchmarks without an input file.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class BenchmarkImageFixture
+{
+public:
+  /** A copy of the image of a file, disconnected from any pipeline, resampled
+   * to the --size of the options when it is given. Throws
+   * itk::ExceptionObject when the file can not be read, or when the size does
+   * not fit the dimension of the image. */
+  template <typename TImage>
+  typename TImage::Pointer
+  ReadImage(const std::string & fileName)
+  {
+    typename TImage::SizeType size;
+    if (!GetBenchmarkOptions().m_Size.empty())
+    {
+      if (!GetBenchmarkImageSize(GetBenchmarkOptions(), size))
+      {
+        itkGenericExceptionMacro(<< "The size of the options does not fit an image of dimension "
+                                 << TImage::ImageDimension);
+      }
+      return this->ReadImage<TImage>(fileName, size);
+    }
+    return Duplicate<TImage>(this->GetFileImage<TImage>(fileName));
+  }
+
+  /** A copy of the image of a file, resampled to size over the same physical
+   * extent, with a linear interpolation. */
+  template <typename TImage>
+  typename TImage::Pointer
+  ReadImage(const std::string & fileName, const typename TImage::SizeType & size)
+  {
+    const TImage *     fileImage = this->GetFileImage<TImage>(fileName);
+    std::ostringstream key;
+    key << fileName << '@' << size;
+    DataObject::Pointer & image = this->m_Images[{ key.str(), std::type_index(typeid(TImage)) }];
+    if (image.IsNull())
+    {
+      auto resample = ResampleImageFilter<TImage, TImage>::New();
+      resample->SetInput(fileImage);
+      resample->SetOutputParametersFromImage(CreateResampledGeometry(fileImage, size));
+      resample->UpdateLargestPossibleRegion();
+      image = resample->GetOutput();
+      image->DisconnectPipeline();
+    }
+    return Duplicate<TImage>(static_cast<const TImage *>(image.GetPointer()));
+  }
+
+  /** The index, in the image of ReadImage(), of the physical point of an
+   * index of the file. The index itself without the --size of the options. */
+  template <typename TImage>
+  typename TImage::IndexType
+  MapIndex(const std::string & fileName, const typename TImage::IndexType & index)
+  {
+    typename TImage::SizeType size;
+    if (!GetBenchmarkImageSize(GetBenchmarkOptions(), size))
+    {
+      return index;
+    }
+    const TImage *             fileImage = this->GetFileImage<TImage>(fileName);
+    typename TImage::PointType point;
+    fileImage->TransformIndexToPhysicalPoint(index, point);
+    typename TImage::IndexType mappedIndex;
+    if (!CreateResampledGeometry(fileImage, size)->TransformPhysicalPointToIndex(point, mappedIndex))
+    {
+      itkGenericExceptionMacro(<< "The index " << index << " is not in the image of " << fileName);
+    }
+    return mappedIndex;
+  }
+
+  /** A synthetic image of size, with a unit spacing and a zero origin, filled
+   * with the pattern index[0] - index[1] + index[2] - ..., which has edges in
+   * every direction. */
+  template <typename TImage>
+  static typename TImage::Pointer
+  CreateImage(const typename TImage::SizeType & size)
+  {
+    auto image = TImage::New();
+    image->SetRegions(typename TImage::RegionType(size));
+    image->Allocate();
+
+    ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      IndexValueType value = 0;
+      for (unsigned int dimension = 0; dimension < TImage::ImageDimension; ++dimension)
+      {
+        value += dimension % 2 == 0 ? it.GetIndex()[dimension] : -it.GetIndex()[dimension];
+      }
+      it.Set(static_cast<typename TImage::PixelType>(value));
+    }
+    return image;
+  }
+
+private:
+  template <typename TImage>
+  const TImage *
+  GetFileImage(const std::string & fileName)
+  {
+    DataObject::Pointer & image = this->m_Images[{ fileName, std::type_index(typeid(TImage)) }];
+    if (image.IsNull())
+    {
+      auto reader = ImageFileReader<TImage>::New();
+      reader->SetFileName(fileName);
+      reader->UpdateLargestPossibleRegion();
+      image = reader->GetOutput();
+      image->DisconnectPipeline();
+    }
+    return static_cast<const TImage *>(image.GetPointer());
+  }
+
+  template <typename TImage>
+  static typename TImage::Pointer
+  Duplicate(const TImage * image)
+  {
+    auto duplicator = ImageDuplicator<TImage>::New();
+    duplicator->SetInputImage(image);
+    duplicator->Update();
+    return duplicator->GetOutput();
+  }
+
+  /** An image without pixels, of size, covering the extent of image: the
+   * borders of the first and the last voxels are the same. */
+  template <typename TImage>
+  static typename TImage::Pointer
+  CreateResampledGeometry(const TImage * image, const typename TImage::SizeType & size)
+  {
+    const typename TImage::RegionType & region = image->GetLargestPossibleRegion();
+
+    typename TImage::SpacingType                                spacing;
+    ContinuousIndex<SpacePrecisionType, TImage::ImageDimension> firstVoxel;
+    for (unsigned int dimension = 0; dimension < TImage::ImageDimension; ++dimension)
+    {
+      const double scale = static_cast<double>(region.GetSize(dimension)) / size[dimension];
+      spacing[dimension] = image->GetSpacing()[dimension] * scale;
+      firstVoxel[dimension] = region.GetIndex(dimension) - 0.5 + 0.5 * scale;
+    }
+    typename TImage::PointType origin;
+    image->TransformContinuousIndexToPhysicalPoint(firstVoxel, origin);
+
+    auto geometry = TImage::New();
+    geometry->SetRegions(typename TImage::RegionType(size));
+    geometry->SetSpacing(spacing);
+    geometry->SetOrigin(origin);
+    geometry->SetDirection(image->GetDirection());
+    return geometry;
+  }
+
+  std::map<std::pair<std::string, std::type_index>, DataObject::Pointer> m_Images;
+};
+} // end namespace itk
+
+#endif // itkBenchmarkImageFixture_h
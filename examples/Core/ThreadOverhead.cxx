@@ -22,9 +22,11 @@
 #include "itkHighPriorityRealTimeProbe.h"
 #include "itkHighPriorityRealTimeProbesCollector.h"
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkRegistry.h"
 
 // This benchmark estimate the overhead for using an additional thread
 // in an ImageFilter a.k.a the time it takes to "spawn" a thread.
@@ -99,39 +101,48 @@ time_it(unsigned int threads, unsigned int iterations)
   filter->SetInput(image);
   filter->SET_PARALLEL_UNITS(threads);
 
-  // execute one time out of the loop to allocate memory
-  filter->UpdateLargestPossibleRegion();
+  // execute out of the loop to allocate memory, at least once
+  for (int warmUp = 0; warmUp < std::max(GetBenchmarkOptions().m_WarmUpIterations, 1); ++warmUp)
+  {
+    image->Modified();
+    filter->UpdateLargestPossibleRegion();
+  }
 
   std::ostringstream ss;
   ss << "FilterWithThreads-" << threads;
 
-  const std::string name = ss.str();
+  // Look the probe up once, outside of the timed region.
+  const CollectorType::ProbeHandleType probe = collector.GetProbeHandle(ss.str().c_str());
 
-  for (unsigned ii = 0; ii < iterations; ++ii)
+  itk::BenchmarkLoopDriver driver = CreateBenchmarkLoopDriver(static_cast<int>(iterations));
+  while (driver.Continue())
   {
     image->Modified();
-    collector.Start(name.c_str());
+    const double total = collector.GetProbe(probe).GetTotal();
+    collector.Start(probe);
     filter->UpdateLargestPossibleRegion();
-    collector.Stop(name.c_str());
+    collector.Stop(probe);
+    driver.AddSample(collector.GetProbe(probe).GetTotal() - total);
   }
+  AddIterationControlToReport(ss.str(), driver);
 
-  return collector.GetProbe(name.c_str());
+  return collector.GetProbe(probe);
 }
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(ThreadOverheadBenchmark, itk::BenchmarkNoFixture, "{timings}", "1000")
 {
-  if (argc > 3)
+  BenchmarkOptions options;
+  options.m_Iterations = 500;
+  if (!ParseBenchmarkOptions(argc, argv, { "timingsFile", "[iterations]", "[threads]" }, options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile [iterations [threads]]" << std::endl;
     return EXIT_FAILURE;
   }
 
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = (argc > 2) ? std::stoi(argv[2]) : 500;
-  const int         threads = (argc > 3) ? std::stoi(argv[3]) : MultiThreaderName::GetGlobalDefaultNumberOfThreads();
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const int           threads =
+    options.m_Threads > 0 ? options.m_Threads : MultiThreaderName::GetGlobalDefaultNumberOfThreads();
 
   if (threads == 1)
   {
@@ -139,6 +150,7 @@ main(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
+  SetUpBenchmarkCollector(collector);
   ProbeType t1 = time_it(1, iterations);
   ProbeType t2 = time_it(threads, iterations);
 
@@ -146,7 +158,9 @@ main(int argc, char * argv[])
 
   double cost = (t2.GetMinimum() - t1.GetMinimum()) / (threads - 1.0);
 
-  std::cout << "\n\nEstimated overhead cost per thread: " << cost * 1e6 << " micro-seconds\n\n";
+  std::cout << "\n\nEstimated overhead cost per thread: " << cost * 1e6 << " micro-seconds\n";
+  // The cost of the probe itself is included in both measurements.
+  std::cout << "Calibrated probe overhead: " << collector.GetProbeOverhead() * 1e6 << " micro-seconds\n\n";
 
   return EXIT_SUCCESS;
 }
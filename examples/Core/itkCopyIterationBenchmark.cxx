@@ -29,10 +29,13 @@
 #include "itkImageAlgorithm.h"
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkRegistry.h"
 #include <iomanip>
 #include <fstream>
 
 
+namespace
+{
 // Pixel-construction traits.
 //
 // For scalar and FixedArray-backed images, `static_cast<PixelType>(count)`
@@ -211,35 +214,19 @@ CopyImageRegionRangeForLoop(const TInputImage * inputPtr, TOutputImage * outputP
 }
 
 
-// Helper function to time a single method
-template <typename TInputImage, typename TOutputImage, typename TCopyFunction>
-void
-TimeMethod(itk::HighPriorityRealTimeProbesCollector & collector,
-           const std::string &                        methodName,
-           TCopyFunction                              copyFunc,
-           const TInputImage *                        inputImage,
-           typename TOutputImage::Pointer &           outputImage,
-           int                                        iterations)
+// Helper function to allocate the output image of the methods
+template <typename TInputImage, typename TOutputImage>
+typename TOutputImage::Pointer
+CreateOutputImage(const TInputImage * inputImage)
 {
-  // Allocate output image
-  outputImage = TOutputImage::New();
+  auto outputImage = TOutputImage::New();
   outputImage->SetRegions(inputImage->GetLargestPossibleRegion());
   if (inputImage->GetNumberOfComponentsPerPixel() > 0)
   {
     outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
   }
   outputImage->Allocate();
-
-  // Warm-up run
-  copyFunc(inputImage, outputImage.GetPointer());
-
-  // Timed runs
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    collector.Start(methodName.c_str());
-    copyFunc(inputImage, outputImage.GetPointer());
-    collector.Stop(methodName.c_str());
-  }
+  return outputImage;
 }
 
 
@@ -254,66 +241,59 @@ TimeIterationMethods(itk::HighPriorityRealTimeProbesCollector & collector,
 {
   // Create and initialize input image
   auto inputImage = CreateAndInitializeImage<TInputImage>(size, numberOfComponentsPerPixel);
-
-  typename TOutputImage::Pointer outputImage;
-
-  // Test Method 0: ImageAlgorithm::Copy
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-ImageAlgorithm",
-                                        CopyImageAlgorithm<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 1: Region Iterator
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-RegionIterator",
-                                        CopyRegionIterator<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 2: Scanline Iterator
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-ScanlineIterator",
-                                        CopyScanlineIterator<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 3: ImageRegionRange
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Range",
-                                        CopyImageRegionRange<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 4: ImageRegionRange with range-based for loop
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-RangeForLoop",
-                                        CopyImageRegionRangeForLoop<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
+  auto outputImage = CreateOutputImage<TInputImage, TOutputImage>(inputImage.GetPointer());
+
+  const TInputImage * input = inputImage.GetPointer();
+  TOutputImage *      output = outputImage.GetPointer();
+
+  // Each method reads the input and writes the output once.
+  BenchmarkWorkload workload;
+  workload.m_Voxels = input->GetLargestPossibleRegion().GetNumberOfPixels();
+  workload.m_Bytes = GetImageMemoryRange(input).second + GetImageMemoryRange(output).second;
+
+  // The methods run in turn, in a random order, so that drift affects them alike.
+  TimeVariants(collector,
+               description,
+               {
+                 // Method 0: ImageAlgorithm::Copy
+                 { description + "-ImageAlgorithm",
+                   [input, output]() { CopyImageAlgorithm<TInputImage, TOutputImage>(input, output); } },
+                 // Method 1: Region Iterator
+                 { description + "-RegionIterator",
+                   [input, output]() { CopyRegionIterator<TInputImage, TOutputImage>(input, output); } },
+                 // Method 2: Scanline Iterator
+                 { description + "-ScanlineIterator",
+                   [input, output]() { CopyScanlineIterator<TInputImage, TOutputImage>(input, output); } },
+                 // Method 3: ImageRegionRange
+                 { description + "-Range",
+                   [input, output]() { CopyImageRegionRange<TInputImage, TOutputImage>(input, output); } },
+                 // Method 4: ImageRegionRange with range-based for loop
+                 { description + "-RangeForLoop",
+                   [input, output]() { CopyImageRegionRangeForLoop<TInputImage, TOutputImage>(input, output); } },
+               },
+               iterations,
+               workload);
 }
+} // namespace
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(CopyIterationBenchmark, itk::BenchmarkNoFixture, "{timings}", "25", "128")
 {
-  if (argc < 4)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc, argv, { "timingsFile", "iterations", "size" }, options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations imageSize" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  const int         imageSize = std::stoi(argv[3]);
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
 
   constexpr unsigned int Dimension = 3;
-  const auto             size = itk::Size<Dimension>::Filled(imageSize);
+  itk::Size<Dimension>   size;
+  if (!GetBenchmarkImageSize(options, size))
+  {
+    std::cerr << "The size must have 1 or " << Dimension << " extents" << std::endl;
+    return EXIT_FAILURE;
+  }
 
   itk::HighPriorityRealTimeProbesCollector collector;
 
@@ -31,6 +31,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkRegistry.h"
 #include "itkNumericTraits.h"
 #include <iomanip>
 #include <fstream>
@@ -40,7 +41,6 @@ namespace
 {
 template <typename T>
 static constexpr bool isVariableLengthVector = std::is_same_v<T, itk::VariableLengthVector<typename T::ValueType>>;
-}
 
 // Helper function to initialize an image with random values
 template <typename TImage>
@@ -278,32 +278,16 @@ CopyImageRegionRangeNumericTraitsAsRange(const TInputImage * inputPtr, TOutputIm
 }
 
 
-// Helper function to time a single method
-template <typename TInputImage, typename TOutputImage, typename TCopyFunction>
-void
-TimeMethod(itk::HighPriorityRealTimeProbesCollector & collector,
-           const std::string &                        methodName,
-           TCopyFunction                              copyFunc,
-           const TInputImage *                        inputImage,
-           typename TOutputImage::Pointer &           outputImage,
-           int                                        iterations)
+// Helper function to allocate the output image of the methods
+template <typename TInputImage, typename TOutputImage>
+typename TOutputImage::Pointer
+CreateOutputImage(const TInputImage * inputImage)
 {
-  // Allocate output image
-  outputImage = TOutputImage::New();
+  auto outputImage = TOutputImage::New();
   outputImage->SetRegions(inputImage->GetLargestPossibleRegion());
   outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
   outputImage->Allocate();
-
-  // Warm-up run
-  copyFunc(inputImage, outputImage.GetPointer());
-
-  // Timed runs
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    collector.Start(methodName.c_str());
-    copyFunc(inputImage, outputImage.GetPointer());
-    collector.Stop(methodName.c_str());
-  }
+  return outputImage;
 }
 
 
@@ -318,67 +302,60 @@ TimeIterationMethods(itk::HighPriorityRealTimeProbesCollector & collector,
 
   // Create and initialize input image
   auto inputImage = CreateAndInitializeImage<TInputImage>(size, 3);
+  auto outputImage = CreateOutputImage<TInputImage, TOutputImage>(inputImage.GetPointer());
 
-  typename TOutputImage::Pointer referenceImage;
-  typename TOutputImage::Pointer outputImage;
-
-  // Test Method 1: Scanline Iterator - serves as reference
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Scanline",
-                                        CopyScanlineIterator<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 2: ImageRegionRange
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Range",
-                                        CopyImageRegionRange<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 1b: Scanline Iterator with NumericTraits
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Scanline NT",
-                                        CopyScanlineIteratorNumericTraits<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 2b: ImageRegionRange with NumericTraits
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Range NT",
-                                        CopyImageRegionRangeNumericTraits<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
-
-  // Test Method 2c: ImageRegionRange with NumericTraits - buggy version
-  TimeMethod<TInputImage, TOutputImage>(collector,
-                                        description + "-Range NT AsRange",
-                                        CopyImageRegionRangeNumericTraitsAsRange<TInputImage, TOutputImage>,
-                                        inputImage.GetPointer(),
-                                        outputImage,
-                                        iterations);
+  const TInputImage * input = inputImage.GetPointer();
+  TOutputImage *      output = outputImage.GetPointer();
+
+  // Each method reads the input and writes the output once.
+  BenchmarkWorkload workload;
+  workload.m_Voxels = input->GetLargestPossibleRegion().GetNumberOfPixels();
+  workload.m_Bytes = GetImageMemoryRange(input).second + GetImageMemoryRange(output).second;
+
+  // The methods run in turn, in a random order, so that drift affects them
+  // alike; they are compared with the Scanline Iterator.
+  TimeVariants(
+    collector,
+    description,
+    {
+      // Test Method 1: Scanline Iterator - serves as reference
+      { description + "-Scanline",
+        [input, output]() { CopyScanlineIterator<TInputImage, TOutputImage>(input, output); } },
+      // Test Method 2: ImageRegionRange
+      { description + "-Range", [input, output]() { CopyImageRegionRange<TInputImage, TOutputImage>(input, output); } },
+      // Test Method 1b: Scanline Iterator with NumericTraits
+      { description + "-Scanline NT",
+        [input, output]() { CopyScanlineIteratorNumericTraits<TInputImage, TOutputImage>(input, output); } },
+      // Test Method 2b: ImageRegionRange with NumericTraits
+      { description + "-Range NT",
+        [input, output]() { CopyImageRegionRangeNumericTraits<TInputImage, TOutputImage>(input, output); } },
+      // Test Method 2c: ImageRegionRange with NumericTraits - buggy version
+      { description + "-Range NT AsRange",
+        [input, output]() { CopyImageRegionRangeNumericTraitsAsRange<TInputImage, TOutputImage>(input, output); } },
+    },
+    iterations,
+    workload);
 }
+} // namespace
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(VectorIterationBenchmark, itk::BenchmarkNoFixture, "{timings}", "50", "128")
 {
-  if (argc < 4)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc, argv, { "timingsFile", "iterations", "size" }, options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations imageSize" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  const int         imageSize = std::stoi(argv[3]);
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
 
   constexpr unsigned int Dimension = 3;
-  const auto             size = itk::Size<Dimension>::Filled(imageSize);
+  itk::Size<Dimension>   size;
+  if (!GetBenchmarkImageSize(options, size))
+  {
+    std::cerr << "The size must have 1 or " << Dimension << " extents" << std::endl;
+    return EXIT_FAILURE;
+  }
 
   std::ostringstream oss;
   oss << "Image Size: " << size;
@@ -16,32 +16,39 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkMinMaxCurvatureFlowImageFilter.h"
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 #include <fstream>
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(MinMaxCurvatureFlowBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17.mha",
+                   "{output}/MinMaxCurvatureFlowBenchmark.mha")
 {
-  if (argc < 6)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc,
+                             argv,
+                             { "timingsFile", "iterations", "threads", "inputImageFile", "outputImageFile" },
+                             options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads inputImageFile outputImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      inputImageFileName = argv[4];
-  const char *      outputImageFileName = argv[5];
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & inputImageFileName = options.m_Arguments["inputImageFile"];
+  const std::string & outputImageFileName = options.m_Arguments["outputImageFile"];
 
-  if (threads > 0)
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -51,20 +58,16 @@ main(int argc, char * argv[])
   using InputImageType = itk::Image<InputPixelType, Dimension>;
   using OutputImageType = itk::Image<OutputPixelType, Dimension>;
 
-  using ReaderType = itk::ImageFileReader<InputImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(inputImageFileName);
+  InputImageType::Pointer inputImage;
   try
   {
-    reader->Update();
+    inputImage = fixture.ReadImage<InputImageType>(inputImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  InputImageType::Pointer inputImage = reader->GetOutput();
-  inputImage->DisconnectPipeline();
 
   using FilterType = itk::MinMaxCurvatureFlowImageFilter<InputImageType, OutputImageType>;
   FilterType::Pointer filter = FilterType::New();
@@ -74,13 +77,14 @@ main(int argc, char * argv[])
   filter->SetInput(inputImage);
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    inputImage->Modified();
-    collector.Start("MinMaxCurvatureFlow");
-    filter->UpdateLargestPossibleRegion();
-    collector.Stop("MinMaxCurvatureFlow");
-  }
+  TimeIterations(
+    collector,
+    "MinMaxCurvatureFlow",
+    iterations,
+    [&]() { inputImage->Modified(); },
+    [&]() { filter->UpdateLargestPossibleRegion(); },
+    { GetImageMemoryRange(inputImage.GetPointer()) },
+    GetImageFilterWorkload<OutputImageType>(inputImage.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
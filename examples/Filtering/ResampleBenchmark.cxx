@@ -56,6 +56,8 @@
 
 // Includes for ITK performance benchmarking
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 #include "itkHighPriorityRealTimeProbesCollector.h"
 
 // Standard Library includes
@@ -70,26 +72,19 @@ template <typename ImageType>
 typename ImageType::Pointer
 CreateInputImage(const std::vector<int> & imageSizes)
 {
-  auto                         image = ImageType::New();
   typename ImageType::SizeType imageSize;
   for (std::size_t i = 0; i < imageSizes.size(); ++i)
   {
     imageSize[i] = imageSizes[i];
   }
-  image->SetRegions(typename ImageType::RegionType(imageSize));
-  image->Allocate();
+  auto image = itk::BenchmarkImageFixture::CreateImage<ImageType>(imageSize);
 
-  typename ImageType::SpacingType spacing;
-  typename ImageType::PointType   origin;
-
-  if (ImageType::ImageDimension < 3)
-  {
-    spacing.Fill(1.0);
-    origin.Fill(0.0);
-  }
-  else
+  if (ImageType::ImageDimension >= 3)
   {
     // Use the same image properties as in original Insight Journal article
+    typename ImageType::SpacingType spacing;
+    typename ImageType::PointType   origin;
+
     spacing[0] = 0.660156;
     spacing[1] = 0.660156;
     spacing[2] = 1.5;
@@ -97,32 +92,9 @@ CreateInputImage(const std::vector<int> & imageSizes)
     origin[0] = -157.67;
     origin[1] = -362.67;
     origin[2] = -1198.6;
-  }
-
-  image->SetSpacing(spacing);
-  image->SetOrigin(origin);
-
-  // Fill the image with some test gradient pattern
-  auto                                value = itk::NumericTraits<typename ImageType::PixelType>::ZeroValue();
-  itk::ImageRegionIterator<ImageType> iter(image, image->GetLargestPossibleRegion());
-  while (!iter.IsAtEnd())
-  {
-    switch (ImageType::ImageDimension)
-    {
-      case 1:
-        iter.Set(++value);
-        break;
-      case 2:
-        iter.Set(iter.GetIndex()[0] - iter.GetIndex()[1]);
-        break;
-      case 3:
-        iter.Set(iter.GetIndex()[0] - iter.GetIndex()[1] + iter.GetIndex()[2]);
-        break;
-      default:
-        break;
-    }
 
-    ++iter;
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
   }
 
   return image;
@@ -885,9 +857,9 @@ int
 ProcessImage(const Parameters & _parameters)
 {
   // Setting the threads
-  if (_parameters.threads > 0)
+  if (!SetUpBenchmarkEnvironment(_parameters.threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(_parameters.threads);
+    return EXIT_FAILURE;
   }
 
   // Input image dimension
@@ -1022,6 +994,21 @@ ProcessImage(const Parameters & _parameters)
   }
 
   itk::HighPriorityRealTimeProbesCollector collector;
+  SetUpBenchmarkCollector(collector);
+
+  try
+  {
+    for (int i = 0; i < GetBenchmarkOptions().m_WarmUpIterations; ++i)
+    {
+      resample->Update();
+      resample->Modified();
+    }
+  }
+  catch (const itk::ExceptionObject & exceptionObject)
+  {
+    std::cerr << "Caught ITK exception during Resample filter Update() call: " << exceptionObject << std::endl;
+    return EXIT_FAILURE;
+  }
 
   for (int i = 0; i < _parameters.iterations; ++i)
   {
@@ -1044,6 +1031,13 @@ ProcessImage(const Parameters & _parameters)
     }
   }
 
+  // Each output voxel is interpolated from the input.
+  const itk::SizeValueType outputVoxels = typename OutputImageType::RegionType(outputSize).GetNumberOfPixels();
+  collector.SetWorkload("Resample",
+                        outputVoxels,
+                        GetImageMemoryRange(inputImage.GetPointer()).second +
+                          outputVoxels * sizeof(typename OutputImageType::PixelType));
+
   WriteExpandedReport(_parameters.timingsFileName, collector, true, true, false);
 
   // Write the input here, helps in case of the generated image see case (b)
@@ -1143,6 +1137,8 @@ AdjustTransformParameters(Parameters & parameters)
 // The command line option "-threads" controls default global number of threads used by any filter in ITK.
 // For example, when BSpline interpolator is used "-i" "BSpline", the BSplineDecompositionImageFilter
 // will be also executed with number of threads provided by option "-threads".
+// The shared options of the benchmarks are also accepted, see ParseBenchmarkOptions(): "--iterations",
+// "--threads" and "--size" overrule "-iterations", "-threads" and "-is".
 //
 // The following ITK interpolations are supported in this benchmark:
 // itk::NearestNeighborInterpolateImageFunction
@@ -1198,13 +1194,40 @@ AdjustTransformParameters(Parameters & parameters)
 // ResampleBenchmark -in "insight_journal\data\image-256x256x256-3D.mha" -i BSpline -t Affine BSpline
 //                   -out input.mha output.mha -tf tf.json
 //
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(ResampleBenchmark,
+                   itk::BenchmarkNoFixture,
+                   "-tf",
+                   "{timings}",
+                   "-is",
+                   "512",
+                   "512",
+                   "256",
+                   "-i",
+                   "Linear",
+                   "-t",
+                   "Affine",
+                   "-out",
+                   "{output}/ResampleBenchmark.mha",
+                   "-iterations",
+                   "1")
 {
+  // The shared options come first, the arguments of the benchmark are the remaining ones
+  BenchmarkOptions options;
+  options.m_Iterations = 0;
+  if (!ParseBenchmarkOptions(argc, argv, { "..." }, options))
+  {
+    return EXIT_FAILURE;
+  }
+  std::vector<const char *> remainingArgv{ argv[0] };
+  for (const auto & argument : options.m_RemainingArguments)
+  {
+    remainingArgv.push_back(argument.c_str());
+  }
+
   // Define the input arguments for the benchmark
   itksys::CommandLineArguments commandLineArguments;
   commandLineArguments.SetLineLength(160);
-  commandLineArguments.Initialize(argc, argv);
+  commandLineArguments.Initialize(static_cast<int>(remainingArgv.size()), remainingArgv.data());
 
   // Create parameters class to store the command line arguments
   Parameters parameters;
@@ -1269,6 +1292,20 @@ main(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
+  // The shared options, when given, overrule the arguments of the benchmark
+  if (options.m_Iterations > 0)
+  {
+    parameters.iterations = options.m_Iterations;
+  }
+  if (options.m_Threads > 0)
+  {
+    parameters.threads = options.m_Threads;
+  }
+  if (!options.m_Size.empty())
+  {
+    parameters.imageSizes.assign(options.m_Size.begin(), options.m_Size.end());
+  }
+
   // Replace the __DATESTAMP__ with real date and time
   parameters.timingsFileName = ReplaceOccurrence(parameters.timingsFileName, "__DATESTAMP__", PerfDateStamp());
 
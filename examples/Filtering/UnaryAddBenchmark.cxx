@@ -16,57 +16,57 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkAddImageFilter.h"
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 #include <fstream>
-#include <cstdlib>
 
 namespace
 {
 template <typename TImageType>
 itk::SmartPointer<TImageType>
-ReadImage(const char * fname)
+ReadImage(itk::BenchmarkImageFixture & fixture, const std::string & fname)
 {
-
-  using ReaderType = itk::ImageFileReader<TImageType>;
-  auto reader = ReaderType::New();
-  reader->SetFileName(fname);
-
   try
   {
-    reader->Update();
+    return fixture.ReadImage<TImageType>(fname);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
-    std::exit(EXIT_FAILURE);
+    return nullptr;
   }
-  return reader->GetOutput();
 }
 } // namespace
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(UnaryAddBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "50",
+                   "1",
+                   "{data}/brainweb165a10f17.mha",
+                   "{output}/UnaryAddBenchmark.mha")
 {
-  if (argc < 6)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc,
+                             argv,
+                             { "timingsFile", "iterations", "threads", "inputImage1File", "outputImageFile" },
+                             options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads input1ImageFile outputImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      inputImage1FileName = argv[4];
-  const char *      outputImageFileName = argv[5];
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & inputImage1FileName = options.m_Arguments["inputImage1File"];
+  const std::string & outputImageFileName = options.m_Arguments["outputImageFile"];
 
-  if (threads > 0)
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -74,7 +74,11 @@ main(int argc, char * argv[])
 
   using ImageType = itk::Image<PixelType, Dimension>;
 
-  ImageType::Pointer inputImage1 = ReadImage<ImageType>(inputImage1FileName);
+  ImageType::Pointer inputImage1 = ReadImage<ImageType>(fixture, inputImage1FileName);
+  if (inputImage1.IsNull())
+  {
+    return EXIT_FAILURE;
+  }
 
   using FilterType = itk::AddImageFilter<ImageType, ImageType, ImageType>;
   FilterType::Pointer filter = FilterType::New();
@@ -82,13 +86,14 @@ main(int argc, char * argv[])
   filter->SetInput2(10);
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    inputImage1->Modified();
-    collector.Start("Add");
-    filter->UpdateLargestPossibleRegion();
-    collector.Stop("Add");
-  }
+  TimeIterations(
+    collector,
+    "Add",
+    iterations,
+    [&]() { inputImage1->Modified(); },
+    [&]() { filter->UpdateLargestPossibleRegion(); },
+    { GetImageMemoryRange(inputImage1.GetPointer()) },
+    GetImageFilterWorkload<ImageType>(inputImage1.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
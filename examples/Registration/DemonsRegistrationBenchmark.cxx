@@ -16,7 +16,6 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkTransformFileWriter.h"
 #include "itkDemonsRegistrationFilter.h"
@@ -24,9 +23,13 @@
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 #include <fstream>
 
+namespace
+{
 class CommandIterationUpdate : public itk::Command
 {
 public:
@@ -62,28 +65,36 @@ public:
     std::cout << filter->GetMetric() << std::endl;
   }
 };
+} // namespace
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(DemonsRegistrationBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17.mha",
+                   "{data}/brainweb165a10f17translated-1x-1y1z.nrrd",
+                   "{output}/DemonsRegistrationBenchmark.mha")
 {
-  if (argc < 7)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(
+        argc,
+        argv,
+        { "timingsFile", "iterations", "threads", "fixedImageFile", "movingImageFile", "outputFile" },
+        options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile threads fixedImageFile movingImageFile outputDisplacementFieldFileName"
-              << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      fixedImageFileName = argv[4];
-  const char *      movingImageFileName = argv[5];
-  const char *      outputFileName = argv[6];
-
-  if (threads > 0)
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & fixedImageFileName = options.m_Arguments["fixedImageFile"];
+  const std::string & movingImageFileName = options.m_Arguments["movingImageFile"];
+  const std::string & outputFileName = options.m_Arguments["outputFile"];
+
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -91,33 +102,27 @@ main(int argc, char * argv[])
 
   using ImageType = itk::Image<PixelType, Dimension>;
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(fixedImageFileName);
+  ImageType::Pointer fixedImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    fixedImage = fixture.ReadImage<ImageType>(fixedImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer fixedImage = reader->GetOutput();
-  fixedImage->DisconnectPipeline();
 
-  reader->SetFileName(movingImageFileName);
+  ImageType::Pointer movingImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    movingImage = fixture.ReadImage<ImageType>(movingImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer movingImage = reader->GetOutput();
-  movingImage->DisconnectPipeline();
 
 
   using VectorPixelType = itk::Vector<float, Dimension>;
@@ -137,14 +142,17 @@ main(int argc, char * argv[])
   filter->SmoothDisplacementFieldOn();
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    fixedImage->Modified();
-    movingImage->Modified();
-    collector.Start("DemonsRegistration");
-    filter->UpdateLargestPossibleRegion();
-    collector.Stop("DemonsRegistration");
-  }
+  TimeIterations(
+    collector,
+    "DemonsRegistration",
+    iterations,
+    [&]() {
+      fixedImage->Modified();
+      movingImage->Modified();
+    },
+    [&]() { filter->UpdateLargestPossibleRegion(); },
+    { GetImageMemoryRange(fixedImage.GetPointer()), GetImageMemoryRange(movingImage.GetPointer()) },
+    GetImageFilterWorkload<DisplacementFieldType>(fixedImage.GetPointer(), movingImage.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
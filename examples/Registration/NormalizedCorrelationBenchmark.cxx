@@ -16,32 +16,39 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkFFTNormalizedCorrelationImageFilter.h"
 #include "itkFFTPadImageFilter.h"
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(NormalizedCorrelationBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17extract88i5z.mha",
+                   "{data}/brainweb165a10f17translated-1x-1y1zextract88i5z.mha")
 {
-  if (argc < 6)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc,
+                             argv,
+                             { "timingsFile", "iterations", "threads", "fixedImageFile", "movingImageFile" },
+                             options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads fixedImageFile movingImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const std::string fixedImageFileName = argv[4];
-  const std::string movingImageFileName = argv[5];
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & fixedImageFileName = options.m_Arguments["fixedImageFile"];
+  const std::string & movingImageFileName = options.m_Arguments["movingImageFile"];
 
-  if (threads > 0)
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -49,33 +56,27 @@ main(int argc, char * argv[])
 
   using ImageType = itk::Image<PixelType, Dimension>;
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(fixedImageFileName);
+  ImageType::Pointer fixedImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    fixedImage = fixture.ReadImage<ImageType>(fixedImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer fixedImage = reader->GetOutput();
-  fixedImage->DisconnectPipeline();
 
-  reader->SetFileName(movingImageFileName);
+  ImageType::Pointer movingImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    movingImage = fixture.ReadImage<ImageType>(movingImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer movingImage = reader->GetOutput();
-  movingImage->DisconnectPipeline();
 
 
   using CorrelationFilterType = itk::FFTNormalizedCorrelationImageFilter<ImageType, ImageType>;
@@ -93,15 +94,20 @@ main(int argc, char * argv[])
   maximumCalculator->SetImage(padFilter->GetOutput());
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    fixedImage->Modified();
-    movingImage->Modified();
-    collector.Start("NormalizedCorrelation");
-    padFilter->UpdateLargestPossibleRegion();
-    maximumCalculator->ComputeMaximum();
-    collector.Stop("NormalizedCorrelation");
-  }
+  TimeIterations(
+    collector,
+    "NormalizedCorrelation",
+    iterations,
+    [&]() {
+      fixedImage->Modified();
+      movingImage->Modified();
+    },
+    [&]() {
+      padFilter->UpdateLargestPossibleRegion();
+      maximumCalculator->ComputeMaximum();
+    },
+    { GetImageMemoryRange(fixedImage.GetPointer()), GetImageMemoryRange(movingImage.GetPointer()) },
+    GetImageFilterWorkload<ImageType>(fixedImage.GetPointer(), movingImage.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
@@ -16,7 +16,6 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkTransformFileWriter.h"
 #include "itkImageRegistrationMethodv4.h"
 #include "itkMeanSquaresImageToImageMetricv4.h"
@@ -24,8 +23,12 @@
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 
+namespace
+{
 class CommandIterationUpdate : public itk::Command
 {
 public:
@@ -62,28 +65,36 @@ public:
     std::cout << optimizer->GetCurrentPosition() << std::endl;
   }
 };
+} // namespace
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(RegistrationFrameworkBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17.mha",
+                   "{data}/brainweb165a10f17translated-7x-8y9z.nrrd",
+                   "{output}/RegistrationFrameworkBenchmark.hdf5")
 {
-  if (argc < 7)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(
+        argc,
+        argv,
+        { "timingsFile", "iterations", "threads", "fixedImageFile", "movingImageFile", "outputTransformFile" },
+        options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads fixedImageFile movingImageFile outputTransformFileName"
-              << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      fixedImageFileName = argv[4];
-  const char *      movingImageFileName = argv[5];
-  const char *      outputTransformFileName = argv[6];
-
-  if (threads > 0)
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & fixedImageFileName = options.m_Arguments["fixedImageFile"];
+  const std::string & movingImageFileName = options.m_Arguments["movingImageFile"];
+  const std::string & outputTransformFileName = options.m_Arguments["outputTransformFile"];
+
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -92,33 +103,27 @@ main(int argc, char * argv[])
 
   using ImageType = itk::Image<PixelType, 3>;
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(fixedImageFileName);
+  ImageType::Pointer fixedImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    fixedImage = fixture.ReadImage<ImageType>(fixedImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer fixedImage = reader->GetOutput();
-  fixedImage->DisconnectPipeline();
 
-  reader->SetFileName(movingImageFileName);
+  ImageType::Pointer movingImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    movingImage = fixture.ReadImage<ImageType>(movingImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer movingImage = reader->GetOutput();
-  movingImage->DisconnectPipeline();
 
 
   using OptimizerType = itk::RegularStepGradientDescentOptimizerv4<ParametersValueType>;
@@ -183,6 +188,13 @@ main(int argc, char * argv[])
   optimizer->SetDoEstimateLearningRateOnce(true);
 
   itk::HighPriorityRealTimeProbesCollector collector;
+  SetUpBenchmarkCollector(collector);
+  for (int ii = 0; ii < GetBenchmarkOptions().m_WarmUpIterations; ++ii)
+  {
+    optimizedTransform->SetParameters(initialParameters);
+    registration->SetInitialTransform(optimizedTransform);
+    registration->Update();
+  }
   for (int ii = 0; ii < iterations; ++ii)
   {
     collector.Start("RegistrationFramework");
@@ -191,6 +203,12 @@ main(int argc, char * argv[])
     registration->Update();
     collector.Stop("RegistrationFramework");
   }
+  // The images are read, the output is a transform.
+  BenchmarkWorkload workload;
+  workload.m_Voxels = fixedImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  workload.m_Bytes =
+    GetImageMemoryRange(fixedImage.GetPointer()).second + GetImageMemoryRange(movingImage.GetPointer()).second;
+  collector.SetWorkload("RegistrationFramework", workload.m_Voxels, workload.m_Bytes);
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
   TransformType::ConstPointer transform = registration->GetTransform();
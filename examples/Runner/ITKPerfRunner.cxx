@@ -0,0 +1,482 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Runs the benchmarks linked into it, one after the other in the same
+// process, so that ITK starts and registers its ImageIO factories once, and
+// the benchmarks share their fixtures, e.g. the images they read. With
+// --scaling, each benchmark runs with 1, 2, 4 ... N threads instead, and the
+// speedups of its probes are written to a JSON file. With --sizes, each
+// benchmark runs at each size instead, and the throughput of its probes is
+// written to a JSON file.
+
+#include "itkBenchmarkRegistry.h"
+#include "itkBenchmarkThreadScaling.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef ITK_PERF_RUNNER_DATA_DIRECTORY
+#  define ITK_PERF_RUNNER_DATA_DIRECTORY "."
+#endif
+#ifndef ITK_PERF_RUNNER_OUTPUT_DIRECTORY
+#  define ITK_PERF_RUNNER_OUTPUT_DIRECTORY "."
+#endif
+#ifndef ITK_PERF_RUNNER_RESULTS_DIRECTORY
+#  define ITK_PERF_RUNNER_RESULTS_DIRECTORY "."
+#endif
+
+namespace
+{
+using PlaceholdersType = std::map<std::string, std::string>;
+
+// Replaces each {placeholder} of an argument with its value.
+std::string
+ExpandPlaceholders(std::string argument, const PlaceholdersType & placeholders)
+{
+  for (const auto & placeholder : placeholders)
+  {
+    const std::string pattern = "{" + placeholder.first + "}";
+    for (size_t position = argument.find(pattern); position != std::string::npos;
+         position = argument.find(pattern, position + placeholder.second.size()))
+    {
+      argument.replace(position, pattern.size(), placeholder.second);
+    }
+  }
+  return argument;
+}
+
+// Whether argument is --name=value, and then its value.
+bool
+GetOptionValue(const std::string & argument, const std::string & name, std::string & value)
+{
+  const std::string prefix = "--" + name + "=";
+  if (argument.compare(0, prefix.size(), prefix) != 0)
+  {
+    return false;
+  }
+  value = argument.substr(prefix.size());
+  return true;
+}
+
+// The numbers of threads of a scaling sweep: the powers of 2 below
+// maximumThreads, and maximumThreads.
+std::vector<unsigned int>
+GetScalingThreads(unsigned int maximumThreads)
+{
+  std::vector<unsigned int> threads;
+  for (unsigned int power = 1; power < maximumThreads; power *= 2)
+  {
+    threads.push_back(power);
+  }
+  threads.push_back(std::max(maximumThreads, 1u));
+  return threads;
+}
+
+using ProbeScalingType = std::map<std::string, itk::BenchmarkThreadScaling>;
+
+// Adds the median of each probe of the last report to the scaling of the
+// probe.
+void
+AddReportToScaling(unsigned int threads, ProbeScalingType & scaling)
+{
+  jsonxx::Object report;
+  report.parse(GetLastBenchmarkReport());
+  if (!report.has<jsonxx::Array>("Probes"))
+  {
+    return;
+  }
+  const jsonxx::Array & probes = report.get<jsonxx::Array>("Probes");
+  for (size_t ii = 0; ii < probes.size(); ++ii)
+  {
+    const jsonxx::Object & probe = probes.get<jsonxx::Object>(ii);
+    if (probe.has<jsonxx::String>("Name") && probe.has<jsonxx::Number>("Median"))
+    {
+      scaling[probe.get<jsonxx::String>("Name")].AddMeasurement(threads, probe.get<jsonxx::Number>("Median"));
+    }
+  }
+}
+
+void
+PrintScaling(const std::string & benchmarkName, const ProbeScalingType & scaling)
+{
+  for (const auto & probe : scaling)
+  {
+    std::cout << benchmarkName << " " << probe.first << ": speedup" << std::fixed << std::setprecision(2);
+    for (const unsigned int threads : probe.second.GetThreads())
+    {
+      std::cout << " " << probe.second.GetSpeedup(threads) << " (" << threads << ")";
+    }
+    std::cout << ", Amdahl serial fraction " << std::setprecision(3) << probe.second.GetAmdahlSerialFraction()
+              << std::defaultfloat << std::endl;
+  }
+}
+
+// The sizes of a size sweep, e.g. 64,128,256 or 64x64x32,128x128x64.
+std::vector<std::string>
+GetSweepSizes(const std::string & sizes)
+{
+  std::vector<std::string> sweepSizes;
+  std::istringstream       stream(sizes);
+  std::string              size;
+  while (std::getline(stream, size, ','))
+  {
+    if (!size.empty())
+    {
+      sweepSizes.push_back(size);
+    }
+  }
+  return sweepSizes;
+}
+
+// The median and the throughput of a probe at each size, in the order of the sweep.
+using ProbeSizeScalingType = std::map<std::string, std::vector<std::pair<std::string, jsonxx::Object>>>;
+
+// Adds the median and the workload of each probe of the last report to the
+// size scaling of the probe.
+void
+AddReportToSizeScaling(const std::string & size, ProbeSizeScalingType & sizeScaling)
+{
+  jsonxx::Object report;
+  report.parse(GetLastBenchmarkReport());
+  if (!report.has<jsonxx::Array>("Probes"))
+  {
+    return;
+  }
+  const jsonxx::Array & probes = report.get<jsonxx::Array>("Probes");
+  for (size_t ii = 0; ii < probes.size(); ++ii)
+  {
+    const jsonxx::Object & probe = probes.get<jsonxx::Object>(ii);
+    if (!probe.has<jsonxx::String>("Name") || !probe.has<jsonxx::Number>("Median"))
+    {
+      continue;
+    }
+    jsonxx::Object measurement;
+    measurement << "Median" << probe.get<jsonxx::Number>("Median");
+    for (const std::string key : { "WorkloadVoxels", "WorkloadBytes", "VoxelsPerSecond", "BytesPerSecond" })
+    {
+      if (probe.has<jsonxx::Number>(key))
+      {
+        measurement << key << probe.get<jsonxx::Number>(key);
+      }
+    }
+    if (probe.has<jsonxx::String>("CacheRegime"))
+    {
+      measurement << "CacheRegime" << probe.get<jsonxx::String>("CacheRegime");
+    }
+    sizeScaling[probe.get<jsonxx::String>("Name")].emplace_back(size, measurement);
+  }
+}
+
+void
+PrintSizeScaling(const std::string & benchmarkName, const ProbeSizeScalingType & sizeScaling)
+{
+  for (const auto & probe : sizeScaling)
+  {
+    std::cout << benchmarkName << " " << probe.first << ":" << std::setprecision(3);
+    for (const auto & measurement : probe.second)
+    {
+      std::cout << " " << measurement.first << " ";
+      if (measurement.second.has<jsonxx::Number>("VoxelsPerSecond"))
+      {
+        std::cout << measurement.second.get<jsonxx::Number>("VoxelsPerSecond") << " voxels/s ("
+                  << measurement.second.get<jsonxx::Number>("BytesPerSecond") << " bytes/s, "
+                  << measurement.second.get<jsonxx::String>("CacheRegime") << ")";
+      }
+      else
+      {
+        std::cout << measurement.second.get<jsonxx::Number>("Median") << " s";
+      }
+    }
+    std::cout << std::defaultfloat << std::endl;
+  }
+}
+
+void
+PrintUsage(const char * program)
+{
+  std::cerr << "Usage: " << std::endl;
+  std::cerr << program << " [--list] [--filter=regex] [--data=dir] [--output=dir] [--results=dir] [--scaling[=N]]"
+            << " [--sizes=n,n...] [-- arguments...]" << std::endl;
+  std::cerr << "  --list     print the benchmarks, and their default arguments, instead of running them" << std::endl;
+  std::cerr << "  --filter   only the benchmarks whose name matches the regular expression" << std::endl;
+  std::cerr << "  --data     directory of the input images, {data} in the arguments" << std::endl;
+  std::cerr << "  --output   directory of the output images, {output} in the arguments" << std::endl;
+  std::cerr << "  --results  directory of the JSON timings, {timings} in the arguments" << std::endl;
+  std::cerr << "  --scaling  run each benchmark with 1, 2, 4 ... N threads, the default number by default, and write"
+            << " the speedups to the results directory" << std::endl;
+  std::cerr << "  --sizes    run each benchmark with each size of its inputs, e.g. 64,128 or 64x64x32,128x128x64, and"
+            << " write the throughputs to the results directory" << std::endl;
+  std::cerr << "  -- arguments replace the default arguments of each benchmark" << std::endl;
+}
+} // namespace
+
+int
+main(int argc, char * argv[])
+{
+  bool                                  list = false;
+  std::string                           filter;
+  std::string                           results = ITK_PERF_RUNNER_RESULTS_DIRECTORY;
+  PlaceholdersType                      placeholders{ { "data", ITK_PERF_RUNNER_DATA_DIRECTORY },
+                                                      { "output", ITK_PERF_RUNNER_OUTPUT_DIRECTORY } };
+  bool                                  replaceArguments = false;
+  itk::BenchmarkRegistry::ArgumentsType arguments;
+  std::vector<unsigned int>             scalingThreads;
+  std::vector<std::string>              sweepSizes;
+  for (int ii = 1; ii < argc; ++ii)
+  {
+    const std::string argument = argv[ii];
+    std::string       value;
+    if (replaceArguments)
+    {
+      arguments.push_back(argument);
+    }
+    else if (argument == "--")
+    {
+      replaceArguments = true;
+    }
+    else if (argument == "--list")
+    {
+      list = true;
+    }
+    else if (GetOptionValue(argument, "filter", value))
+    {
+      filter = value;
+    }
+    else if (GetOptionValue(argument, "results", value))
+    {
+      results = value;
+    }
+    else if (GetOptionValue(argument, "data", value))
+    {
+      placeholders["data"] = value;
+    }
+    else if (GetOptionValue(argument, "output", value))
+    {
+      placeholders["output"] = value;
+    }
+    else if (argument == "--scaling")
+    {
+      scalingThreads = GetScalingThreads(MultiThreaderName::GetGlobalDefaultNumberOfThreads());
+    }
+    else if (GetOptionValue(argument, "scaling", value) && std::atoi(value.c_str()) > 0)
+    {
+      scalingThreads = GetScalingThreads(static_cast<unsigned int>(std::atoi(value.c_str())));
+    }
+    else if (GetOptionValue(argument, "sizes", value) && !GetSweepSizes(value).empty())
+    {
+      sweepSizes = GetSweepSizes(value);
+    }
+    else
+    {
+      PrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (!scalingThreads.empty() && !sweepSizes.empty())
+  {
+    std::cerr << "--scaling and --sizes can not be combined" << std::endl;
+    PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  const itk::BenchmarkRegistry & registry = itk::BenchmarkRegistry::GetInstance();
+  std::vector<const itk::BenchmarkRegistry::BenchmarkEntry *> benchmarks;
+  try
+  {
+    benchmarks = registry.Select(filter);
+  }
+  catch (const std::regex_error & error)
+  {
+    std::cerr << "Invalid filter " << filter << ": " << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (benchmarks.empty())
+  {
+    std::cerr << "No benchmark matches " << filter << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A sweep runs each benchmark once per value of an environment variable,
+  // which overrides the arguments, see SetUpBenchmarkEnvironment() and
+  // ParseBenchmarkOptions(). Without a sweep, the arguments decide.
+  std::string              sweepVariable;
+  std::vector<std::string> sweepValues{ "" };
+  if (!scalingThreads.empty())
+  {
+    sweepVariable = "ITKPERFORMANCEBENCHMARK_THREADS";
+    sweepValues.clear();
+    for (const unsigned int threads : scalingThreads)
+    {
+      sweepValues.push_back(std::to_string(threads));
+    }
+  }
+  else if (!sweepSizes.empty())
+  {
+    sweepVariable = "ITKPERFORMANCEBENCHMARK_SIZE";
+    sweepValues = sweepSizes;
+  }
+
+  std::ostringstream scalingJson;
+  jsonxx::Object     sizeScalingJson;
+  int                failures = 0;
+  for (const auto * benchmark : benchmarks)
+  {
+    ProbeScalingType     scaling;
+    ProbeSizeScalingType sizeScaling;
+    for (const std::string & sweepValue : sweepValues)
+    {
+      std::string suffix;
+      if (!scalingThreads.empty())
+      {
+        suffix = "-" + sweepValue + "Threads";
+      }
+      else if (!sweepSizes.empty())
+      {
+        suffix = "-Size" + sweepValue;
+      }
+      placeholders["timings"] = results + "/__DATESTAMP__" + benchmark->Name + suffix + ".json";
+      itk::BenchmarkRegistry::ArgumentsType benchmarkArguments;
+      for (const auto & argument : replaceArguments ? arguments : benchmark->DefaultArguments)
+      {
+        benchmarkArguments.push_back(ExpandPlaceholders(argument, placeholders));
+      }
+
+      if (list)
+      {
+        std::cout << benchmark->Name;
+        for (const auto & argument : benchmarkArguments)
+        {
+          std::cout << " " << argument;
+        }
+        std::cout << std::endl;
+        break;
+      }
+
+      std::cout << "Running " << benchmark->Name;
+      if (!scalingThreads.empty())
+      {
+        std::cout << " with " << sweepValue << " threads";
+      }
+      else if (!sweepSizes.empty())
+      {
+        std::cout << " at size " << sweepValue;
+      }
+      if (!sweepVariable.empty())
+      {
+        itksys::SystemTools::PutEnv(sweepVariable + "=" + sweepValue);
+      }
+      std::cout << "..." << std::endl;
+      const int result = registry.Run(*benchmark, benchmarkArguments);
+      if (!sweepVariable.empty())
+      {
+        itksys::SystemTools::UnPutEnv(sweepVariable);
+      }
+      if (result != EXIT_SUCCESS)
+      {
+        std::cerr << benchmark->Name << " failed" << std::endl;
+        ++failures;
+        break;
+      }
+      if (!scalingThreads.empty())
+      {
+        AddReportToScaling(static_cast<unsigned int>(std::stoul(sweepValue)), scaling);
+      }
+      else if (!sweepSizes.empty())
+      {
+        AddReportToSizeScaling(sweepValue, sizeScaling);
+      }
+    }
+
+    if (!scaling.empty())
+    {
+      PrintScaling(benchmark->Name, scaling);
+      scalingJson << (scalingJson.tellp() > 0 ? ",\n" : "\n") << "  \"" << benchmark->Name << "\": {";
+      for (auto probe = scaling.begin(); probe != scaling.end(); ++probe)
+      {
+        scalingJson << (probe == scaling.begin() ? "\n" : ",\n") << "    \"" << probe->first << "\": ";
+        probe->second.PrintJSON(scalingJson);
+      }
+      scalingJson << "\n  }";
+    }
+    if (!sizeScaling.empty())
+    {
+      PrintSizeScaling(benchmark->Name, sizeScaling);
+      jsonxx::Object benchmarkJson;
+      for (const auto & probe : sizeScaling)
+      {
+        jsonxx::Object probeJson;
+        for (const auto & measurement : probe.second)
+        {
+          probeJson << measurement.first << measurement.second;
+        }
+        benchmarkJson << probe.first << probeJson;
+      }
+      sizeScalingJson << benchmark->Name << benchmarkJson;
+    }
+  }
+  if (!list && !scalingThreads.empty())
+  {
+    std::ostringstream scalingReport;
+    scalingReport << "{\n  \"Statistic\": \"Median\",\n  \"Threads\": [";
+    for (size_t ii = 0; ii < scalingThreads.size(); ++ii)
+    {
+      scalingReport << (ii > 0 ? ", " : "") << scalingThreads[ii];
+    }
+    scalingReport << "],\n  \"ThreadScaling\": {" << scalingJson.str() << "\n  }\n}";
+    const std::string scalingFileName =
+      ReplaceOccurrence(results + "/__DATESTAMP__ThreadScaling.json", "__DATESTAMP__", PerfDateStamp());
+    std::ofstream scalingFile(scalingFileName);
+    scalingFile << DecorateWithBuildInformation(scalingReport.str());
+    std::cout << "The thread scaling is written to " << scalingFileName << std::endl;
+  }
+  if (!list && !sweepSizes.empty())
+  {
+    jsonxx::Array sizes;
+    for (const auto & size : sweepSizes)
+    {
+      sizes << size;
+    }
+    jsonxx::Object sizeScalingReport;
+    sizeScalingReport << "Statistic" << jsonxx::String("Median");
+    sizeScalingReport << "Sizes" << sizes;
+    sizeScalingReport << "SizeScaling" << sizeScalingJson;
+    const std::string sizeScalingFileName =
+      ReplaceOccurrence(results + "/__DATESTAMP__SizeScaling.json", "__DATESTAMP__", PerfDateStamp());
+    std::ofstream sizeScalingFile(sizeScalingFileName);
+    sizeScalingFile << DecorateWithBuildInformation(sizeScalingReport.json());
+    std::cout << "The size scaling is written to " << sizeScalingFileName << std::endl;
+  }
+  if (failures > 0)
+  {
+    std::cerr << failures << " of " << benchmarks.size() << " benchmarks failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -16,7 +16,6 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkCurvatureAnisotropicDiffusionImageFilter.h"
 #include "itkGradientMagnitudeRecursiveGaussianImageFilter.h"
@@ -27,28 +26,36 @@
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 #include <fstream>
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(LevelSetBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17extract60i50z.mha",
+                   "{output}/LevelSetBenchmark.mha")
 {
-  if (argc < 6)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc,
+                             argv,
+                             { "timingsFile", "iterations", "threads", "inputImageFile", "outputImageFile" },
+                             options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads inputImageFile outputImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      inputImageFileName = argv[4];
-  const char *      outputImageFileName = argv[5];
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & inputImageFileName = options.m_Arguments["inputImageFile"];
+  const std::string & outputImageFileName = options.m_Arguments["outputImageFile"];
 
-  if (threads > 0)
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -56,20 +63,16 @@ main(int argc, char * argv[])
 
   using ImageType = itk::Image<PixelType, 3>;
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(inputImageFileName);
+  ImageType::Pointer inputImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    inputImage = fixture.ReadImage<ImageType>(inputImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer inputImage = reader->GetOutput();
-  inputImage->DisconnectPipeline();
 
   using SmoothingFilterType = itk::CurvatureAnisotropicDiffusionImageFilter<ImageType, ImageType>;
   SmoothingFilterType::Pointer smoothingFilter = SmoothingFilterType::New();
@@ -99,7 +102,7 @@ main(int argc, char * argv[])
   seedPosition[0] = 77;
   seedPosition[1] = 112;
   seedPosition[2] = 35;
-  node.SetIndex(seedPosition);
+  node.SetIndex(fixture.MapIndex<ImageType>(inputImageFileName, seedPosition));
   node.SetValue(-5.);
   using NodeContainerType = FastMarchingFilterType::NodeContainer;
   NodeContainerType::Pointer seeds = NodeContainerType::New();
@@ -108,13 +111,15 @@ main(int argc, char * argv[])
   seedPosition[0] = 111;
   seedPosition[1] = 93;
   seedPosition[2] = 35;
-  node.SetIndex(seedPosition);
+  node.SetIndex(fixture.MapIndex<ImageType>(inputImageFileName, seedPosition));
   node.SetValue(-5.);
   seeds->InsertElement(1, node);
   fastMarchingFilter->SetTrialPoints(seeds);
   fastMarchingFilter->SetSpeedConstant(1.0);
   fastMarchingFilter->SetOutputSize(inputImage->GetLargestPossibleRegion().GetSize());
   fastMarchingFilter->SetOutputOrigin(inputImage->GetOrigin());
+  fastMarchingFilter->SetOutputSpacing(inputImage->GetSpacing());
+  fastMarchingFilter->SetOutputDirection(inputImage->GetDirection());
 
   using ShapeDetectionFilterType = itk::ShapeDetectionLevelSetImageFilter<ImageType, ImageType>;
   ShapeDetectionFilterType::Pointer shapeDetectionFilter = ShapeDetectionFilterType::New();
@@ -136,14 +141,36 @@ main(int argc, char * argv[])
   thresholdingFilter->SetOutsideValue(0);
   thresholdingFilter->SetInsideValue(itk::NumericTraits<LabelPixelType>::max());
 
-  itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
+  using CollectorType = itk::HighPriorityRealTimeProbesCollector;
+  CollectorType collector;
+  SetUpBenchmarkCollector(collector);
+  for (int ii = 0; ii < GetBenchmarkOptions().m_WarmUpIterations; ++ii)
   {
     inputImage->Modified();
-    collector.Start("LevelSet");
     thresholdingFilter->UpdateLargestPossibleRegion();
-    collector.Stop("LevelSet");
   }
+  for (int ii = 0; ii < iterations; ++ii)
+  {
+    inputImage->Modified();
+    CollectorType::ScopedProbe levelSet(collector, "LevelSet");
+    {
+      CollectorType::ScopedProbe featureImage(collector, "FeatureImage");
+      sigmoidFilter->UpdateLargestPossibleRegion();
+    }
+    {
+      // The initial level set does not depend on the input image, it is only
+      // computed in the first iteration.
+      CollectorType::ScopedProbe fastMarching(collector, "FastMarching");
+      fastMarchingFilter->UpdateLargestPossibleRegion();
+    }
+    {
+      CollectorType::ScopedProbe shapeDetection(collector, "ShapeDetection");
+      thresholdingFilter->UpdateLargestPossibleRegion();
+    }
+  }
+
+  const BenchmarkWorkload workload = GetImageFilterWorkload<LabelImageType>(inputImage.GetPointer());
+  collector.SetWorkload("LevelSet", workload.m_Voxels, workload.m_Bytes);
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
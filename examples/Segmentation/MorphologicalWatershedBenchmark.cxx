@@ -16,7 +16,6 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkCurvatureFlowImageFilter.h"
 #include "itkMorphologicalWatershedImageFilter.h"
@@ -25,23 +24,33 @@
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 #include <fstream>
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(MorphologicalWatershedBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "{data}/brainweb165a10f17extract45i90z.mha",
+                   "{output}/MorphologicalWatershedBenchmark.mha")
 {
-  if (argc < 5)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc, argv, { "timingsFile", "iterations", "inputImageFile", "outputImageFile" }, options))
+  {
+    return EXIT_FAILURE;
+  }
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & inputImageFileName = options.m_Arguments["inputImageFile"];
+  const std::string & outputImageFileName = options.m_Arguments["outputImageFile"];
+
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations inputImageFile outputImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  const char *      inputImageFileName = argv[3];
-  const char *      outputImageFileName = argv[4];
 
   constexpr unsigned int Dimension = 3;
   using PixelType = float;
@@ -49,20 +58,16 @@ main(int argc, char * argv[])
   using ImageType = itk::Image<PixelType, Dimension>;
   using LabelImageType = itk::Image<unsigned long long, Dimension>;
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(inputImageFileName);
+  ImageType::Pointer inputImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    inputImage = fixture.ReadImage<ImageType>(inputImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer inputImage = reader->GetOutput();
-  inputImage->DisconnectPipeline();
 
   using GradientMagnitudeFilterType = itk::GradientMagnitudeRecursiveGaussianImageFilter<ImageType, ImageType>;
   GradientMagnitudeFilterType::Pointer gradientMagnitudeFilter = GradientMagnitudeFilterType::New();
@@ -77,13 +82,14 @@ main(int argc, char * argv[])
   watershedFilter->MarkWatershedLineOff();
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    inputImage->Modified();
-    collector.Start("Watershed");
-    watershedFilter->UpdateLargestPossibleRegion();
-    collector.Stop("Watershed");
-  }
+  TimeIterations(
+    collector,
+    "Watershed",
+    iterations,
+    [&]() { inputImage->Modified(); },
+    [&]() { watershedFilter->UpdateLargestPossibleRegion(); },
+    { GetImageMemoryRange(inputImage.GetPointer()) },
+    GetImageFilterWorkload<LabelImageType>(inputImage.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
@@ -16,7 +16,6 @@
  *
  *=========================================================================*/
 
-#include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
 #include "itkConfidenceConnectedImageFilter.h"
 #include "itkCurvatureFlowImageFilter.h"
@@ -24,28 +23,36 @@
 
 #include "itkHighPriorityRealTimeProbesCollector.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkImageFixture.h"
+#include "itkBenchmarkRegistry.h"
 
 #include <fstream>
 
 
-int
-main(int argc, char * argv[])
+ITK_PERF_BENCHMARK(RegionGrowingBenchmark,
+                   itk::BenchmarkImageFixture,
+                   "{timings}",
+                   "3",
+                   "-1",
+                   "{data}/brainweb165a10f17.mha",
+                   "{output}/RegionGrowingBenchmark.mha")
 {
-  if (argc < 6)
+  BenchmarkOptions options;
+  if (!ParseBenchmarkOptions(argc,
+                             argv,
+                             { "timingsFile", "iterations", "threads", "inputImageFile", "outputImageFile" },
+                             options))
   {
-    std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " timingsFile iterations threads inputImageFile outputImageFile" << std::endl;
     return EXIT_FAILURE;
   }
-  const std::string timingsFileName = ReplaceOccurrence(argv[1], "__DATESTAMP__", PerfDateStamp());
-  const int         iterations = std::stoi(argv[2]);
-  int               threads = std::stoi(argv[3]);
-  const char *      inputImageFileName = argv[4];
-  const char *      outputImageFileName = argv[5];
+  const std::string & timingsFileName = options.m_TimingsFileName;
+  const int           iterations = options.m_Iterations;
+  const std::string & inputImageFileName = options.m_Arguments["inputImageFile"];
+  const std::string & outputImageFileName = options.m_Arguments["outputImageFile"];
 
-  if (threads > 0)
+  if (!SetUpBenchmarkEnvironment(options.m_Threads))
   {
-    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+    return EXIT_FAILURE;
   }
 
   constexpr unsigned int Dimension = 3;
@@ -55,20 +62,16 @@ main(int argc, char * argv[])
   using LabelImageType = itk::Image<LabelPixelType, Dimension>;
 
 
-  using ReaderType = itk::ImageFileReader<ImageType>;
-  ReaderType::Pointer reader = ReaderType::New();
-  reader->SetFileName(inputImageFileName);
+  ImageType::Pointer inputImage;
   try
   {
-    reader->UpdateLargestPossibleRegion();
+    inputImage = fixture.ReadImage<ImageType>(inputImageFileName);
   }
   catch (itk::ExceptionObject & error)
   {
     std::cerr << "Error: " << error << std::endl;
     return EXIT_FAILURE;
   }
-  ImageType::Pointer inputImage = reader->GetOutput();
-  inputImage->DisconnectPipeline();
 
   using SmoothingFilterType = itk::CurvatureFlowImageFilter<ImageType, ImageType>;
   SmoothingFilterType::Pointer smoothingFilter = SmoothingFilterType::New();
@@ -88,31 +91,31 @@ main(int argc, char * argv[])
   index1[0] = 118;
   index1[1] = 133;
   index1[2] = 92;
-  confidenceConnectedFilter->AddSeed(index1);
+  confidenceConnectedFilter->AddSeed(fixture.MapIndex<ImageType>(inputImageFileName, index1));
 
   ImageType::IndexType index2;
   index2[0] = 63;
   index2[1] = 135;
   index2[2] = 94;
-  confidenceConnectedFilter->AddSeed(index2);
+  confidenceConnectedFilter->AddSeed(fixture.MapIndex<ImageType>(inputImageFileName, index2));
 
   ImageType::IndexType index3;
   index3[0] = 63;
   index3[1] = 157;
   index3[2] = 90;
-  confidenceConnectedFilter->AddSeed(index3);
+  confidenceConnectedFilter->AddSeed(fixture.MapIndex<ImageType>(inputImageFileName, index3));
 
   ImageType::IndexType index4;
   index4[0] = 111;
   index4[1] = 150;
   index4[2] = 90;
-  confidenceConnectedFilter->AddSeed(index4);
+  confidenceConnectedFilter->AddSeed(fixture.MapIndex<ImageType>(inputImageFileName, index4));
 
   ImageType::IndexType index5;
   index5[0] = 111;
   index5[1] = 50;
   index5[2] = 88;
-  confidenceConnectedFilter->AddSeed(index5);
+  confidenceConnectedFilter->AddSeed(fixture.MapIndex<ImageType>(inputImageFileName, index5));
 
   using FillholeFilterType = itk::BinaryFillholeImageFilter<LabelImageType>;
   FillholeFilterType::Pointer fillholeFilter = FillholeFilterType::New();
@@ -120,13 +123,14 @@ main(int argc, char * argv[])
   fillholeFilter->SetForegroundValue(confidenceConnectedFilter->GetReplaceValue());
 
   itk::HighPriorityRealTimeProbesCollector collector;
-  for (int ii = 0; ii < iterations; ++ii)
-  {
-    inputImage->Modified();
-    collector.Start("RegionGrowing");
-    fillholeFilter->UpdateLargestPossibleRegion();
-    collector.Stop("RegionGrowing");
-  }
+  TimeIterations(
+    collector,
+    "RegionGrowing",
+    iterations,
+    [&]() { inputImage->Modified(); },
+    [&]() { fillholeFilter->UpdateLargestPossibleRegion(); },
+    { GetImageMemoryRange(inputImage.GetPointer()) },
+    GetImageFilterWorkload<LabelImageType>(inputImage.GetPointer()));
 
   WriteExpandedReport(timingsFileName, collector, true, true, false);
 
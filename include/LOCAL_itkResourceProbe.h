@@ -20,8 +20,13 @@
 
 #include "itkMacro.h"
 #include "itkIntTypes.h"
+#include "itkProbeRunningStatistics.h"
+#include "itkBenchmarkRobustStatistics.h"
+#include "itkBenchmarkSteadyStateDetector.h"
+#include "itkBenchmarkSystemInformation.h"
 
 #include <iostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -36,6 +41,19 @@ namespace itk
  *   between the execution of two pieces of code. It can be started and
  *   stopped in order to evaluate the execution over multiple passes.
  *
+ *   The summary statistics are updated in constant time by every Stop().
+ *   The individual values are kept for the reports; by default all of them
+ *   are kept, but SetMaximumNumberOfStoredValues() bounds the memory used by
+ *   replacing the full list with a uniform reservoir sample.
+ *
+ *   The first iterations often include one-time costs, such as page faults
+ *   or the creation of threads. By default, the leading iterations found by
+ *   BenchmarkSteadyStateDetector before the steady state are excluded from
+ *   the summary statistics (mean, minimum, maximum, standard deviation and
+ *   quantiles), but not from the total nor from the stored values. The
+ *   warm-up is only detected while all the values are stored in
+ *   measurement order.
+ *
  *   \sa TimeResourceProbe, MemoryResourceProbe
  *
  * \ingroup PerformanceBenchmarking
@@ -48,6 +66,9 @@ public:
    */
   using CountType = SizeValueType;
 
+  /** Type of the probed values. */
+  using ProbeValueType = ValueType;
+
 public:
   /** Constructor */
   LOCAL_ResourceProbe(std::string type, std::string unit);
@@ -107,6 +128,14 @@ public:
   virtual void
   Reset();
 
+  /** Account for the values measured by another probe of the same type, e.g.
+   *  the same region timed by another thread. The summary statistics are
+   *  exact; when the number of stored values is bounded, the merged list is
+   *  a uniform sample of the values of both probes, each list weighted by
+   *  the number of iterations of its probe. */
+  virtual void
+  Merge(const LOCAL_ResourceProbe & other);
+
   /** Returns the min value changes between the starts and stops
    *  of the probe */
   virtual ValueType
@@ -127,6 +156,71 @@ public:
   virtual ValueType
   GetStandardError();
 
+  /** Returns the quantile of the value changes between the starts and stops
+   *  of the probe for a probability in [0, 1], e.g. 0.99 for the 99th
+   *  percentile. The quantile is interpolated linearly between the closest
+   *  stored values; it is exact when all the values are stored and estimated
+   *  from the reservoir sample otherwise. Returns 0 if no value was stored. */
+  virtual ValueType
+  GetQuantile(double probability) const;
+
+  /** Returns the median, the median absolute deviation, the interquartile
+   *  range, the 95% confidence intervals of the mean and of the median, and
+   *  the Tukey outliers of the stored values, excluding the warm-up. Computed
+   *  on demand, and kept until the next Stop(). */
+  const BenchmarkRobustStatistics &
+  GetRobustStatistics() const;
+
+  /** Returns GetQuantile(0.5). */
+  ValueType
+  GetMedian() const;
+
+  /** Set the maximum number of individual values kept by the probe. When more
+   *  values are measured, a uniform random sample (reservoir) of this size is
+   *  kept instead. The summary statistics always account for every value.
+   *  Lowering the bound keeps a uniform sample of the stored values. Zero,
+   *  the default, keeps all the values. */
+  virtual void
+  SetMaximumNumberOfStoredValues(SizeValueType maximumNumberOfStoredValues);
+
+  /** Get the maximum number of individual values kept by the probe. */
+  virtual SizeValueType
+  GetMaximumNumberOfStoredValues() const;
+
+  /** Returns the individual values kept by the probe, in measurement order
+   *  unless the reservoir sampling is active. */
+  const std::vector<ValueType> &
+  GetProbeValueList() const;
+
+  /** Exclude the warm-up iterations from the summary statistics. On by
+   *  default. */
+  virtual void
+  SetExcludeWarmUp(bool excludeWarmUp);
+
+  /** Whether the warm-up iterations are excluded from the summary statistics. */
+  virtual bool
+  GetExcludeWarmUp() const;
+
+  /** Returns the number of warm-up iterations excluded from the summary
+   *  statistics, 0 when they are not excluded. */
+  CountType
+  GetNumberOfWarmUpIterations() const;
+
+  /** Returns the value measured by the first Stop(), typically with cold
+   *  caches, 0 if the probe was never stopped. */
+  ValueType
+  GetFirstValue() const;
+
+  /** Set a cost subtracted from every value measured by Stop(), typically
+   *  the calibrated cost of an empty Start()/Stop() pair. The corrected values
+   *  are clamped at zero. Zero, the default, disables the correction. */
+  virtual void
+  SetOverheadCorrection(ValueType overheadCorrection);
+
+  /** Get the cost subtracted from every measured value. */
+  virtual ValueType
+  GetOverheadCorrection() const;
+
   /** Set name of probe */
   virtual void
   SetNameOfProbe(const char * nameOfProbe);
@@ -171,52 +265,89 @@ protected:
   virtual void
   PrintExpandedReportHead(std::ostream & os = std::cout, bool useTabs = false);
 
+  /** Column header of a percentile in the text reports, e.g. "P99 (s)". */
+  std::string
+  PercentileLabel(double percentile) const;
+
   /** Prints a varName: varValue pair. */
   template <typename T>
   void
   PrintJSONvar(std::ostream & os, const char * varName, T varValue, unsigned indent = 4, bool comma = true);
 
-  /** Get System information */
+  /** Print the probe specific varName: varValue pairs, e.g. how the values
+   *  were measured, after the units in JSONReport(). Nothing by default. */
+  virtual void
+  PrintJSONMetadata(std::ostream & os);
+
+  /** Get System information, from the process wide snapshot taken before
+   *  the first probe is created. */
   virtual void
   GetSystemInformation();
 
+  /** Keep a measured value in the list, or in the reservoir sample once the
+   *  maximum number of stored values is reached. */
+  virtual void
+  StoreValue(ValueType value);
+
+  /** Sort the stored values after the warm-up, if they changed since the
+   *  last call. */
+  void
+  UpdateSortedProbeValueList() const;
+
+  /** Detect the warm-up iterations, and compute the statistics of the steady
+   *  state, if the values changed since the last call. */
+  void
+  UpdateSteadyState() const;
+
 private:
   ValueType m_StartValue;
-  ValueType m_TotalValue;
   ValueType m_MinimumValue;
   ValueType m_MaximumValue;
-  MeanType  m_MeanValue;
-  ValueType m_StandardDeviation;
-  ValueType m_StandardError;
 
   CountType m_NumberOfStarts;
   CountType m_NumberOfStops;
   CountType m_NumberOfIteration;
 
+  ProbeRunningStatistics<ValueType, MeanType> m_Statistics;
+
   std::vector<ValueType> m_ProbeValueList;
+  SizeValueType          m_MaximumNumberOfStoredValues{ 0 };
+  ValueType              m_OverheadCorrection{};
+  std::minstd_rand       m_ReservoirGenerator;
+
+  ValueType m_FirstValue{};
+  bool      m_ExcludeWarmUp{ true };
+  /** Whether m_ProbeValueList is in measurement order, false once probes
+   *  with values were merged. */
+  bool m_ValuesInMeasurementOrder{ true };
+
+  /** The warm-up and the statistics of the values after it, built on demand
+   *  by UpdateSteadyState(). */
+  mutable CountType                                   m_NumberOfWarmUpIterations{ 0 };
+  mutable ProbeRunningStatistics<ValueType, MeanType> m_SteadyStateStatistics;
+  mutable ValueType                                   m_SteadyStateMinimumValue{};
+  mutable ValueType                                   m_SteadyStateMaximumValue{};
+  mutable bool                                        m_SteadyStateIsValid{ false };
+
+  /** Sorted copy of m_ProbeValueList, built on demand by GetQuantile(). */
+  mutable std::vector<ValueType> m_SortedProbeValueList;
+  mutable bool                   m_SortedProbeValueListIsValid{ false };
+
+  /** Built on demand by GetRobustStatistics() from the sorted values. */
+  mutable BenchmarkRobustStatistics m_RobustStatistics;
+  mutable bool                      m_RobustStatisticsIsValid{ false };
 
   std::string m_NameOfProbe;
   std::string m_TypeString;
   std::string m_UnitString;
 
-  std::string  m_SystemName;
-  std::string  m_ProcessorName;
-  int          m_ProcessorCacheSize;
-  float        m_ProcessorClockFrequency;
-  unsigned int m_NumberOfPhysicalCPU;
-  unsigned int m_NumberOfLogicalCPU;
-  std::string  m_OSName;
-  std::string  m_OSRelease;
-  std::string  m_OSVersion;
-  std::string  m_OSPlatform;
-  bool         m_Is64Bits;
-  std::string  m_ITKVersion;
-  size_t       m_TotalVirtualMemory;
-  size_t       m_AvailableVirtualMemory;
-  size_t       m_TotalPhysicalMemory;
-  size_t       m_AvailablePhysicalMemory;
+  /** The process wide snapshot, shared by all the probes. */
+  const BenchmarkSystemInformation * m_SystemInformation{ nullptr };
 
   static constexpr unsigned int tabwidth = 15;
+
+  /** Percentiles printed by the reports. */
+  static constexpr double reportedPercentiles[] = { 50.0, 90.0, 99.0, 99.9 };
 };
 } // end namespace itk
 
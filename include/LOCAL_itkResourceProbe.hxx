@@ -28,16 +28,13 @@
 #ifndef itkLOCALResourceProbe_hxx
 #define itkLOCALResourceProbe_hxx
 
-#include <numeric>
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
-#include <functional>
 #include <utility>
 #include <type_traits>
 
 #include "itkNumericTraits.h"
-#include "itksys/SystemInformation.hxx"
 #include "itkMath.h"
 
 namespace itk
@@ -61,18 +58,96 @@ template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::Reset()
 {
-  this->m_TotalValue = NumericTraits<ValueType>::ZeroValue();
   this->m_StartValue = NumericTraits<ValueType>::ZeroValue();
   this->m_MinimumValue = NumericTraits<ValueType>::max();
-  this->m_MaximumValue = NumericTraits<ValueType>::min();
-  this->m_MeanValue = NumericTraits<MeanType>::ZeroValue();
-  this->m_StandardDeviation = NumericTraits<ValueType>::ZeroValue();
+  this->m_MaximumValue = NumericTraits<ValueType>::NonpositiveMin();
 
   this->m_NumberOfStarts = NumericTraits<CountType>::ZeroValue();
   this->m_NumberOfStops = NumericTraits<CountType>::ZeroValue();
   this->m_NumberOfIteration = NumericTraits<CountType>::ZeroValue();
 
+  this->m_Statistics.Reset();
   this->m_ProbeValueList.clear();
+  this->m_SortedProbeValueListIsValid = false;
+  this->m_FirstValue = NumericTraits<ValueType>::ZeroValue();
+  this->m_ValuesInMeasurementOrder = true;
+  this->m_SteadyStateIsValid = false;
+  // Reseed so that the reservoir sample of a given sequence is reproducible.
+  this->m_ReservoirGenerator.seed(std::minstd_rand::default_seed);
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::Merge(const LOCAL_ResourceProbe & other)
+{
+  if (other.m_NumberOfStops == 0)
+  {
+    return;
+  }
+
+  // The number of values each list of stored values stands for.
+  const CountType thisNumberOfValues = this->m_NumberOfIteration;
+  const CountType otherNumberOfValues = other.m_NumberOfIteration;
+  if (this->m_NumberOfStops == 0)
+  {
+    this->m_FirstValue = other.m_FirstValue;
+    this->m_ValuesInMeasurementOrder = other.m_ValuesInMeasurementOrder;
+  }
+  else
+  {
+    // The values of the two probes are interleaved in time.
+    this->m_ValuesInMeasurementOrder = false;
+  }
+  this->m_NumberOfStarts += other.m_NumberOfStarts;
+  this->m_NumberOfStops += other.m_NumberOfStops;
+  this->m_NumberOfIteration = this->m_NumberOfStops;
+  this->UpdateMinimumMaximumMeasuredValue(other.m_MinimumValue);
+  this->UpdateMinimumMaximumMeasuredValue(other.m_MaximumValue);
+  this->m_Statistics.Merge(other.m_Statistics);
+
+  this->m_SortedProbeValueListIsValid = false;
+  this->m_SteadyStateIsValid = false;
+  if (this->m_MaximumNumberOfStoredValues == 0 ||
+      this->m_ProbeValueList.size() + other.m_ProbeValueList.size() <= this->m_MaximumNumberOfStoredValues)
+  {
+    this->m_ProbeValueList.insert(
+      this->m_ProbeValueList.end(), other.m_ProbeValueList.begin(), other.m_ProbeValueList.end());
+    return;
+  }
+
+  // Each list is a uniform sample of the values of its probe. Drawing from
+  // them without replacement, in proportion to the number of values that
+  // remain on each side, gives a uniform sample of the values of both.
+  std::vector<ValueType> thisValues;
+  thisValues.swap(this->m_ProbeValueList);
+  std::vector<ValueType> otherValues(other.m_ProbeValueList);
+  std::shuffle(thisValues.begin(), thisValues.end(), this->m_ReservoirGenerator);
+  std::shuffle(otherValues.begin(), otherValues.end(), this->m_ReservoirGenerator);
+  CountType thisRemaining = thisNumberOfValues;
+  CountType otherRemaining = otherNumberOfValues;
+  size_t    thisNext = 0;
+  size_t    otherNext = 0;
+  this->m_ProbeValueList.reserve(this->m_MaximumNumberOfStoredValues);
+  while (this->m_ProbeValueList.size() < this->m_MaximumNumberOfStoredValues)
+  {
+    bool fromThis = otherNext == otherValues.size();
+    if (thisNext < thisValues.size() && otherNext < otherValues.size())
+    {
+      std::uniform_int_distribution<CountType> distribution(0, thisRemaining + otherRemaining - 1);
+      fromThis = distribution(this->m_ReservoirGenerator) < thisRemaining;
+    }
+    if (fromThis)
+    {
+      this->m_ProbeValueList.push_back(thisValues[thisNext++]);
+      --thisRemaining;
+    }
+    else
+    {
+      this->m_ProbeValueList.push_back(otherValues[otherNext++]);
+      --otherRemaining;
+    }
+  }
 }
 
 
@@ -111,11 +186,169 @@ LOCAL_ResourceProbe<ValueType, MeanType>::Stop()
     return;
   }
 
+  if (this->m_OverheadCorrection > NumericTraits<ValueType>::ZeroValue())
+  {
+    probevalue = probevalue > this->m_OverheadCorrection ? probevalue - this->m_OverheadCorrection
+                                                         : NumericTraits<ValueType>::ZeroValue();
+  }
+
+  if (this->m_NumberOfStops == 0)
+  {
+    this->m_FirstValue = probevalue;
+  }
   this->UpdateMinimumMaximumMeasuredValue(probevalue);
-  this->m_TotalValue += probevalue;
-  this->m_ProbeValueList.push_back(probevalue);
+  this->m_Statistics.AddValue(probevalue);
+  this->StoreValue(probevalue);
   this->m_NumberOfStops++;
-  this->m_NumberOfIteration = static_cast<CountType>(this->m_ProbeValueList.size());
+  this->m_NumberOfIteration = this->m_NumberOfStops;
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::StoreValue(ValueType value)
+{
+  this->m_SortedProbeValueListIsValid = false;
+  this->m_SteadyStateIsValid = false;
+  if (this->m_MaximumNumberOfStoredValues == 0 || this->m_ProbeValueList.size() < this->m_MaximumNumberOfStoredValues)
+  {
+    this->m_ProbeValueList.push_back(value);
+    return;
+  }
+
+  // Reservoir sampling (Vitter's algorithm R): the value measured at the n-th
+  // stop replaces a stored value with probability size / n.
+  std::uniform_int_distribution<SizeValueType> distribution(0, this->m_Statistics.GetCount() - 1);
+  const SizeValueType                          slot = distribution(this->m_ReservoirGenerator);
+  if (slot < this->m_ProbeValueList.size())
+  {
+    this->m_ProbeValueList[slot] = value;
+  }
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::SetOverheadCorrection(ValueType overheadCorrection)
+{
+  this->m_OverheadCorrection = overheadCorrection;
+}
+
+
+template <typename ValueType, typename MeanType>
+ValueType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetOverheadCorrection() const
+{
+  return this->m_OverheadCorrection;
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::SetMaximumNumberOfStoredValues(SizeValueType maximumNumberOfStoredValues)
+{
+  this->m_MaximumNumberOfStoredValues = maximumNumberOfStoredValues;
+  if (maximumNumberOfStoredValues > 0 && this->m_ProbeValueList.size() > maximumNumberOfStoredValues)
+  {
+    // Selection sampling (Knuth's algorithm S): keep each value with
+    // probability needed / remaining, a uniform sample in the order of the
+    // list.
+    const size_t  size = this->m_ProbeValueList.size();
+    SizeValueType kept = 0;
+    for (size_t ii = 0; ii < size && kept < maximumNumberOfStoredValues; ++ii)
+    {
+      std::uniform_int_distribution<size_t> distribution(0, size - ii - 1);
+      if (distribution(this->m_ReservoirGenerator) < maximumNumberOfStoredValues - kept)
+      {
+        this->m_ProbeValueList[kept++] = this->m_ProbeValueList[ii];
+      }
+    }
+    this->m_ProbeValueList.resize(maximumNumberOfStoredValues);
+    this->m_SortedProbeValueListIsValid = false;
+    this->m_SteadyStateIsValid = false;
+  }
+}
+
+
+template <typename ValueType, typename MeanType>
+SizeValueType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetMaximumNumberOfStoredValues() const
+{
+  return this->m_MaximumNumberOfStoredValues;
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::SetExcludeWarmUp(bool excludeWarmUp)
+{
+  this->m_ExcludeWarmUp = excludeWarmUp;
+  this->m_SortedProbeValueListIsValid = false;
+  this->m_SteadyStateIsValid = false;
+}
+
+
+template <typename ValueType, typename MeanType>
+bool
+LOCAL_ResourceProbe<ValueType, MeanType>::GetExcludeWarmUp() const
+{
+  return this->m_ExcludeWarmUp;
+}
+
+
+template <typename ValueType, typename MeanType>
+typename LOCAL_ResourceProbe<ValueType, MeanType>::CountType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetNumberOfWarmUpIterations() const
+{
+  this->UpdateSteadyState();
+  return this->m_NumberOfWarmUpIterations;
+}
+
+
+template <typename ValueType, typename MeanType>
+ValueType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetFirstValue() const
+{
+  return this->m_FirstValue;
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::UpdateSteadyState() const
+{
+  if (this->m_SteadyStateIsValid)
+  {
+    return;
+  }
+  this->m_SteadyStateIsValid = true;
+  this->m_NumberOfWarmUpIterations = 0;
+  if (!this->m_ExcludeWarmUp || !this->m_ValuesInMeasurementOrder ||
+      this->m_ProbeValueList.size() != this->m_Statistics.GetCount())
+  {
+    return;
+  }
+
+  const std::vector<double> values(this->m_ProbeValueList.begin(), this->m_ProbeValueList.end());
+  this->m_NumberOfWarmUpIterations = BenchmarkSteadyStateDetector::GetNumberOfWarmUpValues(values);
+  this->m_SteadyStateStatistics.Reset();
+  this->m_SteadyStateMinimumValue = NumericTraits<ValueType>::max();
+  this->m_SteadyStateMaximumValue = NumericTraits<ValueType>::NonpositiveMin();
+  for (size_t ii = this->m_NumberOfWarmUpIterations; ii < this->m_ProbeValueList.size(); ++ii)
+  {
+    const ValueType value = this->m_ProbeValueList[ii];
+    this->m_SteadyStateStatistics.AddValue(value);
+    this->m_SteadyStateMinimumValue = std::min(this->m_SteadyStateMinimumValue, value);
+    this->m_SteadyStateMaximumValue = std::max(this->m_SteadyStateMaximumValue, value);
+  }
+}
+
+
+template <typename ValueType, typename MeanType>
+const std::vector<ValueType> &
+LOCAL_ResourceProbe<ValueType, MeanType>::GetProbeValueList() const
+{
+  return this->m_ProbeValueList;
 }
 
 
@@ -147,7 +380,7 @@ template <typename ValueType, typename MeanType>
 ValueType
 LOCAL_ResourceProbe<ValueType, MeanType>::GetTotal() const
 {
-  return this->m_TotalValue;
+  return this->m_Statistics.GetTotal();
 }
 
 
@@ -155,14 +388,11 @@ template <typename ValueType, typename MeanType>
 MeanType
 LOCAL_ResourceProbe<ValueType, MeanType>::GetMean() const
 {
-  MeanType meanValue = NumericTraits<MeanType>::ZeroValue();
-
-  if (this->m_NumberOfStops)
+  if (this->GetNumberOfWarmUpIterations() > 0)
   {
-    meanValue = static_cast<MeanType>(this->m_TotalValue) / static_cast<MeanType>(this->m_NumberOfStops);
+    return this->m_SteadyStateStatistics.GetMean();
   }
-
-  return meanValue;
+  return this->m_Statistics.GetMean();
 }
 
 
@@ -170,6 +400,10 @@ template <typename ValueType, typename MeanType>
 ValueType
 LOCAL_ResourceProbe<ValueType, MeanType>::GetMinimum() const
 {
+  if (this->GetNumberOfWarmUpIterations() > 0)
+  {
+    return this->m_SteadyStateMinimumValue;
+  }
   return this->m_MinimumValue;
 }
 
@@ -178,6 +412,10 @@ template <typename ValueType, typename MeanType>
 ValueType
 LOCAL_ResourceProbe<ValueType, MeanType>::GetMaximum() const
 {
+  if (this->GetNumberOfWarmUpIterations() > 0)
+  {
+    return this->m_SteadyStateMaximumValue;
+  }
   return this->m_MaximumValue;
 }
 
@@ -186,36 +424,75 @@ template <typename ValueType, typename MeanType>
 ValueType
 LOCAL_ResourceProbe<ValueType, MeanType>::GetStandardDeviation()
 {
-  this->m_MeanValue = this->GetMean();
-  std::vector<ValueType> diff(this->m_ProbeValueList.size());
-  std::transform(this->m_ProbeValueList.begin(),
-                 this->m_ProbeValueList.end(),
-                 diff.begin(),
-                 std::bind(std::minus<ValueType>(), std::placeholders::_1, static_cast<ValueType>(this->m_MeanValue)));
-  ValueType sqsum = std::inner_product(diff.begin(), diff.end(), diff.begin(), NumericTraits<ValueType>::ZeroValue());
+  if (this->GetNumberOfWarmUpIterations() > 0)
+  {
+    return static_cast<ValueType>(this->m_SteadyStateStatistics.GetStandardDeviation());
+  }
+  return static_cast<ValueType>(this->m_Statistics.GetStandardDeviation());
+}
+
 
-  int sz = static_cast<int>(this->m_ProbeValueList.size()) - 1;
-  if (sz <= 0)
+template <typename ValueType, typename MeanType>
+ValueType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetStandardError()
+{
+  if (this->GetNumberOfWarmUpIterations() > 0)
   {
-    this->m_StandardDeviation = NumericTraits<ValueType>::ZeroValue();
+    return static_cast<ValueType>(this->m_SteadyStateStatistics.GetStandardError());
   }
-  else
+  return static_cast<ValueType>(this->m_Statistics.GetStandardError());
+}
+
+
+template <typename ValueType, typename MeanType>
+ValueType
+LOCAL_ResourceProbe<ValueType, MeanType>::GetQuantile(double probability) const
+{
+  if (this->m_ProbeValueList.empty())
   {
-    this->m_StandardDeviation =
-      static_cast<ValueType>(std::sqrt(static_cast<double>(sqsum / (static_cast<ValueType>(sz)))));
+    return NumericTraits<ValueType>::ZeroValue();
   }
-  return this->m_StandardDeviation;
+  this->UpdateSortedProbeValueList();
+  return static_cast<ValueType>(BenchmarkRobustStatistics::GetQuantile(this->m_SortedProbeValueList, probability));
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::UpdateSortedProbeValueList() const
+{
+  if (this->m_SortedProbeValueListIsValid)
+  {
+    return;
+  }
+  const auto warmUpIterations = static_cast<std::ptrdiff_t>(this->GetNumberOfWarmUpIterations());
+  this->m_SortedProbeValueList.assign(this->m_ProbeValueList.begin() + warmUpIterations, this->m_ProbeValueList.end());
+  std::sort(this->m_SortedProbeValueList.begin(), this->m_SortedProbeValueList.end());
+  this->m_SortedProbeValueListIsValid = true;
+  this->m_RobustStatisticsIsValid = false;
+}
+
+
+template <typename ValueType, typename MeanType>
+const BenchmarkRobustStatistics &
+LOCAL_ResourceProbe<ValueType, MeanType>::GetRobustStatistics() const
+{
+  this->UpdateSortedProbeValueList();
+  if (!this->m_RobustStatisticsIsValid)
+  {
+    this->m_RobustStatistics = BenchmarkRobustStatistics::Compute(
+      std::vector<double>(this->m_SortedProbeValueList.begin(), this->m_SortedProbeValueList.end()));
+    this->m_RobustStatisticsIsValid = true;
+  }
+  return this->m_RobustStatistics;
 }
 
 
 template <typename ValueType, typename MeanType>
 ValueType
-LOCAL_ResourceProbe<ValueType, MeanType>::GetStandardError()
+LOCAL_ResourceProbe<ValueType, MeanType>::GetMedian() const
 {
-  const ValueType standardDeviation = this->GetStandardDeviation();
-  this->m_StandardError =
-    static_cast<ValueType>(standardDeviation / std::sqrt(static_cast<double>(this->m_ProbeValueList.size())));
-  return this->m_StandardError;
+  return this->GetQuantile(0.5);
 }
 
 
@@ -238,26 +515,7 @@ template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::PrintSystemInformation(std::ostream & os)
 {
-  os << "System:              " << m_SystemName << std::endl;
-  os << "Processor:           " << m_ProcessorName << std::endl;
-  os << "    Cache:           " << m_ProcessorCacheSize << std::endl;
-  os << "    Clock:           " << m_ProcessorClockFrequency << std::endl;
-  os << "    Physical CPUs:   " << m_NumberOfPhysicalCPU << std::endl;
-  os << "    Logical CPUs:    " << m_NumberOfLogicalCPU << std::endl;
-  // Retrieve memory information in mebibytes.
-  os << "    Virtual Memory:  Total: " << std::left << std::setw(tabwidth) << m_TotalVirtualMemory
-     << " Available: " << m_AvailableVirtualMemory << std::endl;
-  os << "    Physical Memory: Total: " << std::left << std::setw(tabwidth) << m_TotalPhysicalMemory
-     << " Available: " << m_AvailablePhysicalMemory << std::endl;
-
-  os << "OSName:              " << m_OSName << std::endl;
-  os << "    Release:         " << m_OSRelease << std::endl;
-  os << "    Version:         " << m_OSVersion << std::endl;
-  os << "    Platform:        " << m_OSPlatform << std::endl;
-
-  os << "    Operating System is " << (m_Is64Bits ? "64 bit" : "32 bit") << std::endl;
-
-  os << "ITK Version: " << m_ITKVersion << std::endl;
+  this->m_SystemInformation->Print(os);
 }
 
 
@@ -284,6 +542,11 @@ LOCAL_ResourceProbe<ValueType, MeanType>::Report(std::ostream & os,
     ss << std::left << '\t' << this->m_NameOfProbe << std::left << '\t' << this->m_NumberOfIteration << std::left
        << '\t' << this->GetTotal() << std::left << '\t' << this->GetMinimum() << std::left << '\t' << this->GetMean()
        << std::left << '\t' << this->GetMaximum() << std::left << '\t' << this->GetStandardDeviation();
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << '\t' << this->GetQuantile(percentile / 100.0);
+    }
+    ss << std::left << '\t' << this->GetNumberOfWarmUpIterations() << std::left << '\t' << this->GetFirstValue();
   }
   else
   {
@@ -291,6 +554,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::Report(std::ostream & os,
        << this->m_NumberOfIteration << std::left << std::setw(tabwidth) << this->GetTotal() << std::left
        << std::setw(tabwidth) << this->GetMinimum() << std::left << std::setw(tabwidth) << this->GetMean() << std::left
        << std::setw(tabwidth) << this->GetMaximum() << std::left << std::setw(tabwidth) << this->GetStandardDeviation();
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << std::setw(tabwidth) << this->GetQuantile(percentile / 100.0);
+    }
+    ss << std::left << std::setw(tabwidth) << this->GetNumberOfWarmUpIterations() << std::left << std::setw(tabwidth)
+       << this->GetFirstValue();
   }
   os << ss.str() << std::endl;
 }
@@ -344,6 +613,11 @@ LOCAL_ResourceProbe<ValueType, MeanType>::ExpandedReport(std::ostream & os,
        << ratioOfMaximumToMean * 100 << std::left << '\t' << this->GetMaximum() << std::left << '\t'
        << this->GetMaximum() - this->GetMinimum() << std::left << '\t' << this->GetStandardDeviation() << std::left
        << '\t' << this->GetStandardError();
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << '\t' << this->GetQuantile(percentile / 100.0);
+    }
+    ss << std::left << '\t' << this->GetNumberOfWarmUpIterations() << std::left << '\t' << this->GetFirstValue();
   }
   else
   {
@@ -356,6 +630,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::ExpandedReport(std::ostream & os,
        << std::left << std::setw(tabwidth) << this->GetMaximum() << std::left << std::setw(tabwidth)
        << this->GetMaximum() - this->GetMinimum() << std::left << std::setw(tabwidth) << this->GetStandardDeviation()
        << std::left << std::setw(tabwidth) << this->GetStandardError();
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << std::setw(tabwidth) << this->GetQuantile(percentile / 100.0);
+    }
+    ss << std::left << std::setw(tabwidth) << this->GetNumberOfWarmUpIterations() << std::left << std::setw(tabwidth)
+       << this->GetFirstValue();
   }
   os << ss.str() << std::endl;
 }
@@ -391,6 +671,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::PrintJSONvar(std::ostream & os,
   os << '\n'; // std::endl has a side-effect of flushing the stream
 }
 
+
+template <typename ValueType, typename MeanType>
+void
+LOCAL_ResourceProbe<ValueType, MeanType>::PrintJSONMetadata(std::ostream &)
+{}
+
 template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::JSONReport(std::ostream & os)
@@ -422,6 +708,7 @@ LOCAL_ResourceProbe<ValueType, MeanType>::JSONReport(std::ostream & os)
   PrintJSONvar(os, "Type", m_TypeString);
   PrintJSONvar(os, "Iterations", m_NumberOfIteration);
   PrintJSONvar(os, "Units", m_UnitString);
+  this->PrintJSONMetadata(os);
 
   PrintJSONvar(os, "Mean", this->GetMean());
   PrintJSONvar(os, "Minimum", this->GetMinimum());
@@ -429,19 +716,50 @@ LOCAL_ResourceProbe<ValueType, MeanType>::JSONReport(std::ostream & os)
   PrintJSONvar(os, "Total", this->GetTotal());
   PrintJSONvar(os, "StandardDeviation", this->GetStandardDeviation());
   PrintJSONvar(os, "StandardError", this->GetStandardError());
+  for (const double percentile : reportedPercentiles)
+  {
+    std::ostringstream percentileName;
+    percentileName << "Percentile" << percentile;
+    PrintJSONvar(os, percentileName.str().c_str(), this->GetQuantile(percentile / 100.0));
+  }
+  const BenchmarkRobustStatistics & robustStatistics = this->GetRobustStatistics();
+  PrintJSONvar(os, "Median", robustStatistics.GetMedian());
+  PrintJSONvar(os, "MedianAbsoluteDeviation", robustStatistics.GetMedianAbsoluteDeviation());
+  PrintJSONvar(os, "InterquartileRange", robustStatistics.GetInterquartileRange());
+  PrintJSONvar(os, "ConfidenceLevel", robustStatistics.GetConfidenceLevel());
+  PrintJSONvar(os, "MeanConfidenceIntervalLower", robustStatistics.GetMeanConfidenceInterval().first);
+  PrintJSONvar(os, "MeanConfidenceIntervalUpper", robustStatistics.GetMeanConfidenceInterval().second);
+  PrintJSONvar(os, "MedianConfidenceIntervalLower", robustStatistics.GetMedianConfidenceInterval().first);
+  PrintJSONvar(os, "MedianConfidenceIntervalUpper", robustStatistics.GetMedianConfidenceInterval().second);
+  PrintJSONvar(os, "MildOutliers", robustStatistics.GetNumberOfMildOutliers());
+  PrintJSONvar(os, "SevereOutliers", robustStatistics.GetNumberOfSevereOutliers());
+  PrintJSONvar(os, "WarmUpIterations", this->GetNumberOfWarmUpIterations());
+  PrintJSONvar(os, "FirstIteration", this->GetFirstValue());
+  PrintJSONvar(os, "MeanIncludingWarmUp", this->m_Statistics.GetMean());
 
   PrintJSONvar(os, "TotalDifference", this->GetMaximum() - this->GetMinimum());
   PrintJSONvar(os, "MeanMinimumDifference", this->GetMean() - this->GetMinimum());
   PrintJSONvar(os, "MeanMinimumDifferencePercent", ratioOfMeanToMinimum * 100);
   PrintJSONvar(os, "MaximumMeanDifference", this->GetMaximum() - this->GetMean());
   PrintJSONvar(os, "MaximumMeanDifferencePercent", ratioOfMaximumToMean * 100, 4);
+  if (this->m_MaximumNumberOfStoredValues > 0)
+  {
+    PrintJSONvar(os, "MaximumNumberOfStoredValues", this->m_MaximumNumberOfStoredValues);
+  }
+  if (this->m_OverheadCorrection > NumericTraits<ValueType>::ZeroValue())
+  {
+    PrintJSONvar(os, "OverheadCorrection", this->m_OverheadCorrection);
+  }
   os << "    "
      << "\"Values\": [";
-  for (size_t ii = 0; ii < m_ProbeValueList.size() - 1; ++ii)
+  for (size_t ii = 0; ii < m_ProbeValueList.size(); ++ii)
   {
-    os << m_ProbeValueList[ii] << ", ";
+    if (ii > 0)
+    {
+      os << ", ";
+    }
+    os << m_ProbeValueList[ii];
   }
-  os << m_ProbeValueList.at(m_ProbeValueList.size() - 1);
   os << "]\n";
   os << "  }";
 }
@@ -476,6 +794,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::PrintReportHead(std::ostream & os, boo
        << std::string("Mean (") + this->m_UnitString + std::string(")") << std::left << '\t'
        << std::string("Max (") + this->m_UnitString + std::string(")") << std::left << '\t'
        << std::string("StdDev (") + this->m_UnitString + std::string(")");
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << '\t' << this->PercentileLabel(percentile);
+    }
+    ss << std::left << '\t' << "Warm-up" << std::left << '\t'
+       << std::string("First (") + this->m_UnitString + std::string(")");
   }
   else
   {
@@ -486,12 +810,28 @@ LOCAL_ResourceProbe<ValueType, MeanType>::PrintReportHead(std::ostream & os, boo
        << std::string("Mean (") + this->m_UnitString + std::string(")") << std::left << std::setw(tabwidth)
        << std::string("Max (") + this->m_UnitString + std::string(")") << std::left << std::setw(tabwidth)
        << std::string("StdDev (") + this->m_UnitString + std::string(")");
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << std::setw(tabwidth) << this->PercentileLabel(percentile);
+    }
+    ss << std::left << std::setw(tabwidth) << "Warm-up" << std::left << std::setw(tabwidth)
+       << std::string("First (") + this->m_UnitString + std::string(")");
   }
 
   os << ss.str() << std::endl;
 }
 
 
+template <typename ValueType, typename MeanType>
+std::string
+LOCAL_ResourceProbe<ValueType, MeanType>::PercentileLabel(double percentile) const
+{
+  std::ostringstream label;
+  label << 'P' << percentile << " (" << this->m_UnitString << ')';
+  return label.str();
+}
+
+
 template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::PrintExpandedReportHead(std::ostream & os, bool useTabs)
@@ -509,6 +849,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::PrintExpandedReportHead(std::ostream &
        << std::string("Total Diff (") + this->m_UnitString + std::string(")") << std::left << '\t'
        << std::string("StdDev (") + this->m_UnitString + std::string(")") << std::left << '\t'
        << std::string("StdErr (") + this->m_UnitString + std::string(")");
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << '\t' << this->PercentileLabel(percentile);
+    }
+    ss << std::left << '\t' << "Warm-up" << std::left << '\t'
+       << std::string("First (") + this->m_UnitString + std::string(")");
   }
   else
   {
@@ -523,6 +869,12 @@ LOCAL_ResourceProbe<ValueType, MeanType>::PrintExpandedReportHead(std::ostream &
        << std::string("Total Diff (") + this->m_UnitString + std::string(")") << std::left << std::setw(tabwidth)
        << std::string("StdDev (") + this->m_UnitString + std::string(")") << std::left << std::setw(tabwidth)
        << std::string("StdErr (") + this->m_UnitString + std::string(")");
+    for (const double percentile : reportedPercentiles)
+    {
+      ss << std::left << std::setw(tabwidth) << this->PercentileLabel(percentile);
+    }
+    ss << std::left << std::setw(tabwidth) << "Warm-up" << std::left << std::setw(tabwidth)
+       << std::string("First (") + this->m_UnitString + std::string(")");
   }
 
   os << ss.str() << std::endl;
@@ -533,64 +885,14 @@ template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::PrintJSONSystemInformation(std::ostream & os)
 {
-  os << "{\n";
-  PrintJSONvar(os, "System", m_SystemName);
-
-  os << "    \"Processor\" :{\n";
-  PrintJSONvar(os, "Name", m_ProcessorName, 6);
-  PrintJSONvar(os, "Cache", m_ProcessorCacheSize, 6);
-  PrintJSONvar(os, "Clock", m_ProcessorClockFrequency, 6);
-  PrintJSONvar(os, "Physical CPUs", m_NumberOfPhysicalCPU, 6);
-  PrintJSONvar(os, "Logical CPUs", m_NumberOfLogicalCPU, 6);
-  PrintJSONvar(os, "Virtual Memory Total", m_TotalVirtualMemory, 6);
-  PrintJSONvar(os, "Virtual Memory Available", m_AvailableVirtualMemory, 6);
-  PrintJSONvar(os, "Physical Memory Total", m_TotalPhysicalMemory, 6);
-  PrintJSONvar(os, "Physical Memory Available", m_AvailablePhysicalMemory, 6, false);
-  os << "    },\n";
-
-  os << "    \"OperatingSystem\" :{\n";
-  PrintJSONvar(os, "Name", m_OSName, 6);
-  PrintJSONvar(os, "Release", m_OSRelease, 6);
-  PrintJSONvar(os, "Version", m_OSVersion, 6);
-  PrintJSONvar(os, "Platform", m_OSPlatform, 6);
-  PrintJSONvar(os, "Bitness", (m_Is64Bits ? "64 bit" : "32 bit"), 6, false);
-  os << "    },\n";
-
-  PrintJSONvar(os, "ITKVersion", m_ITKVersion, 4, false);
-  os << "  }";
+  this->m_SystemInformation->PrintJSON(os);
 }
 
 template <typename ValueType, typename MeanType>
 void
 LOCAL_ResourceProbe<ValueType, MeanType>::GetSystemInformation()
 {
-  itksys::SystemInformation systeminfo;
-  systeminfo.RunCPUCheck();
-  systeminfo.RunMemoryCheck();
-  systeminfo.RunOSCheck();
-
-  m_SystemName = systeminfo.GetHostname();
-  m_ProcessorName = systeminfo.GetExtendedProcessorName();
-  m_ProcessorCacheSize = systeminfo.GetProcessorCacheSize();
-  m_ProcessorClockFrequency = systeminfo.GetProcessorClockFrequency();
-  m_NumberOfPhysicalCPU = systeminfo.GetNumberOfPhysicalCPU();
-  m_NumberOfLogicalCPU = systeminfo.GetNumberOfLogicalCPU();
-
-  m_OSName = systeminfo.GetOSName();
-  m_OSRelease = systeminfo.GetOSRelease();
-  m_OSVersion = systeminfo.GetOSVersion();
-  m_OSPlatform = systeminfo.GetOSPlatform();
-
-  m_Is64Bits = systeminfo.Is64Bits();
-  std::ostringstream itkversion;
-  itkversion << ITK_VERSION_MAJOR << "." << ITK_VERSION_MINOR << "." << ITK_VERSION_PATCH;
-  m_ITKVersion = itkversion.str();
-
-  // Retrieve memory information in mebibytes.
-  m_TotalVirtualMemory = systeminfo.GetTotalVirtualMemory();
-  m_AvailableVirtualMemory = systeminfo.GetAvailableVirtualMemory();
-  m_TotalPhysicalMemory = systeminfo.GetTotalPhysicalMemory();
-  m_AvailablePhysicalMemory = systeminfo.GetAvailablePhysicalMemory();
+  this->m_SystemInformation = &BenchmarkSystemInformation::GetInstance();
 }
 
 } // end namespace itk
@@ -22,6 +22,11 @@
 #include "LOCAL_itkResourceProbe.h"
 #include "itkMemoryUsageObserver.h"
 
+#include <deque>
+#include <limits>
+#include <map>
+#include <vector>
+
 namespace itk
 {
 /** \class LOCAL_ResourceProbesCollectorBase
@@ -30,6 +35,44 @@ namespace itk
  *  This class defines a set of ResourceProbes and assign names to them.
  *  The user can start and stop each one of the probes by addressing them by name.
  *
+ *  Addressing a probe by name costs a string construction and a map lookup
+ *  on every Start() and Stop(). Timing loops should instead register the
+ *  name once with GetProbeHandle() and start and stop the probe through the
+ *  returned handle, which is an index into the probe container:
+ *
+ *  \code
+ *  const auto handle = collector.GetProbeHandle("Median");
+ *  for (int ii = 0; ii < iterations; ++ii)
+ *  {
+ *    collector.Start(handle);
+ *    filter->UpdateLargestPossibleRegion();
+ *    collector.Stop(handle);
+ *  }
+ *  \endcode
+ *
+ *  Nested phases are timed with scoped probes. A ScopedProbe starts a probe
+ *  when it is constructed and stops it when it goes out of scope; the probe
+ *  is named after the enclosing scopes, e.g. "LevelSet/FastMarching", and
+ *  records the enclosing probe as its parent. The reports then render the
+ *  call tree with the inclusive time of each scope and its exclusive time,
+ *  which excludes the time spent in the nested scopes:
+ *
+ *  \code
+ *  {
+ *    CollectorType::ScopedProbe levelSet(collector, "LevelSet");
+ *    {
+ *      CollectorType::ScopedProbe fastMarching(collector, "FastMarching");
+ *      fastMarchingFilter->Update();
+ *    }
+ *    shapeDetectionFilter->Update();
+ *  }
+ *  \endcode
+ *
+ *  The cost of an empty Start()/Stop() pair (the clock reads, the storage
+ *  of the value, ...) is included in every measured value. It is calibrated
+ *  when the first probe is created, reported in the JSON report, and can be
+ *  subtracted from the measured values with SetSubtractOverhead(true).
+ *
  *  \sa LOCAL_ResourceProbe
  *
  * \ingroup PerformanceBenchmarking
@@ -38,8 +81,66 @@ template <typename TProbe>
 class ITK_TEMPLATE_EXPORT LOCAL_ResourceProbesCollectorBase
 {
 public:
+  using ProbeType = TProbe;
   using IdType = std::string;
-  using MapType = std::map<IdType, TProbe>;
+  /** Index of a probe in the collector, returned by GetProbeHandle(). It
+   *  remains valid until Clear() is called. */
+  using ProbeHandleType = SizeValueType;
+  using MapType = std::map<IdType, ProbeHandleType>;
+  /** Probes are never moved once created, so references to them stay valid. */
+  using ProbeContainerType = std::deque<TProbe>;
+  using ProbeValueType = typename TProbe::ProbeValueType;
+
+  /** Parent handle of the probes that are not nested in a scope. */
+  static constexpr ProbeHandleType NoParentHandle = std::numeric_limits<ProbeHandleType>::max();
+
+  /** \class ScopedProbe
+   *  \brief Times the lifetime of a scope with a probe of a collector.
+   *
+   *  The probe is named after the scopes of the same collector that enclose
+   *  it, separated by '/'. Scopes must be nested, as automatic variables are.
+   *  A scope that was open when the collector was cleared is not stopped.
+   *
+   * \ingroup PerformanceBenchmarking
+   */
+  class ScopedProbe
+  {
+  public:
+    ScopedProbe(LOCAL_ResourceProbesCollectorBase & collector, const char * name)
+      : m_Collector(collector)
+      , m_Handle(collector.StartScope(name))
+      , m_NumberOfClears(collector.GetNumberOfClears())
+    {}
+
+    ~ScopedProbe()
+    {
+      // The handle of a cleared collector may be the one of another probe.
+      if (this->m_Collector.GetNumberOfClears() == this->m_NumberOfClears)
+      {
+        this->m_Collector.StopScope(this->m_Handle);
+      }
+    }
+
+    ScopedProbe(const ScopedProbe &) = delete;
+    ScopedProbe &
+    operator=(const ScopedProbe &) = delete;
+
+    /** Handle of the probe timing the scope. */
+    ProbeHandleType
+    GetProbeHandle() const
+    {
+      return this->m_Handle;
+    }
+
+  private:
+    LOCAL_ResourceProbesCollectorBase & m_Collector;
+    const ProbeHandleType               m_Handle;
+    const SizeValueType                 m_NumberOfClears;
+  };
+
+  /** constructor, takes the system information snapshot of the probes
+   *  before anything is timed. */
+  LOCAL_ResourceProbesCollectorBase();
 
   /** destructor */
   virtual ~LOCAL_ResourceProbesCollectorBase();
@@ -53,10 +154,48 @@ public:
   virtual void
   Stop(const char * name);
 
+  /** Returns the handle of the probe with a particular name. If the probe
+   * does not exist, it will be created. */
+  virtual ProbeHandleType
+  GetProbeHandle(const char * name);
+
+  /** Start the probe identified with a handle, without any lookup. */
+  virtual void
+  Start(ProbeHandleType handle);
+
+  /** Stop the probe identified with a handle, without any lookup. */
+  virtual void
+  Stop(ProbeHandleType handle);
+
+  /** Start the probe of a scope nested in the current scope, and make it the
+   *  current scope. Prefer a ScopedProbe, which calls StopScope(). */
+  virtual ProbeHandleType
+  StartScope(const char * name);
+
+  /** Stop the probe of the current scope, and return to its parent scope.
+   *  Throws an exception if handle is not the current scope, e.g. if it was
+   *  started before the collector was cleared. */
+  virtual void
+  StopScope(ProbeHandleType handle);
+
+  /** Returns the handle of the scope enclosing a probe, or NoParentHandle. */
+  ProbeHandleType
+  GetParentHandle(ProbeHandleType handle) const;
+
+  /** Returns the total of a probe minus the totals of the probes of the
+   *  scopes nested in it. */
+  ProbeValueType
+  GetExclusiveTotal(ProbeHandleType handle) const;
+
   /** Report the summary of results from all probes */
   virtual void
   Report(std::ostream & os = std::cout, bool printSystemInfo = true, bool printReportHead = true, bool useTabs = false);
 
+  /** Report the inclusive and exclusive totals of the probes as a tree of
+   *  nested scopes. */
+  virtual void
+  CallTreeReport(std::ostream & os = std::cout, bool useTabs = false);
+
   /** Report the summary of results from a specific probe */
   virtual void
   Report(const char *   name,
@@ -88,20 +227,136 @@ public:
   virtual void
   JSONReport(const char * name, std::ostream & os = std::cout);
 
+  /** Measure the cost of an empty Start()/Stop() pair over a number of
+   *  iterations with a probe configured as the probes of this collector.
+   *  This is done automatically when the first probe is created. */
+  virtual void
+  CalibrateOverhead(unsigned int iterations = 1000);
+
+  /** Returns the median cost of an empty Start()/Stop() pair, 0 before the
+   *  calibration. */
+  ProbeValueType
+  GetProbeOverhead() const
+  {
+    return this->m_ProbeOverhead;
+  }
+
+  /** Returns the minimum cost of an empty Start()/Stop() pair, 0 before the
+   *  calibration. */
+  ProbeValueType
+  GetMinimumProbeOverhead() const
+  {
+    return this->m_MinimumProbeOverhead;
+  }
+
+  /** Subtract the calibrated median overhead from the values measured by the
+   *  existing and future probes. Off by default. */
+  virtual void
+  SetSubtractOverhead(bool subtractOverhead);
+
+  /** Whether the calibrated overhead is subtracted from the measured values. */
+  bool
+  GetSubtractOverhead() const
+  {
+    return this->m_SubtractOverhead;
+  }
+
+  /** Exclude the warm-up iterations from the summary statistics of the
+   *  existing and future probes. On by default.
+   *  \sa LOCAL_ResourceProbe::SetExcludeWarmUp */
+  virtual void
+  SetExcludeWarmUp(bool excludeWarmUp);
+
+  /** Whether the warm-up iterations are excluded from the summary statistics. */
+  bool
+  GetExcludeWarmUp() const
+  {
+    return this->m_ExcludeWarmUp;
+  }
+
   /** Destroy the set of probes. New probes can be created after invoking this
     method. */
   virtual void
   Clear();
 
+  /** Returns the number of calls to Clear(), which invalidate the handles. */
+  SizeValueType
+  GetNumberOfClears() const
+  {
+    return this->m_NumberOfClears;
+  }
+
 
   /** Returns a named Probe. If the name does not exists an exception
    * is thrown. */
   const TProbe &
   GetProbe(const char * name) const;
 
+  /** Returns the probe identified with a handle. */
+  const TProbe &
+  GetProbe(ProbeHandleType handle) const;
+
 
 protected:
-  MapType m_Probes;
+  /** Configure a probe created by GetProbeHandle(), before it is started for
+   *  the first time. Nothing by default. */
+  virtual void
+  InitializeProbe(TProbe & probe);
+
+  /** Bring the probes up to date before they are reported. Nothing by
+   *  default. */
+  virtual void
+  PrepareReport();
+
+  /** Print the collector wide "name": value pairs of the JSON report, each
+   *  followed by a comma, before the probes. */
+  virtual void
+  PrintJSONCollectorInformation(std::ostream & os);
+
+  /** Handles of the probes, sorted by name for the reports. */
+  MapType m_ProbeHandles;
+  /** Probes indexed by their handle. */
+  ProbeContainerType m_Probes;
+
+  /** Parent handle of each probe, indexed by handle. */
+  std::vector<ProbeHandleType> m_ParentHandles;
+  /** Handles of the scopes being timed, the innermost last. */
+  std::vector<ProbeHandleType> m_ScopeStack;
+
+private:
+  /** Set the overhead correction of the probes from the calibration. */
+  void
+  UpdateOverheadCorrection(TProbe & probe) const;
+
+  /** Whether a probe was created in a nested scope. */
+  bool
+  HasNestedScopes() const;
+
+  /** Handles of the children of each probe, and of the roots last, sorted by
+   *  name. */
+  std::vector<std::vector<ProbeHandleType>>
+  GetCallTree() const;
+
+  void
+  PrintCallTreeNode(std::ostream &                                    os,
+                    const std::vector<std::vector<ProbeHandleType>> & callTree,
+                    ProbeHandleType                                   handle,
+                    unsigned int                                      depth,
+                    ProbeValueType                                    rootsTotal,
+                    bool                                              useTabs) const;
+
+  void
+  PrintJSONCallTreeNode(std::ostream &                                    os,
+                        const std::vector<std::vector<ProbeHandleType>> & callTree,
+                        ProbeHandleType                                   handle,
+                        unsigned int                                      depth) const;
+
+  ProbeValueType m_ProbeOverhead{};
+  ProbeValueType m_MinimumProbeOverhead{};
+  unsigned int   m_NumberOfOverheadIterations{ 0 };
+  bool           m_SubtractOverhead{ false };
+  bool           m_ExcludeWarmUp{ true };
+  SizeValueType  m_NumberOfClears{ 0 };
 };
 } // end namespace itk
 
@@ -18,11 +18,22 @@
 #ifndef itkLOCALResourceProbesCollectorBase_hxx
 #define itkLOCALResourceProbesCollectorBase_hxx
 
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <utility>
 
 namespace itk
 {
 
+template <typename TProbe>
+LOCAL_ResourceProbesCollectorBase<TProbe>::LOCAL_ResourceProbesCollectorBase()
+{
+  BenchmarkSystemInformation::GetInstance();
+}
+
+
 template <typename TProbe>
 LOCAL_ResourceProbesCollectorBase<TProbe>::~LOCAL_ResourceProbesCollectorBase() = default;
 
@@ -32,8 +43,7 @@ void
 LOCAL_ResourceProbesCollectorBase<TProbe>::Start(const char * id)
 {
   // if the probe does not exist yet, it is created.
-  this->m_Probes[id].SetNameOfProbe(id);
-  this->m_Probes[id].Start();
+  this->Start(this->GetProbeHandle(id));
 }
 
 
@@ -43,13 +53,225 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::Stop(const char * id)
 {
   IdType tid = id;
 
-  auto pos = this->m_Probes.find(tid);
-  if (pos == this->m_Probes.end())
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos == this->m_ProbeHandles.end())
   {
     itkGenericExceptionMacro(<< "The probe \"" << id << "\" does not exist. It can not be stopped.");
     return;
   }
-  pos->second.Stop();
+  this->Stop(pos->second);
+}
+
+
+template <typename TProbe>
+typename LOCAL_ResourceProbesCollectorBase<TProbe>::ProbeHandleType
+LOCAL_ResourceProbesCollectorBase<TProbe>::GetProbeHandle(const char * id)
+{
+  IdType tid = id;
+
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos != this->m_ProbeHandles.end())
+  {
+    return pos->second;
+  }
+
+  if (this->m_NumberOfOverheadIterations == 0)
+  {
+    this->CalibrateOverhead();
+  }
+
+  const auto handle = static_cast<ProbeHandleType>(this->m_Probes.size());
+  this->m_Probes.emplace_back();
+  this->m_Probes.back().SetNameOfProbe(id);
+  this->m_ParentHandles.push_back(NoParentHandle);
+  this->UpdateOverheadCorrection(this->m_Probes.back());
+  this->m_Probes.back().SetExcludeWarmUp(this->m_ExcludeWarmUp);
+  this->InitializeProbe(this->m_Probes.back());
+  this->m_ProbeHandles.emplace(std::move(tid), handle);
+  return handle;
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::InitializeProbe(TProbe &)
+{}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::Start(ProbeHandleType handle)
+{
+  itkAssertInDebugAndIgnoreInReleaseMacro(handle < this->m_Probes.size());
+  this->m_Probes[handle].Start();
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::Stop(ProbeHandleType handle)
+{
+  itkAssertInDebugAndIgnoreInReleaseMacro(handle < this->m_Probes.size());
+  this->m_Probes[handle].Stop();
+}
+
+
+template <typename TProbe>
+typename LOCAL_ResourceProbesCollectorBase<TProbe>::ProbeHandleType
+LOCAL_ResourceProbesCollectorBase<TProbe>::StartScope(const char * name)
+{
+  const ProbeHandleType parent = this->m_ScopeStack.empty() ? NoParentHandle : this->m_ScopeStack.back();
+
+  std::string path;
+  if (parent != NoParentHandle)
+  {
+    path = this->m_Probes[parent].GetNameOfProbe() + '/';
+  }
+  path += name;
+
+  const ProbeHandleType handle = this->GetProbeHandle(path.c_str());
+  this->m_ParentHandles[handle] = parent;
+  this->m_ScopeStack.push_back(handle);
+  this->Start(handle);
+  return handle;
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::StopScope(ProbeHandleType handle)
+{
+  if (this->m_ScopeStack.empty() || this->m_ScopeStack.back() != handle)
+  {
+    itkGenericExceptionMacro(<< "The probe handle " << handle << " is not the current scope. It can not be stopped.");
+  }
+  this->m_ScopeStack.pop_back();
+  this->Stop(handle);
+}
+
+
+template <typename TProbe>
+typename LOCAL_ResourceProbesCollectorBase<TProbe>::ProbeHandleType
+LOCAL_ResourceProbesCollectorBase<TProbe>::GetParentHandle(ProbeHandleType handle) const
+{
+  if (handle >= this->m_Probes.size())
+  {
+    itkGenericExceptionMacro(<< "The probe handle " << handle << " does not exist.");
+  }
+  return this->m_ParentHandles[handle];
+}
+
+
+template <typename TProbe>
+typename LOCAL_ResourceProbesCollectorBase<TProbe>::ProbeValueType
+LOCAL_ResourceProbesCollectorBase<TProbe>::GetExclusiveTotal(ProbeHandleType handle) const
+{
+  ProbeValueType nestedTotal{};
+  for (ProbeHandleType child = 0; child < this->m_ParentHandles.size(); ++child)
+  {
+    if (this->m_ParentHandles[child] == handle)
+    {
+      nestedTotal += this->m_Probes[child].GetTotal();
+    }
+  }
+  const ProbeValueType total = this->GetProbe(handle).GetTotal();
+  // Clamp the difference made by the clock resolution and the overhead.
+  return total > nestedTotal ? total - nestedTotal : ProbeValueType{};
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::CalibrateOverhead(unsigned int iterations)
+{
+  if (iterations == 0)
+  {
+    itkGenericExceptionMacro(<< "The overhead calibration requires at least one iteration.");
+  }
+
+  TProbe probe;
+  this->InitializeProbe(probe);
+
+  // Warm up the code paths and the caches before measuring.
+  for (unsigned int ii = 0; ii < 10; ++ii)
+  {
+    probe.Start();
+    probe.Stop();
+  }
+  probe.Reset();
+
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    probe.Start();
+    probe.Stop();
+  }
+
+  this->m_ProbeOverhead = probe.GetQuantile(0.5);
+  this->m_MinimumProbeOverhead = probe.GetMinimum();
+  this->m_NumberOfOverheadIterations = iterations;
+
+  for (auto & existingProbe : this->m_Probes)
+  {
+    this->UpdateOverheadCorrection(existingProbe);
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::SetSubtractOverhead(bool subtractOverhead)
+{
+  this->m_SubtractOverhead = subtractOverhead;
+  if (subtractOverhead && this->m_NumberOfOverheadIterations == 0)
+  {
+    this->CalibrateOverhead();
+  }
+  for (auto & probe : this->m_Probes)
+  {
+    this->UpdateOverheadCorrection(probe);
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::SetExcludeWarmUp(bool excludeWarmUp)
+{
+  this->m_ExcludeWarmUp = excludeWarmUp;
+  for (auto & probe : this->m_Probes)
+  {
+    probe.SetExcludeWarmUp(excludeWarmUp);
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::PrepareReport()
+{}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::PrintJSONCollectorInformation(std::ostream & os)
+{
+  if (this->m_NumberOfOverheadIterations > 0)
+  {
+    os << "  \"ProbeOverhead\": {\n";
+    os << "    \"Iterations\": " << this->m_NumberOfOverheadIterations << ",\n";
+    os << "    \"Median\": " << this->m_ProbeOverhead << ",\n";
+    os << "    \"Minimum\": " << this->m_MinimumProbeOverhead << ",\n";
+    os << "    \"Subtracted\": " << (this->m_SubtractOverhead ? "true" : "false") << '\n';
+    os << "  },\n";
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::UpdateOverheadCorrection(TProbe & probe) const
+{
+  probe.SetOverheadCorrection(this->m_SubtractOverhead ? this->m_ProbeOverhead : ProbeValueType{});
 }
 
 
@@ -59,12 +281,24 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::GetProbe(const char * id) const
 {
   IdType tid = id;
 
-  auto pos = this->m_Probes.find(tid);
-  if (pos == this->m_Probes.end())
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos == this->m_ProbeHandles.end())
   {
     itkGenericExceptionMacro(<< "The probe \"" << id << "\" does not exist.");
   }
-  return pos->second;
+  return this->m_Probes[pos->second];
+}
+
+
+template <typename TProbe>
+const TProbe &
+LOCAL_ResourceProbesCollectorBase<TProbe>::GetProbe(ProbeHandleType handle) const
+{
+  if (handle >= this->m_Probes.size())
+  {
+    itkGenericExceptionMacro(<< "The probe handle " << handle << " does not exist.");
+  }
+  return this->m_Probes[handle];
 }
 
 
@@ -75,8 +309,10 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::Report(std::ostream & os,
                                                   bool           printReportHead,
                                                   bool           useTabs)
 {
-  auto                             probe = this->m_Probes.begin();
-  typename MapType::const_iterator end = this->m_Probes.end();
+  this->PrepareReport();
+
+  auto                             probe = this->m_ProbeHandles.begin();
+  typename MapType::const_iterator end = this->m_ProbeHandles.end();
 
   if (probe == end)
   {
@@ -89,16 +325,165 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::Report(std::ostream & os,
   {
     if (firstProbe)
     {
-      probe->second.Report(os, printSystemInfo, printReportHead, useTabs);
+      this->m_Probes[probe->second].Report(os, printSystemInfo, printReportHead, useTabs);
       firstProbe = false;
     }
     else
     {
-      probe->second.Report(os, false, false, useTabs);
+      this->m_Probes[probe->second].Report(os, false, false, useTabs);
     }
 
     ++probe;
   }
+
+  if (this->HasNestedScopes())
+  {
+    os << std::endl;
+    this->CallTreeReport(os, useTabs);
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::CallTreeReport(std::ostream & os, bool useTabs)
+{
+  this->PrepareReport();
+
+  if (this->m_Probes.empty())
+  {
+    os << "No probes have been created" << std::endl;
+    return;
+  }
+
+  constexpr unsigned int tabwidth = 15;
+  const TProbe &         firstProbe = this->m_Probes.front();
+  const std::string      unit = std::string(" (") + firstProbe.GetUnit() + std::string(")");
+  std::stringstream      ss;
+  if (useTabs)
+  {
+    ss << std::left << '\t' << "Call Tree (" << firstProbe.GetType() << ')' << std::left << '\t' << "Iterations"
+       << std::left << '\t' << "Inclusive" << unit << std::left << '\t' << "Exclusive" << unit << std::left << '\t'
+       << "Exclusive (%)";
+  }
+  else
+  {
+    ss << std::left << std::setw(tabwidth * 2) << std::string("Call Tree (") + firstProbe.GetType() + std::string(")")
+       << std::left << std::setw(tabwidth) << "Iterations" << std::left << std::setw(tabwidth)
+       << std::string("Inclusive") + unit << std::left << std::setw(tabwidth) << std::string("Exclusive") + unit
+       << std::left << std::setw(tabwidth) << "Exclusive (%)";
+  }
+  os << ss.str() << std::endl;
+
+  // The roots account for all the measured time.
+  const std::vector<std::vector<ProbeHandleType>> callTree = this->GetCallTree();
+  ProbeValueType                                  rootsTotal{};
+  for (const ProbeHandleType root : callTree.back())
+  {
+    rootsTotal += this->m_Probes[root].GetTotal();
+  }
+  for (const ProbeHandleType root : callTree.back())
+  {
+    this->PrintCallTreeNode(os, callTree, root, 0, rootsTotal, useTabs);
+  }
+}
+
+
+template <typename TProbe>
+bool
+LOCAL_ResourceProbesCollectorBase<TProbe>::HasNestedScopes() const
+{
+  return std::any_of(this->m_ParentHandles.begin(), this->m_ParentHandles.end(), [](ProbeHandleType parent) {
+    return parent != NoParentHandle;
+  });
+}
+
+
+template <typename TProbe>
+std::vector<std::vector<typename LOCAL_ResourceProbesCollectorBase<TProbe>::ProbeHandleType>>
+LOCAL_ResourceProbesCollectorBase<TProbe>::GetCallTree() const
+{
+  std::vector<std::vector<ProbeHandleType>> callTree(this->m_Probes.size() + 1);
+  for (const auto & probe : this->m_ProbeHandles)
+  {
+    const ProbeHandleType parent = this->m_ParentHandles[probe.second];
+    callTree[parent == NoParentHandle ? this->m_Probes.size() : parent].push_back(probe.second);
+  }
+  return callTree;
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::PrintCallTreeNode(
+  std::ostream &                                    os,
+  const std::vector<std::vector<ProbeHandleType>> & callTree,
+  ProbeHandleType                                   handle,
+  unsigned int                                      depth,
+  ProbeValueType                                    rootsTotal,
+  bool                                              useTabs) const
+{
+  constexpr unsigned int tabwidth = 15;
+
+  const TProbe &       probe = this->m_Probes[handle];
+  const std::string    fullName = probe.GetNameOfProbe();
+  const std::string    name = std::string(2 * depth, ' ') + fullName.substr(fullName.rfind('/') + 1);
+  const ProbeValueType exclusiveTotal = this->GetExclusiveTotal(handle);
+  const double         exclusivePercent =
+    rootsTotal > ProbeValueType{} ? 100.0 * static_cast<double>(exclusiveTotal) / static_cast<double>(rootsTotal) : 0.0;
+
+  std::stringstream ss;
+  if (useTabs)
+  {
+    ss << std::left << '\t' << name << std::left << '\t' << probe.GetNumberOfIteration() << std::left << '\t'
+       << probe.GetTotal() << std::left << '\t' << exclusiveTotal << std::left << '\t' << exclusivePercent;
+  }
+  else
+  {
+    ss << std::left << std::setw(tabwidth * 2) << name << std::left << std::setw(tabwidth)
+       << probe.GetNumberOfIteration() << std::left << std::setw(tabwidth) << probe.GetTotal() << std::left
+       << std::setw(tabwidth) << exclusiveTotal << std::left << std::setw(tabwidth) << exclusivePercent;
+  }
+  os << ss.str() << std::endl;
+
+  for (const ProbeHandleType child : callTree[handle])
+  {
+    this->PrintCallTreeNode(os, callTree, child, depth + 1, rootsTotal, useTabs);
+  }
+}
+
+
+template <typename TProbe>
+void
+LOCAL_ResourceProbesCollectorBase<TProbe>::PrintJSONCallTreeNode(
+  std::ostream &                                    os,
+  const std::vector<std::vector<ProbeHandleType>> & callTree,
+  ProbeHandleType                                   handle,
+  unsigned int                                      depth) const
+{
+  const std::string indent(4 + 4 * depth, ' ');
+  const TProbe &    probe = this->m_Probes[handle];
+  const std::string fullName = probe.GetNameOfProbe();
+
+  os << indent << "{\n";
+  os << indent << "  \"Name\": \"" << fullName.substr(fullName.rfind('/') + 1) << "\",\n";
+  os << indent << "  \"Path\": \"" << fullName << "\",\n";
+  os << indent << "  \"Iterations\": " << probe.GetNumberOfIteration() << ",\n";
+  os << indent << "  \"InclusiveTotal\": " << probe.GetTotal() << ",\n";
+  os << indent << "  \"ExclusiveTotal\": " << this->GetExclusiveTotal(handle) << ",\n";
+  os << indent << "  \"Children\": [";
+  const std::vector<ProbeHandleType> & children = callTree[handle];
+  for (size_t ii = 0; ii < children.size(); ++ii)
+  {
+    os << (ii > 0 ? ",\n" : "\n");
+    this->PrintJSONCallTreeNode(os, callTree, children[ii], depth + 1);
+  }
+  if (!children.empty())
+  {
+    os << '\n' << indent << "  ";
+  }
+  os << "]\n";
+  os << indent << '}';
 }
 
 
@@ -110,16 +495,18 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::Report(const char *   name,
                                                   bool           printReportHead,
                                                   bool           useTabs)
 {
+  this->PrepareReport();
+
   const IdType tid = name;
 
-  auto pos = this->m_Probes.find(tid);
-  if (pos == this->m_Probes.end())
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos == this->m_ProbeHandles.end())
   {
     os << "The probe \"" << name << "\" does not exist. It's report is not available" << std::endl;
     return;
   }
 
-  pos->second.Report(os, printSystemInfo, printReportHead, useTabs);
+  this->m_Probes[pos->second].Report(os, printSystemInfo, printReportHead, useTabs);
 }
 
 
@@ -130,8 +517,10 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::ExpandedReport(std::ostream & os,
                                                           bool           printReportHead,
                                                           bool           useTabs)
 {
-  auto                             probe = this->m_Probes.begin();
-  typename MapType::const_iterator end = this->m_Probes.end();
+  this->PrepareReport();
+
+  auto                             probe = this->m_ProbeHandles.begin();
+  typename MapType::const_iterator end = this->m_ProbeHandles.end();
 
   if (probe == end)
   {
@@ -144,16 +533,22 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::ExpandedReport(std::ostream & os,
   {
     if (firstProbe)
     {
-      probe->second.ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
+      this->m_Probes[probe->second].ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
       firstProbe = false;
     }
     else
     {
-      probe->second.ExpandedReport(os, false, false, useTabs);
+      this->m_Probes[probe->second].ExpandedReport(os, false, false, useTabs);
     }
 
     ++probe;
   }
+
+  if (this->HasNestedScopes())
+  {
+    os << std::endl;
+    this->CallTreeReport(os, useTabs);
+  }
 }
 
 
@@ -165,16 +560,18 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::ExpandedReport(const char *   name,
                                                           bool           printReportHead,
                                                           bool           useTabs)
 {
+  this->PrepareReport();
+
   const IdType tid = name;
 
-  auto pos = this->m_Probes.find(tid);
-  if (pos == this->m_Probes.end())
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos == this->m_ProbeHandles.end())
   {
     os << "The probe \"" << name << "\" does not exist. It's report is not available" << std::endl;
     return;
   }
 
-  pos->second.ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
+  this->m_Probes[pos->second].ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
 }
 
 
@@ -182,8 +579,10 @@ template <typename TProbe>
 void
 LOCAL_ResourceProbesCollectorBase<TProbe>::JSONReport(std::ostream & os, bool printSystemInfo)
 {
-  auto                             probe = this->m_Probes.begin();
-  typename MapType::const_iterator end = this->m_Probes.end();
+  this->PrepareReport();
+
+  auto                             probe = this->m_ProbeHandles.begin();
+  typename MapType::const_iterator end = this->m_ProbeHandles.end();
 
   if (probe == end)
   {
@@ -195,27 +594,40 @@ LOCAL_ResourceProbesCollectorBase<TProbe>::JSONReport(std::ostream & os, bool pr
   if (printSystemInfo)
   {
     os << "  \"SystemInformation\": ";
-    probe->second.PrintJSONSystemInformation(os);
+    this->m_Probes[probe->second].PrintJSONSystemInformation(os);
     os << ",\n";
   }
+  this->PrintJSONCollectorInformation(os);
   os << "  \"Probes\": [\n";
   bool firstProbe = true;
   while (probe != end)
   {
     if (firstProbe)
     {
-      probe->second.JSONReport(os);
+      this->m_Probes[probe->second].JSONReport(os);
       firstProbe = false;
     }
     else
     {
       os << ",\n";
-      probe->second.JSONReport(os);
+      this->m_Probes[probe->second].JSONReport(os);
     }
 
     ++probe;
   }
-  os << "\n  ]\n}" << std::endl;
+  os << "\n  ]";
+  if (this->HasNestedScopes())
+  {
+    os << ",\n  \"CallTree\": [";
+    const std::vector<std::vector<ProbeHandleType>> callTree = this->GetCallTree();
+    for (size_t ii = 0; ii < callTree.back().size(); ++ii)
+    {
+      os << (ii > 0 ? ",\n" : "\n");
+      this->PrintJSONCallTreeNode(os, callTree, callTree.back()[ii], 0);
+    }
+    os << "\n  ]";
+  }
+  os << "\n}" << std::endl;
 }
 
 
@@ -223,23 +635,29 @@ template <typename TProbe>
 void
 LOCAL_ResourceProbesCollectorBase<TProbe>::JSONReport(const char * name, std::ostream & os)
 {
+  this->PrepareReport();
+
   const IdType tid = name;
 
-  auto pos = this->m_Probes.find(tid);
-  if (pos == this->m_Probes.end())
+  auto pos = this->m_ProbeHandles.find(tid);
+  if (pos == this->m_ProbeHandles.end())
   {
     os << R"(  { "ProbeName": ")" << name << R"(", "Status": "Does not exist!" })" << std::endl;
     return;
   }
 
-  pos->second.JSONReport(os);
+  this->m_Probes[pos->second].JSONReport(os);
 }
 
 template <typename TProbe>
 void
 LOCAL_ResourceProbesCollectorBase<TProbe>::Clear()
 {
+  this->m_ProbeHandles.clear();
   this->m_Probes.clear();
+  this->m_ParentHandles.clear();
+  this->m_ScopeStack.clear();
+  ++this->m_NumberOfClears;
 }
 
 
@@ -10,6 +10,15 @@
 #include "jsonxx.h"
 #include <ctime> //TODO:  Move to utiliites
 #include "itkHighPriorityRealTimeProbesCollector.h"
+#include "itkBenchmarkCacheEvictor.h"
+#include "itkBenchmarkLoopDriver.h"
+#include "itkBenchmarkVariantScheduler.h"
+#include "itkSize.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 #if ITK_VERSION_MAJOR < 5 || defined(ITK_USES_NUMBEROFTHREADS)
 #  include "itkMultiThreader.h"
@@ -36,4 +45,226 @@ WriteExpandedReport(const std::string &                        timingsFileName,
                     bool                                       printSystemInfo,
                     bool                                       printReportHead,
                     bool                                       useTabs);
+
+/** Runs the pre-flight noise check selected by ITKPERFORMANCEBENCHMARK_PREFLIGHT:
+ * - Warn (the default): measure the noise floor of the machine and print
+ *   why it is too noisy.
+ * - Wait: measure it again every second until the machine is quiet, for up to
+ *   ITKPERFORMANCEBENCHMARK_PREFLIGHT_TIMEOUT seconds (60 by default), then warn.
+ * - Refuse: return false when the machine is too noisy.
+ * - Off: do nothing.
+ * The machine is too noisy when its noise floor exceeds
+ * ITKPERFORMANCEBENCHMARK_NOISE_THRESHOLD (0.02 by default, i.e. 2%), when it
+ * is loaded, or when its CPUs are throttled. The measurement is added to the
+ * JSON reports as "NoiseFloor". */
+PerformanceBenchmarking_EXPORT bool
+RunBenchmarkPreflight();
+
+/** The command line options shared by the benchmarks, see
+ * ParseBenchmarkOptions(). */
+struct BenchmarkOptions
+{
+  enum class FormatEnum : uint8_t
+  {
+    /** The JSON report, with the system and build information. */
+    JSON,
+    /** The tab separated expanded report of the probes. */
+    Text
+  };
+  using ClockSourceEnum = itk::BenchmarkClockSource::ClockSourceEnum;
+
+  /** The file of the timings, with __DATESTAMP__ replaced. */
+  std::string                        m_TimingsFileName;
+  int                                m_Iterations{ 1 };
+  /** The ITK default number of threads when not positive. */
+  int                                m_Threads{ -1 };
+  /** Seconds each benchmark loop runs at least, none when 0. */
+  double                             m_MinimumTime{ 0.0 };
+  /** Untimed runs before the timed ones. */
+  int                                m_WarmUpIterations{ 0 };
+  ClockSourceEnum                    m_ClockSource{ ClockSourceEnum::RealTimeClock };
+  /** A thread placement policy or a CPU list, as given. */
+  std::string                        m_Pin;
+  FormatEnum                         m_Format{ FormatEnum::JSON };
+  /** The size of the inputs, generated or resampled, empty when not given. */
+  std::vector<unsigned int>          m_Size;
+  /** The other positional arguments, by name. */
+  std::map<std::string, std::string> m_Arguments;
+  /** The arguments left after the positional ones, with "...". */
+  std::vector<std::string>           m_RemainingArguments;
+};
+
+/** Parses the command line of a benchmark with itksys::CommandLineArguments:
+ *
+ *   --iterations n   the number of iterations, the minimum of the loops
+ *   --threads n      the number of threads, the ITK default when not positive
+ *   --min-time s     the seconds each benchmark loop runs at least
+ *   --warmup n       the untimed runs before the timed ones
+ *   --clock name     RealTimeClock, Monotonic, MonotonicRaw or InvariantTSC
+ *   --pin policy     a thread placement policy, e.g. Compact, or a CPU list
+ *   --format name    JSON or Text
+ *   --size n[,n...]  the size of the inputs, e.g. 128 or 64,64,32
+ *
+ * ITKPERFORMANCEBENCHMARK_SIZE, e.g. set by a size sweep, overrides --size.
+ *
+ * The legacy positional form is still accepted: the positional arguments
+ * fill the slots of positionalNames in order, skipping the slots given as
+ * options. The timingsFile, iterations, threads and size slots set the
+ * options, the others are stored in m_Arguments. A name in brackets is
+ * optional and keeps the value set in options before the call, and "..."
+ * keeps the remaining arguments, for a benchmark that parses its own.
+ *
+ * Returns false, after printing the usage, when the command line is not
+ * valid. Otherwise, the options become the ones of GetBenchmarkOptions(),
+ * and the pinning is applied to the BenchmarkExecutionContext. */
+PerformanceBenchmarking_EXPORT bool
+ParseBenchmarkOptions(int                              argc,
+                      char *                           argv[],
+                      const std::vector<std::string> & positionalNames,
+                      BenchmarkOptions &               options);
+
+/** The options of the benchmark being run, the defaults until
+ * ParseBenchmarkOptions() succeeds. */
+PerformanceBenchmarking_EXPORT const BenchmarkOptions &
+GetBenchmarkOptions();
+
+/** The --size of the options as the size of an image: one extent for all
+ * the dimensions, or one per dimension. Returns false otherwise. */
+template <unsigned int VDimension>
+bool
+GetBenchmarkImageSize(const BenchmarkOptions & options, itk::Size<VDimension> & size)
+{
+  const std::vector<unsigned int> & extents = options.m_Size;
+  if (extents.size() != 1 && extents.size() != VDimension)
+  {
+    return false;
+  }
+  for (unsigned int dimension = 0; dimension < VDimension; ++dimension)
+  {
+    size[dimension] = extents[extents.size() == 1 ? 0 : dimension];
+  }
+  return true;
+}
+
+/** Selects the clock of the options for the probes of a collector. Called
+ * by TimeIterations() and TimeVariants(), and by the benchmarks that run
+ * their own loops before they time anything. */
+PerformanceBenchmarking_EXPORT void
+SetUpBenchmarkCollector(itk::HighPriorityRealTimeProbesCollector & collector);
+
+/** The JSON report of the probes, as printed by JSONReport(), of the last
+ * WriteExpandedReport() of the process, whatever the --format of the
+ * options. Empty before the first report. */
+PerformanceBenchmarking_EXPORT const std::string &
+GetLastBenchmarkReport();
+
+/** Prepares the process for a benchmark: sets the number of threads when
+ * threads is positive, or to ITKPERFORMANCEBENCHMARK_THREADS when it is set,
+ * e.g. by a thread scaling sweep, starts the workers of the ITK thread pool,
+ * so that they exist when the first probe places the threads according to
+ * the ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT policy, and runs the
+ * pre-flight noise check. To be called before anything is timed. Returns
+ * false when the benchmark should not run. */
+PerformanceBenchmarking_EXPORT bool
+SetUpBenchmarkEnvironment(int threads);
+
+/** Creates the driver of a benchmark loop: it runs at least
+ * ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS, iterations by default, and stops
+ * when the relative half-width of the 95% confidence interval of the mean is
+ * at most ITKPERFORMANCEBENCHMARK_TARGET_CI, e.g. 0.01, when
+ * ITKPERFORMANCEBENCHMARK_TIME_BUDGET seconds are spent, or after
+ * ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS, iterations by default, or 1000 with
+ * a target or a budget. The loop also runs for the --min-time of the
+ * options, see ParseBenchmarkOptions(). */
+PerformanceBenchmarking_EXPORT itk::BenchmarkLoopDriver
+                               CreateBenchmarkLoopDriver(int iterations);
+
+/** Adds the iterations and the stopping reason of the loop of a probe to the
+ * JSON reports, as "IterationControl". */
+PerformanceBenchmarking_EXPORT void
+AddIterationControlToReport(const std::string & probeName, const itk::BenchmarkLoopDriver & driver);
+
+/** The work of one iteration of a benchmark: the voxels it processes and
+ * the bytes it reads and writes, 0 when unknown. The probes report the
+ * throughput of the iterations from it, see
+ * HighPriorityRealTimeProbe::SetWorkload(). */
+struct BenchmarkWorkload
+{
+  itk::SizeValueType m_Voxels{ 0 };
+  itk::SizeValueType m_Bytes{ 0 };
+};
+
+/** The workload of an image filter that reads each pixel of its inputs once,
+ * and writes an output of TOutputImage the size of the first input. */
+template <typename TOutputImage, typename... TInputImages>
+BenchmarkWorkload
+GetImageFilterWorkload(const TInputImages *... inputs)
+{
+  const itk::SizeValueType inputBytes[] = { inputs->GetPixelContainer()->Size() *
+                                            sizeof(*inputs->GetBufferPointer())... };
+  const itk::SizeValueType voxels[] = { inputs->GetLargestPossibleRegion().GetNumberOfPixels()... };
+
+  BenchmarkWorkload workload;
+  workload.m_Voxels = voxels[0];
+  workload.m_Bytes = voxels[0] * sizeof(typename TOutputImage::PixelType);
+  for (const itk::SizeValueType bytes : inputBytes)
+  {
+    workload.m_Bytes += bytes;
+  }
+  return workload;
+}
+
+/** Times runs of a benchmark under the probe probeName: prepare() is called
+ * before each run, untimed, and run() is timed with the --clock of the
+ * options, after their --warmup runs, which are not timed. The number of
+ * runs is decided by the driver of CreateBenchmarkLoopDriver(iterations),
+ * and is reported with AddIterationControlToReport(). The cache mode is
+ * selected by ITKPERFORMANCEBENCHMARK_CACHE_MODE:
+ * - Warm (the default): each run finds the data of the previous one in the
+ *   caches.
+ * - Cold: the caches are evicted before each run, and the inputs are flushed
+ *   from them, see BenchmarkCacheEvictor. The runs are timed under the probe
+ *   probeName + " (cold)". With ITKPERFORMANCEBENCHMARK_PAGE_OUT set, the pages
+ *   of the inputs are also reclaimed.
+ * - Both: a warm and a cold run in turn, so that both are timed under the
+ *   same conditions and reported side by side.
+ * The probes report the throughput of the workload of an iteration. */
+PerformanceBenchmarking_EXPORT void
+TimeIterations(itk::HighPriorityRealTimeProbesCollector &                       collector,
+               const std::string &                                              probeName,
+               int                                                              iterations,
+               const std::function<void()> &                                    prepare,
+               const std::function<void()> &                                    run,
+               const std::vector<itk::BenchmarkCacheEvictor::MemoryRangeType> & inputs = {},
+               const BenchmarkWorkload &                                        workload = {});
+
+/** A variant of a benchmark: the name of its probe, and the work it times. */
+using BenchmarkVariantType = std::pair<std::string, std::function<void()>>;
+
+/** Times variants of a benchmark, e.g. implementations of the same
+ * operation, under the probes of their names. Each variant first runs once,
+ * or for the --warmup runs of the options, untimed, then the variants run
+ * in blocks of one iteration each, in a new random order per block, see
+ * BenchmarkVariantScheduler, so that drift
+ * affects them alike. The number of blocks is decided by the driver of
+ * CreateBenchmarkLoopDriver(iterations), from the total time of each block,
+ * and is reported with AddIterationControlToReport() under comparisonName.
+ * The time of each variant relative to the first one, paired block by
+ * block, is added to the JSON reports as "VariantComparison". The order is
+ * seeded by ITKPERFORMANCEBENCHMARK_VARIANT_SEED, 0 by default. The probes
+ * report the throughput of the workload of an iteration of each variant. */
+PerformanceBenchmarking_EXPORT void
+TimeVariants(itk::HighPriorityRealTimeProbesCollector & collector,
+             const std::string &                        comparisonName,
+             const std::vector<BenchmarkVariantType> &  variants,
+             int                                        iterations,
+             const BenchmarkWorkload &                  workload = {});
+
+/** The memory range of the pixels of an image, an input of TimeIterations(). */
+template <typename TImage>
+itk::BenchmarkCacheEvictor::MemoryRangeType
+GetImageMemoryRange(const TImage * image)
+{
+  return { image->GetBufferPointer(), image->GetPixelContainer()->Size() * sizeof(*image->GetBufferPointer()) };
+}
 #endif
@@ -0,0 +1,97 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkCacheEvictor_h
+#define itkBenchmarkCacheEvictor_h
+
+#include "PerformanceBenchmarkingExport.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkCacheEvictor
+ * \brief Evicts the data of a benchmark from the CPU caches.
+ *
+ * A benchmark that runs a filter repeatedly on the same input times it with
+ * the input in the caches, while in production every input arrives cold.
+ * Evict() is called between the iterations to time them cold:
+ * - it writes to and reads from every cache line of a buffer several times
+ *   larger than the last level cache, which evicts whatever the calling
+ *   thread left in its caches, such as the output and the internal buffers
+ *   of the filter.
+ * - it flushes the given memory ranges, typically the input images, from
+ *   the caches of all the CPUs with clflush on x86, since the threads of a
+ *   filter may have read them from other last level caches.
+ * - with page out enabled, it also asks the kernel to reclaim the pages of
+ *   the ranges with madvise(MADV_PAGEOUT), so that they are faulted in
+ *   again, as a freshly read input would be. It requires swap for anonymous
+ *   memory, and Linux 5.4.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkCacheEvictor
+{
+public:
+  /** The start and the size in bytes of a memory range. */
+  using MemoryRangeType = std::pair<const void *, size_t>;
+
+  /** The buffer is bufferSize bytes, or four times the size of the last
+   * level cache, and at least 32 MiB, when bufferSize is 0. */
+  explicit BenchmarkCacheEvictor(size_t bufferSize = 0);
+
+  /** Evicts the caches, and flushes the given ranges from them. */
+  void
+  Evict(const std::vector<MemoryRangeType> & ranges = {});
+
+  /** Whether Evict() also reclaims the pages of the ranges. */
+  void
+  SetPageOut(bool pageOut)
+  {
+    this->m_PageOut = pageOut;
+  }
+
+  bool
+  GetPageOut() const
+  {
+    return this->m_PageOut;
+  }
+
+  size_t
+  GetBufferSize() const
+  {
+    return this->m_Buffer.size();
+  }
+
+  /** Whether memory ranges can be flushed from the caches of all the CPUs. */
+  static bool
+  IsFlushAvailable();
+
+  /** Whether the pages of memory ranges can be reclaimed. */
+  static bool
+  IsPageOutAvailable();
+
+private:
+  std::vector<unsigned char> m_Buffer;
+  size_t                     m_LineSize{ 64 };
+  bool                       m_PageOut{ false };
+};
+} // end namespace itk
+
+#endif // itkBenchmarkCacheEvictor_h
@@ -0,0 +1,119 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkClockSource_h
+#define itkBenchmarkClockSource_h
+
+#include "itkRealTimeClock.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace itk
+{
+/** \class BenchmarkClockSource
+ * \brief Reads the time from a selectable high resolution clock.
+ *
+ * The RealTimeClock reports wall-clock time, which may be slewed or stepped
+ * by NTP and is comparatively costly to read. A BenchmarkClockSource reads
+ * one of the following clocks instead:
+ *
+ * - RealTimeClock: the given itk::RealTimeClock (the historical behavior).
+ * - Monotonic: CLOCK_MONOTONIC, or std::chrono::steady_clock where it is not
+ *   available.
+ * - MonotonicRaw: CLOCK_MONOTONIC_RAW, which is not adjusted by NTP.
+ * - InvariantTSC: the x86 time stamp counter read with rdtscp between load
+ *   fences, converted to seconds with a frequency calibrated once per process
+ *   against MonotonicRaw.
+ *
+ * A clock that is not available on the running system falls back to
+ * MonotonicRaw, or to Monotonic; GetClockSource() returns the clock in use.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkClockSource
+{
+public:
+  using TimeStampType = RealTimeClock::TimeStampType;
+
+  enum class ClockSourceEnum : uint8_t
+  {
+    RealTimeClock,
+    Monotonic,
+    MonotonicRaw,
+    InvariantTSC
+  };
+
+  /** The realTimeClock is only read for ClockSourceEnum::RealTimeClock; it
+   * must outlive this object. */
+  explicit BenchmarkClockSource(ClockSourceEnum clockSource = ClockSourceEnum::RealTimeClock,
+                                const RealTimeClock * realTimeClock = nullptr);
+
+  /** Returns the current time in seconds, from an arbitrary origin. */
+  TimeStampType
+  GetTimeInSeconds() const;
+
+  /** Returns the clock actually read, after falling back from an unavailable one. */
+  ClockSourceEnum
+  GetClockSource() const
+  {
+    return this->m_ClockSource;
+  }
+
+  /** Returns the clock that was requested. */
+  ClockSourceEnum
+  GetRequestedClockSource() const
+  {
+    return this->m_RequestedClockSource;
+  }
+
+  /** Returns the resolution of the clock in use, in seconds. */
+  TimeStampType
+  GetResolution() const;
+
+  /** Whether a clock can be read on the running system. */
+  static bool
+  IsAvailable(ClockSourceEnum clockSource);
+
+  /** Frequency of the invariant time stamp counter in Hz, calibrated on the
+   * first call. Returns 0 when the counter is not available. */
+  static double
+  GetInvariantTSCFrequency();
+
+  /** Name of a clock, as printed in the reports. */
+  static const char *
+  ToString(ClockSourceEnum clockSource);
+
+  /** Parses a clock name (case insensitive, "tsc" is accepted for
+   * InvariantTSC). Returns false if the name is not recognized. */
+  static bool
+  FromString(const std::string & name, ClockSourceEnum & clockSource);
+
+private:
+  ClockSourceEnum       m_RequestedClockSource;
+  ClockSourceEnum       m_ClockSource;
+  const RealTimeClock * m_RealTimeClock;
+};
+
+/** Prints the name of a clock. */
+extern PerformanceBenchmarking_EXPORT std::ostream &
+                                      operator<<(std::ostream & out, const BenchmarkClockSource::ClockSourceEnum value);
+} // end namespace itk
+
+#endif // itkBenchmarkClockSource_h
@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkExecutionContext_h
+#define itkBenchmarkExecutionContext_h
+
+#include "itkBenchmarkThreadPlacement.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkExecutionContext
+ * \brief Process wide scheduling and memory settings of the benchmarks.
+ *
+ * The context is reference counted: the first Acquire() applies the
+ * settings to the process, and the last Release() restores what they
+ * replaced. Every HighPriorityRealTimeClock holds the context while it
+ * exists, so that the settings are applied once however many probes are
+ * created, and are not undone by the destruction of one of them.
+ *
+ * The settings are:
+ * - the scheduling policy: a raised priority (the lowest nice value on
+ *   POSIX systems, the high priority class and a time critical thread
+ *   priority on Windows), SCHED_FIFO or SCHED_RR with a real-time priority,
+ *   or None. A real-time policy that is not permitted falls back to the
+ *   raised priority, and a priority that is not permitted is left as is.
+ * - the CPUs the threads may run on.
+ * - the placement of the threads on these CPUs: the calling thread may run
+ *   on all the CPUs of a BenchmarkThreadPlacement policy, and each other
+ *   thread is pinned to one of them, in the order of the policy and in the
+ *   order the threads were created, so that the workers of the ITK thread
+ *   pool are placed by the policy. The threads created afterwards are not
+ *   placed until Reapply() is called: SetUpBenchmarkEnvironment() creates
+ *   the workers of the pool first, and places them again when their number
+ *   changes.
+ * - locking the pages of the process in memory with mlockall(), to avoid
+ *   page faults in the timed code.
+ * - disabling the transparent huge pages of the process.
+ *
+ * The scheduling policy and the CPUs are applied to all the threads of
+ * the process on Linux, and to the calling thread elsewhere; the threads
+ * created afterwards inherit them. The default settings are read from the
+ * ITKPERFORMANCEBENCHMARK_SCHEDULING (Nice, FIFO, RR or None),
+ * ITKPERFORMANCEBENCHMARK_CPU_AFFINITY (a CPU list such as "0-3,8"),
+ * ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT (None, Compact, ScatterCores,
+ * ScatterCaches or SMTSiblings),
+ * ITKPERFORMANCEBENCHMARK_LOCK_MEMORY and
+ * ITKPERFORMANCEBENCHMARK_DISABLE_THP environment variables.
+ *
+ * What was actually applied, and why the rest was not, is returned by
+ * GetAppliedSettings() and printed in the JSON reports.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkExecutionContext
+{
+public:
+  using ThreadPlacementEnum = BenchmarkThreadPlacement::ThreadPlacementEnum;
+
+  enum class SchedulingPolicyEnum : uint8_t
+  {
+    None,
+    Nice,
+    FIFO,
+    RoundRobin
+  };
+
+  /** Requested settings. */
+  struct Settings
+  {
+    SchedulingPolicyEnum      m_SchedulingPolicy{ SchedulingPolicyEnum::Nice };
+    /** Priority of SCHED_FIFO and SCHED_RR, from 1 to 99. */
+    int                       m_RealTimePriority{ 1 };
+    /** CPUs the threads may run on, all of them when empty. */
+    std::vector<unsigned int> m_CPUAffinity;
+    /** Pins each thread but the calling one to one of these CPUs, or to one
+     * of the CPUs the process may run on when there are none. */
+    ThreadPlacementEnum       m_ThreadPlacement{ ThreadPlacementEnum::None };
+    bool                      m_LockMemory{ false };
+    bool                      m_DisableTransparentHugePages{ false };
+  };
+
+  /** Settings in effect while the context is acquired. */
+  struct AppliedSettings
+  {
+    SchedulingPolicyEnum      m_SchedulingPolicy{ SchedulingPolicyEnum::None };
+    /** The nice value, or the real-time priority. */
+    int                       m_Priority{ 0 };
+    std::vector<unsigned int> m_CPUAffinity;
+    ThreadPlacementEnum       m_ThreadPlacement{ ThreadPlacementEnum::None };
+    /** The CPU each thread but the calling one is pinned to, in the order
+     * the threads were created. */
+    std::vector<unsigned int> m_ThreadCPUs;
+    bool                      m_MemoryLocked{ false };
+    bool                      m_TransparentHugePagesDisabled{ false };
+    /** Why the settings that were requested are not all applied. */
+    std::vector<std::string>  m_Messages;
+  };
+
+  /** RAII holder of the context. */
+  class Guard
+  {
+  public:
+    Guard() { BenchmarkExecutionContext::Acquire(); }
+    ~Guard() { BenchmarkExecutionContext::Release(); }
+    Guard(const Guard &) = delete;
+    Guard &
+    operator=(const Guard &) = delete;
+  };
+
+  /** Apply the settings if the context is not held yet, and hold it. */
+  static void
+  Acquire();
+
+  /** Release the context, and restore the process when it is no longer
+   * held. */
+  static void
+  Release();
+
+  /** Apply the settings again if the context is held, e.g. to place the
+   * threads created since it was acquired. */
+  static void
+  Reapply();
+
+  /** Whether the context is held. */
+  static bool
+  IsActive();
+
+  /** Change the settings. They are applied again if the context is held. */
+  static void
+  SetSettings(const Settings & settings);
+
+  /** Returns the requested settings, read from the environment until
+   * SetSettings() is called. */
+  static Settings
+  GetSettings();
+
+  /** Returns the default settings, read from the environment. */
+  static Settings
+  GetEnvironmentSettings();
+
+  /** Returns the settings applied by the last Acquire() that was not
+   * nested. */
+  static AppliedSettings
+  GetAppliedSettings();
+
+  /** Print the applied settings as a JSON object. */
+  static void
+  PrintJSON(std::ostream & os);
+
+  /** Name of a scheduling policy, as printed in the reports. */
+  static const char *
+  ToString(SchedulingPolicyEnum policy);
+
+  /** Parses a scheduling policy name, case insensitive ("RR" is accepted
+   * for RoundRobin). Returns false if the name is not recognized. */
+  static bool
+  FromString(const std::string & name, SchedulingPolicyEnum & policy);
+};
+
+/** Prints the name of a scheduling policy. */
+extern PerformanceBenchmarking_EXPORT std::ostream &
+operator<<(std::ostream & out, const BenchmarkExecutionContext::SchedulingPolicyEnum value);
+} // end namespace itk
+
+#endif // itkBenchmarkExecutionContext_h
@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkLoopDriver_h
+#define itkBenchmarkLoopDriver_h
+
+#include "itkBenchmarkClockSource.h"
+#include "itkIntTypes.h"
+#include "itkRealTimeClock.h"
+#include "itkProbeRunningStatistics.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <iostream>
+
+namespace itk
+{
+/** \class BenchmarkLoopDriver
+ * \brief Decides how many iterations a benchmark runs.
+ *
+ * A fixed number of iterations either gives meaningless error bars, when
+ * it is small, or wastes time on stable timings, when it is large. The
+ * driver runs at least the minimum number of iterations, then stops at the
+ * first of:
+ * - ConfidenceTarget: the half-width of the 95% confidence interval of the
+ *   mean, relative to the mean, is at most the target.
+ * - TimeBudget: the next iteration would end after the time budget, which
+ *   starts with the first call to Continue() and includes the untimed work
+ *   done between the iterations.
+ * - MaximumIterations: the maximum number of iterations ran.
+ * - MinimumTime: the minimum time elapsed, when there is no target.
+ *
+ * With a minimum time, the driver also runs until it elapsed, unless the
+ * maximum number of iterations ran first. A target, a budget or a minimum
+ * time of 0 is not used, so that by default the driver runs the maximum
+ * number of iterations:
+ *
+ * \code
+ * itk::BenchmarkLoopDriver driver(5, 1000, 60.0, 0.01);
+ * while (driver.Continue())
+ * {
+ *   driver.AddSample(timeOneIteration());
+ * }
+ * \endcode
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkLoopDriver
+{
+public:
+  using TimeStampType = RealTimeClock::TimeStampType;
+  using StatisticsType = ProbeRunningStatistics<TimeStampType, TimeStampType>;
+
+  enum class StoppingReasonEnum : uint8_t
+  {
+    Running,
+    MaximumIterations,
+    TimeBudget,
+    ConfidenceTarget,
+    MinimumTime
+  };
+
+  /** The maximum is raised to the minimum, and the minimum to 1. */
+  BenchmarkLoopDriver(SizeValueType minimumIterations,
+                      SizeValueType maximumIterations,
+                      TimeStampType timeBudget = 0.0,
+                      double        targetRelativeHalfWidth = 0.0,
+                      TimeStampType minimumTime = 0.0);
+
+  /** Whether another iteration should run; records why when it should not. */
+  bool
+  Continue();
+
+  /** Accounts for the time of one iteration, in seconds. */
+  void
+  AddSample(TimeStampType seconds);
+
+  SizeValueType
+  GetIterations() const
+  {
+    return this->m_Statistics.GetCount();
+  }
+
+  const StatisticsType &
+  GetStatistics() const
+  {
+    return this->m_Statistics;
+  }
+
+  /** Half-width of the 95% confidence interval of the mean, relative to the
+   * mean; infinite with fewer than two samples. */
+  double
+  GetRelativeHalfWidth() const;
+
+  /** Wall time from the first call to Continue() until the driver stopped,
+   * or until now while it is running. */
+  TimeStampType
+  GetElapsedTime() const;
+
+  StoppingReasonEnum
+  GetStoppingReason() const
+  {
+    return this->m_StoppingReason;
+  }
+
+  SizeValueType
+  GetMinimumIterations() const
+  {
+    return this->m_MinimumIterations;
+  }
+
+  SizeValueType
+  GetMaximumIterations() const
+  {
+    return this->m_MaximumIterations;
+  }
+
+  TimeStampType
+  GetTimeBudget() const
+  {
+    return this->m_TimeBudget;
+  }
+
+  double
+  GetTargetRelativeHalfWidth() const
+  {
+    return this->m_TargetRelativeHalfWidth;
+  }
+
+  TimeStampType
+  GetMinimumTime() const
+  {
+    return this->m_MinimumTime;
+  }
+
+  /** Name of a stopping reason, as printed in the reports. */
+  static const char *
+  ToString(StoppingReasonEnum reason);
+
+  /** Print the settings, the iterations and the stopping reason as a JSON
+   * object. */
+  void
+  PrintJSON(std::ostream & os) const;
+
+private:
+  SizeValueType        m_MinimumIterations;
+  SizeValueType        m_MaximumIterations;
+  TimeStampType        m_TimeBudget;
+  double               m_TargetRelativeHalfWidth;
+  TimeStampType        m_MinimumTime;
+  StatisticsType       m_Statistics;
+  BenchmarkClockSource m_Clock{ BenchmarkClockSource::ClockSourceEnum::Monotonic };
+  TimeStampType        m_StartTime{ -1.0 };
+  TimeStampType        m_StopTime{ -1.0 };
+  StoppingReasonEnum   m_StoppingReason{ StoppingReasonEnum::Running };
+};
+
+/** Prints the name of a stopping reason. */
+extern PerformanceBenchmarking_EXPORT std::ostream &
+operator<<(std::ostream & out, const BenchmarkLoopDriver::StoppingReasonEnum value);
+} // end namespace itk
+
+#endif // itkBenchmarkLoopDriver_h
@@ -0,0 +1,159 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkNoiseFloor_h
+#define itkBenchmarkNoiseFloor_h
+
+#include "itkIntTypes.h"
+#include "itkRealTimeClock.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkNoiseFloor
+ * \brief Measures how noisy the machine is before a benchmark runs.
+ *
+ * Measure() samples, for a short duration:
+ * - the load average, which includes what ran before the benchmark.
+ * - the frequency of the CPU it runs on, and how much it changes.
+ * - the scaling governor and turbo boost of the system information.
+ * - the highest temperature of the thermal zones, and the thermal
+ *   throttling events of the CPUs during the measurement.
+ * - the timer jitter: a fixed amount of work is timed repeatedly in a spin
+ *   loop, and the jitter is the relative distance between the 90th
+ *   percentile and the median of these timings.
+ * - the interruptions: the clock is read in a tight loop, and every gap
+ *   longer than 10 microseconds is time taken by the OS or by another
+ *   process.
+ *
+ * The noise floor is the largest of the timer jitter, of the fraction of
+ * the time lost to interruptions and of the relative change of the
+ * frequency. A relative change of a timing that is smaller than the noise
+ * floor can not be told apart from the noise of the machine.
+ *
+ * The temperatures, frequencies and throttling events are read from /sys on
+ * Linux, and are unknown (negative) elsewhere.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkNoiseFloor
+{
+public:
+  using TimeStampType = RealTimeClock::TimeStampType;
+
+  /** Measure the noise of the machine for about duration seconds. */
+  static BenchmarkNoiseFloor
+  Measure(TimeStampType duration = 0.2);
+
+  /** The relative noise floor, e.g. 0.01 when timings vary by 1%. */
+  double
+  GetNoiseFloor() const
+  {
+    return this->m_NoiseFloor;
+  }
+
+  double
+  GetLoadAverage() const
+  {
+    return this->m_LoadAverage;
+  }
+
+  /** Mean frequency of the CPU in MHz, negative when unknown. */
+  double
+  GetCPUFrequency() const
+  {
+    return this->m_CPUFrequency;
+  }
+
+  /** (maximum - minimum) / mean of the sampled CPU frequencies. */
+  double
+  GetCPUFrequencySpread() const
+  {
+    return this->m_CPUFrequencySpread;
+  }
+
+  /** Highest temperature of the thermal zones in Celsius, negative when
+   * unknown. */
+  double
+  GetMaximumTemperature() const
+  {
+    return this->m_MaximumTemperature;
+  }
+
+  /** Thermal throttling events of the CPUs during the measurement. */
+  SizeValueType
+  GetThrottleEvents() const
+  {
+    return this->m_ThrottleEvents;
+  }
+
+  double
+  GetTimerJitter() const
+  {
+    return this->m_TimerJitter;
+  }
+
+  double
+  GetInterruptedFraction() const
+  {
+    return this->m_InterruptedFraction;
+  }
+
+  /** The longest interruption, in seconds. */
+  TimeStampType
+  GetMaximumInterruption() const
+  {
+    return this->m_MaximumInterruption;
+  }
+
+  /** Why the machine is too noisy to benchmark, empty when it is quiet
+   * enough for a noise floor up to maximumNoiseFloor. These issues are
+   * expected to go away when the machine gets quiet. */
+  std::vector<std::string>
+  GetIssues(double maximumNoiseFloor) const;
+
+  /** Settings of the machine that add noise to the timings, such as a
+   * scaling governor other than "performance", or turbo boost. */
+  std::vector<std::string>
+  GetConfigurationWarnings() const;
+
+  /** Print the measurement as a JSON object; the issues are those for
+   * maximumNoiseFloor. */
+  void
+  PrintJSON(std::ostream & os, double maximumNoiseFloor) const;
+
+private:
+  BenchmarkNoiseFloor() = default;
+
+  double        m_NoiseFloor{ 0.0 };
+  double        m_LoadAverage{ 0.0 };
+  unsigned int  m_NumberOfLogicalCPU{ 1 };
+  double        m_CPUFrequency{ -1.0 };
+  double        m_CPUFrequencySpread{ 0.0 };
+  double        m_MaximumTemperature{ -1.0 };
+  SizeValueType m_ThrottleEvents{ 0 };
+  double        m_TimerJitter{ 0.0 };
+  double        m_InterruptedFraction{ 0.0 };
+  TimeStampType m_MaximumInterruption{ 0.0 };
+};
+} // end namespace itk
+
+#endif // itkBenchmarkNoiseFloor_h
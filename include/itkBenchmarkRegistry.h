@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkRegistry_h
+#define itkBenchmarkRegistry_h
+
+#include "PerformanceBenchmarkingExport.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkRegistry
+ * \brief The benchmarks linked into an executable, by name.
+ *
+ * A benchmark is defined with the ITK_PERF_BENCHMARK macro instead of a
+ * main() function, and registers itself when its executable starts. Its
+ * executable is either a thin wrapper, which runs the only registered
+ * benchmark with its command line, see Main(), or a runner linking many
+ * benchmarks, which selects them by name and runs them one after the other
+ * in the same process.
+ *
+ * The benchmarks of a process share their fixtures: an object of each
+ * fixture type is created the first time a benchmark uses it, and is kept
+ * until the process exits, so that e.g. an input image is read only once.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkRegistry
+{
+public:
+  using ArgumentsType = std::vector<std::string>;
+  /** Runs a benchmark with the arguments of its command line, argv[0] being
+   * the name of the benchmark. */
+  using FunctionType = std::function<int(int argc, char * argv[])>;
+
+  struct BenchmarkEntry
+  {
+    std::string  Name;
+    FunctionType Function;
+    /** The arguments the benchmark runs with when it is not given any, with
+     * placeholders such as {data} to be expanded by the runner. */
+    ArgumentsType DefaultArguments;
+  };
+
+  static BenchmarkRegistry &
+  GetInstance();
+
+  /** Adds a benchmark, replacing any of the same name. Returns true, so
+   * that the registration can initialize a static variable. */
+  bool
+  Register(const std::string & name, FunctionType function, ArgumentsType defaultArguments = {});
+
+  /** The benchmark of a name, nullptr if there is none. */
+  const BenchmarkEntry *
+  Find(const std::string & name) const;
+
+  /** The benchmarks whose name matches the ECMAScript regular expression
+   * filter anywhere, all of them for an empty filter, sorted by name.
+   * Throws std::regex_error for an invalid filter. */
+  std::vector<const BenchmarkEntry *>
+  Select(const std::string & filter) const;
+
+  /** Runs a benchmark with arguments, not including argv[0]. The global
+   * default number of threads is restored afterwards, so that a benchmark
+   * does not change the threads of the next one, and an exception is
+   * reported as a failure. */
+  int
+  Run(const BenchmarkEntry & benchmark, const ArgumentsType & arguments) const;
+
+  /** The main() function of a thin wrapper: runs the only registered
+   * benchmark with the command line. */
+  static int
+  Main(int argc, char * argv[]);
+
+  /** The fixture of a type, default-constructed on first use. */
+  template <typename TFixture>
+  TFixture &
+  GetFixture()
+  {
+    std::shared_ptr<void> & fixture = this->m_Fixtures[std::type_index(typeid(TFixture))];
+    if (!fixture)
+    {
+      fixture = std::make_shared<TFixture>();
+    }
+    return *static_cast<TFixture *>(fixture.get());
+  }
+
+private:
+  BenchmarkRegistry() = default;
+
+  std::map<std::string, BenchmarkEntry>            m_Benchmarks;
+  std::map<std::type_index, std::shared_ptr<void>> m_Fixtures;
+};
+
+/** \class BenchmarkNoFixture
+ * \brief The fixture of the benchmarks that do not share anything.
+ * \ingroup PerformanceBenchmarking
+ */
+struct BenchmarkNoFixture
+{};
+} // end namespace itk
+
+/** Defines and registers a benchmark: the body that follows the macro is
+ * the benchmark, with the parameters argc and argv of a main() function and
+ * the shared fixture, of type TFixture. The variadic arguments are the
+ * default arguments of the benchmark, see
+ * BenchmarkRegistry::BenchmarkEntry:
+ *
+ * \code
+ * ITK_PERF_BENCHMARK(MedianBenchmark, BenchmarkImageFixture, "{timings}", "3", "-1", "{data}/in.mha", "out.mha")
+ * {
+ *   auto inputImage = fixture.ReadImage<ImageType>(argv[4]);
+ *   ...
+ *   return EXIT_SUCCESS;
+ * }
+ * \endcode
+ */
+#define ITK_PERF_BENCHMARK(name, TFixture, ...)                                                                        \
+  static int ITKPerfBenchmark_##name(                                                                                  \
+    [[maybe_unused]] int argc, [[maybe_unused]] char * argv[], [[maybe_unused]] TFixture & fixture);                   \
+  [[maybe_unused]] static const bool ITKPerfBenchmarkRegistered_##name =                                               \
+    itk::BenchmarkRegistry::GetInstance().Register(                                                                    \
+      #name,                                                                                                           \
+      [](int argc, char * argv[]) {                                                                                    \
+        return ITKPerfBenchmark_##name(argc, argv, itk::BenchmarkRegistry::GetInstance().GetFixture<TFixture>());      \
+      },                                                                                                               \
+      { __VA_ARGS__ });                                                                                                \
+  static int ITKPerfBenchmark_##name(                                                                                  \
+    [[maybe_unused]] int argc, [[maybe_unused]] char * argv[], [[maybe_unused]] TFixture & fixture)
+
+#endif // itkBenchmarkRegistry_h
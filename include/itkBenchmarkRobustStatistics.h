@@ -0,0 +1,172 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkRobustStatistics_h
+#define itkBenchmarkRobustStatistics_h
+
+#include "itkIntTypes.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkRobustStatistics
+ * \brief Statistics of the values of a probe that resist outliers.
+ *
+ * The mean and the standard deviation of timings can be dominated by a
+ * single preemption. The median, the median absolute deviation (MAD) and the
+ * interquartile range (IQR) are not. The quantiles are interpolated linearly
+ * between the closest ranks, by GetQuantile().
+ *
+ * The 95% confidence interval of the mean is Student's t interval. The one
+ * of the median is distribution-free: it lies between the order statistics
+ * whose ranks are given by the binomial distribution B(n, 1/2), so that it
+ * costs no more than the sort of the values, however many they are. With
+ * fewer than 6 values, it is the range of the values, of a lower confidence.
+ *
+ * The outliers are classified with Tukey's fences: a value more than 1.5
+ * IQR below the first quartile or above the third quartile is a mild
+ * outlier, and a value more than 3 IQR away is a severe outlier.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkRobustStatistics
+{
+public:
+  using IntervalType = std::pair<double, double>;
+
+  /** The statistics of no values, all 0. */
+  BenchmarkRobustStatistics() = default;
+
+  /** Computes the statistics of values, in any order, with 95% confidence
+   * intervals. */
+  static BenchmarkRobustStatistics
+  Compute(std::vector<double> values);
+
+  /** Returns the quantile of sorted values for a probability in [0, 1],
+   * interpolated linearly between the closest ranks (Hyndman and Fan type 7,
+   * the default of R and NumPy). Returns 0 if there is no value. */
+  template <typename TValue>
+  static double
+  GetQuantile(const std::vector<TValue> & sortedValues, double probability)
+  {
+    if (sortedValues.empty())
+    {
+      return 0.0;
+    }
+    const double position = std::clamp(probability, 0.0, 1.0) * static_cast<double>(sortedValues.size() - 1);
+    const auto   lower = static_cast<size_t>(position);
+    const size_t upper = std::min(lower + 1, sortedValues.size() - 1);
+    const double fraction = position - static_cast<double>(lower);
+    return static_cast<double>(sortedValues[lower]) +
+           fraction * (static_cast<double>(sortedValues[upper]) - static_cast<double>(sortedValues[lower]));
+  }
+
+  /** The two-sided 95% quantile of Student's t distribution. */
+  static double
+  GetStudentT95(SizeValueType degreesOfFreedom);
+
+  SizeValueType
+  GetNumberOfValues() const
+  {
+    return this->m_NumberOfValues;
+  }
+
+  double
+  GetMedian() const
+  {
+    return this->m_Median;
+  }
+
+  /** The median of the absolute deviations from the median. Multiply it by
+   * 1.4826 to estimate the standard deviation of normal values. */
+  double
+  GetMedianAbsoluteDeviation() const
+  {
+    return this->m_MedianAbsoluteDeviation;
+  }
+
+  double
+  GetFirstQuartile() const
+  {
+    return this->m_FirstQuartile;
+  }
+
+  double
+  GetThirdQuartile() const
+  {
+    return this->m_ThirdQuartile;
+  }
+
+  double
+  GetInterquartileRange() const
+  {
+    return this->m_ThirdQuartile - this->m_FirstQuartile;
+  }
+
+  double
+  GetConfidenceLevel() const
+  {
+    return this->m_ConfidenceLevel;
+  }
+
+  /** Student's t confidence interval of the mean. */
+  const IntervalType &
+  GetMeanConfidenceInterval() const
+  {
+    return this->m_MeanConfidenceInterval;
+  }
+
+  /** Order statistic confidence interval of the median. */
+  const IntervalType &
+  GetMedianConfidenceInterval() const
+  {
+    return this->m_MedianConfidenceInterval;
+  }
+
+  /** Values beyond the inner fences, within the outer fences. */
+  SizeValueType
+  GetNumberOfMildOutliers() const
+  {
+    return this->m_NumberOfMildOutliers;
+  }
+
+  /** Values beyond the outer fences. */
+  SizeValueType
+  GetNumberOfSevereOutliers() const
+  {
+    return this->m_NumberOfSevereOutliers;
+  }
+
+private:
+  SizeValueType m_NumberOfValues{ 0 };
+  double        m_Median{ 0.0 };
+  double        m_MedianAbsoluteDeviation{ 0.0 };
+  double        m_FirstQuartile{ 0.0 };
+  double        m_ThirdQuartile{ 0.0 };
+  double        m_ConfidenceLevel{ 0.0 };
+  IntervalType  m_MeanConfidenceInterval{ 0.0, 0.0 };
+  IntervalType  m_MedianConfidenceInterval{ 0.0, 0.0 };
+  SizeValueType m_NumberOfMildOutliers{ 0 };
+  SizeValueType m_NumberOfSevereOutliers{ 0 };
+};
+} // end namespace itk
+
+#endif // itkBenchmarkRobustStatistics_h
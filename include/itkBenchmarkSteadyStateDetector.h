@@ -0,0 +1,58 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkSteadyStateDetector_h
+#define itkBenchmarkSteadyStateDetector_h
+
+#include "itkIntTypes.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkSteadyStateDetector
+ * \brief Finds where the values of successive iterations reach a steady state.
+ *
+ * The first iterations of a benchmark often include one-time costs: the
+ * first touch of the pages of the buffers, the creation of the threads of a
+ * pool, the planning of an FFT, the training of the branch predictors. They
+ * are transient, and bias the summary statistics of the steady state.
+ *
+ * The warm-up is found with the marginal standard error rule (MSER): the
+ * number d of leading values removed is the one that minimizes the squared
+ * standard error of the mean of the remaining values,
+ * sum_{i >= d} (x_i - mean_d)^2 / (n - d)^2, for d up to half of the
+ * values. The truncation is only kept when the mean of the removed values
+ * exceeds the mean of the remaining ones by more than twice their standard
+ * deviation, so that the first values of a steady sequence are not removed
+ * by chance, and neither are the faster first values of a sequence that
+ * slows down.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkSteadyStateDetector
+{
+public:
+  /** Returns the number of leading warm-up values, 0 when the values are
+   * steady from the first one, or when there are fewer than three values. */
+  static SizeValueType
+  GetNumberOfWarmUpValues(const std::vector<double> & values);
+};
+} // end namespace itk
+
+#endif // itkBenchmarkSteadyStateDetector_h
@@ -0,0 +1,258 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkSystemInformation_h
+#define itkBenchmarkSystemInformation_h
+
+#include "itkIntTypes.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkSystemInformation
+ * \brief Snapshot of the system the benchmarks run on.
+ *
+ * The snapshot is taken once per process, by the first call to
+ * GetInstance(), and is immutable afterwards, so that it can be shared by
+ * all the probes. The probe collectors take it when they are constructed,
+ * before anything is timed.
+ *
+ * Besides the host, processor, memory and operating system information of
+ * itksys::SystemInformation, the snapshot records the settings that change
+ * the timings: the SIMD instruction sets, the microcode revision, the
+ * frequency scaling governor and turbo boost state, simultaneous
+ * multithreading, the NUMA nodes, the cache hierarchy, the CPU isolation
+ * options of the kernel command line and the transparent huge page mode.
+ * They are read from /proc and /sys, and are empty or "Unknown" on other
+ * systems than Linux.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkSystemInformation
+{
+public:
+  /** One level of the cache hierarchy, as seen from the first CPU. */
+  struct CacheLevel
+  {
+    unsigned int  m_Level{ 0 };
+    std::string   m_Type;
+    SizeValueType m_Size{ 0 };
+    unsigned int  m_LineSize{ 0 };
+    std::string   m_SharedCPUs;
+  };
+
+  /** A NUMA node, with its CPUs and memory in kilobytes. */
+  struct NUMANode
+  {
+    unsigned int  m_Id{ 0 };
+    std::string   m_CPUs;
+    SizeValueType m_MemoryTotal{ 0 };
+  };
+
+  /** Where a logical CPU is: its package, its physical core in the package
+   * and its last level cache, identified by the first CPU sharing it. */
+  struct CPUTopology
+  {
+    unsigned int m_CPU{ 0 };
+    unsigned int m_Package{ 0 };
+    unsigned int m_Core{ 0 };
+    unsigned int m_LastLevelCache{ 0 };
+  };
+
+  /** Returns the snapshot, taking it on the first call. */
+  static const BenchmarkSystemInformation &
+  GetInstance();
+
+  const std::string &
+  GetHostName() const
+  {
+    return this->m_HostName;
+  }
+
+  const std::string &
+  GetProcessorName() const
+  {
+    return this->m_ProcessorName;
+  }
+
+  unsigned int
+  GetNumberOfPhysicalCPU() const
+  {
+    return this->m_NumberOfPhysicalCPU;
+  }
+
+  unsigned int
+  GetNumberOfLogicalCPU() const
+  {
+    return this->m_NumberOfLogicalCPU;
+  }
+
+  const std::string &
+  GetITKVersion() const
+  {
+    return this->m_ITKVersion;
+  }
+
+  /** SIMD instruction sets supported by the processor, e.g. "avx2" or
+   * "avx512f", with the names of /proc/cpuinfo. */
+  const std::vector<std::string> &
+  GetCPUFlags() const
+  {
+    return this->m_CPUFlags;
+  }
+
+  bool
+  HasCPUFlag(const std::string & flag) const;
+
+  const std::string &
+  GetMicrocode() const
+  {
+    return this->m_Microcode;
+  }
+
+  const std::string &
+  GetScalingDriver() const
+  {
+    return this->m_ScalingDriver;
+  }
+
+  const std::string &
+  GetScalingGovernor() const
+  {
+    return this->m_ScalingGovernor;
+  }
+
+  /** "Enabled", "Disabled" or "Unknown". */
+  const std::string &
+  GetTurboBoost() const
+  {
+    return this->m_TurboBoost;
+  }
+
+  /** The simultaneous multithreading control, e.g. "on", "off" or
+   * "notsupported", or "Unknown". */
+  const std::string &
+  GetSMT() const
+  {
+    return this->m_SMT;
+  }
+
+  const std::vector<NUMANode> &
+  GetNUMANodes() const
+  {
+    return this->m_NUMANodes;
+  }
+
+  const std::vector<CacheLevel> &
+  GetCaches() const
+  {
+    return this->m_Caches;
+  }
+
+  /** The smallest data cache that holds bytes, e.g. "L2", "DRAM" when none
+   * does, or "Unknown" when the caches are not known. */
+  std::string
+  GetCacheRegime(SizeValueType bytes) const;
+
+  /** The topology of the online CPUs, sorted by CPU. Empty when it is not
+   * known. */
+  const std::vector<CPUTopology> &
+  GetCPUTopology() const
+  {
+    return this->m_CPUTopology;
+  }
+
+  const std::string &
+  GetKernelCommandLine() const
+  {
+    return this->m_KernelCommandLine;
+  }
+
+  /** The CPU lists of the isolcpus and nohz_full kernel options. */
+  const std::string &
+  GetIsolatedCPUs() const
+  {
+    return this->m_IsolatedCPUs;
+  }
+
+  const std::string &
+  GetNoHzFullCPUs() const
+  {
+    return this->m_NoHzFullCPUs;
+  }
+
+  /** The transparent huge page mode, e.g. "always", "madvise" or "never". */
+  const std::string &
+  GetTransparentHugePages() const
+  {
+    return this->m_TransparentHugePages;
+  }
+
+  /** Print the snapshot as text. */
+  void
+  Print(std::ostream & os) const;
+
+  /** Print the snapshot as a JSON object. */
+  void
+  PrintJSON(std::ostream & os) const;
+
+  /** Parses a CPU list such as "0-3,8,10-11", as used by the kernel. */
+  static std::vector<unsigned int>
+  ParseCPUList(const std::string & cpuList);
+
+private:
+  BenchmarkSystemInformation();
+
+  std::string  m_HostName;
+  std::string  m_ProcessorName;
+  int          m_ProcessorCacheSize{ 0 };
+  float        m_ProcessorClockFrequency{ 0.0f };
+  unsigned int m_NumberOfPhysicalCPU{ 0 };
+  unsigned int m_NumberOfLogicalCPU{ 0 };
+  std::string  m_OSName;
+  std::string  m_OSRelease;
+  std::string  m_OSVersion;
+  std::string  m_OSPlatform;
+  bool         m_Is64Bits{ false };
+  std::string  m_ITKVersion;
+  size_t       m_TotalVirtualMemory{ 0 };
+  size_t       m_AvailableVirtualMemory{ 0 };
+  size_t       m_TotalPhysicalMemory{ 0 };
+  size_t       m_AvailablePhysicalMemory{ 0 };
+
+  std::vector<std::string> m_CPUFlags;
+  std::string              m_Microcode;
+  std::string              m_ScalingDriver;
+  std::string              m_ScalingGovernor;
+  std::string              m_TurboBoost;
+  std::string              m_SMT;
+  std::vector<NUMANode>    m_NUMANodes;
+  std::vector<CacheLevel>  m_Caches;
+  std::vector<CPUTopology> m_CPUTopology;
+  std::string              m_KernelCommandLine;
+  std::string              m_IsolatedCPUs;
+  std::string              m_NoHzFullCPUs;
+  std::string              m_TransparentHugePages;
+  std::string              m_TransparentHugePagesDefrag;
+};
+} // end namespace itk
+
+#endif // itkBenchmarkSystemInformation_h
@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkThreadPlacement_h
+#define itkBenchmarkThreadPlacement_h
+
+#include "itkBenchmarkSystemInformation.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkThreadPlacement
+ * \brief Orders the CPUs the threads of a benchmark are pinned to.
+ *
+ * The n-th thread of the process is pinned to the n-th CPU of the order,
+ * so that the policy decides which caches and cores the threads share:
+ *
+ * - Compact: one thread per physical core, filling a last level cache
+ *   domain before the next one, so that the threads share the fewest
+ *   caches without sharing a core.
+ * - ScatterCores: one thread per physical core, alternating between the
+ *   packages, so that the threads get the most memory bandwidth.
+ * - ScatterCaches: one thread per physical core, alternating between the
+ *   last level cache domains, so that the threads get the most cache.
+ * - SMTSiblings: all the hardware threads of a core before the next core,
+ *   so that the threads share the cores.
+ *
+ * The first three policies only pin threads to the other hardware threads
+ * of the cores once every core is used. Without simultaneous
+ * multithreading, SMTSiblings is the same as Compact.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkThreadPlacement
+{
+public:
+  using CPUTopology = BenchmarkSystemInformation::CPUTopology;
+
+  enum class ThreadPlacementEnum : uint8_t
+  {
+    None,
+    Compact,
+    ScatterCores,
+    ScatterCaches,
+    SMTSiblings
+  };
+
+  /** Returns the given CPUs in the order of the policy, using the topology
+   * of the running system. The CPUs are returned as given for None. */
+  static std::vector<unsigned int>
+  GetCPUOrder(ThreadPlacementEnum policy, const std::vector<unsigned int> & cpus);
+
+  /** Returns the given CPUs in the order of the policy, for a topology.
+   * The CPUs that are not in the topology are placed last. */
+  static std::vector<unsigned int>
+  GetCPUOrder(ThreadPlacementEnum               policy,
+              const std::vector<unsigned int> & cpus,
+              const std::vector<CPUTopology> &  topology);
+
+  /** Name of a policy, as printed in the reports. */
+  static const char *
+  ToString(ThreadPlacementEnum policy);
+
+  /** Parses a policy name, case insensitive, ignoring '-' and '_' ("scatter"
+   * is accepted for ScatterCores and "smt" for SMTSiblings). Returns false
+   * if the name is not recognized. */
+  static bool
+  FromString(const std::string & name, ThreadPlacementEnum & policy);
+};
+
+/** Prints the name of a thread placement policy. */
+extern PerformanceBenchmarking_EXPORT std::ostream &
+operator<<(std::ostream & out, const BenchmarkThreadPlacement::ThreadPlacementEnum value);
+} // end namespace itk
+
+#endif // itkBenchmarkThreadPlacement_h
@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkThreadScaling_h
+#define itkBenchmarkThreadScaling_h
+
+#include "PerformanceBenchmarkingExport.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkThreadScaling
+ * \brief The speedup and the parallel efficiency of a benchmark run with
+ * increasing numbers of threads, and the serial fractions that explain them.
+ *
+ * The speedup with n threads is the time with the fewest threads measured,
+ * usually 1, divided by the time with n threads, and the efficiency is the
+ * speedup divided by the relative number of threads. A perfectly parallel
+ * benchmark has an efficiency of 1 at every number of threads.
+ *
+ * Amdahl's law models a fixed amount of work of which a serial fraction f
+ * does not run in parallel: the speedup with n threads is
+ * 1 / (f + (1 - f) / n), at most 1 / f. Since 1 / speedup is linear in
+ * 1 / n, f is fitted by least squares on the reciprocals. The Karp-Flatt
+ * metric is the serial fraction of each number of threads alone: a constant
+ * one means that the benchmark follows Amdahl's law, and a growing one that
+ * the threads cost more than the serial part, e.g. in synchronization.
+ *
+ * \code
+ * itk::BenchmarkThreadScaling scaling;
+ * for (unsigned int threads = 1; threads <= 8; threads *= 2)
+ * {
+ *   scaling.AddMeasurement(threads, timeWithThreads(threads));
+ * }
+ * std::cout << scaling.GetAmdahlSerialFraction() << std::endl;
+ * \endcode
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkThreadScaling
+{
+public:
+  /** Records the time, in seconds, of a run with a number of threads,
+   * replacing the previous time with as many threads. */
+  void
+  AddMeasurement(unsigned int threads, double seconds);
+
+  /** The numbers of threads measured, in increasing order. */
+  std::vector<unsigned int>
+  GetThreads() const;
+
+  /** The time with a number of threads, 0 if it was not measured. */
+  double
+  GetTime(unsigned int threads) const;
+
+  /** The fewest threads measured, the reference of the speedups, 0 before
+   * the first measurement. */
+  unsigned int
+  GetReferenceThreads() const;
+
+  /** The time with the reference threads divided by the time with threads,
+   * 0 if either was not measured. */
+  double
+  GetSpeedup(unsigned int threads) const;
+
+  /** The speedup divided by the number of threads relative to the reference
+   * threads. */
+  double
+  GetEfficiency(unsigned int threads) const;
+
+  /** The serial fraction of Amdahl's law that explains the speedup with
+   * threads alone, 0 for the reference threads. */
+  double
+  GetKarpFlattSerialFraction(unsigned int threads) const;
+
+  /** The serial fraction of Amdahl's law fitted to all the speedups, in
+   * [0, 1], 0 with fewer than 2 numbers of threads. */
+  double
+  GetAmdahlSerialFraction() const;
+
+  /** Print the times, the speedups, the efficiencies, the fitted serial
+   * fraction and the maximum speedup it implies, null without serial
+   * fraction, as a JSON object. */
+  void
+  PrintJSON(std::ostream & os) const;
+
+private:
+  std::map<unsigned int, double> m_Times;
+};
+} // end namespace itk
+
+#endif // itkBenchmarkThreadScaling_h
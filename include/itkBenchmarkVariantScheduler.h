@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBenchmarkVariantScheduler_h
+#define itkBenchmarkVariantScheduler_h
+
+#include "itkBenchmarkRobustStatistics.h"
+#include "itkIntTypes.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BenchmarkVariantScheduler
+ * \brief Interleaves the iterations of variants of a benchmark, and pairs
+ * their timings.
+ *
+ * When the variants of a benchmark, e.g. several implementations of the same
+ * operation, run one after the other, the thermal drift, the changes of the
+ * CPU frequency and the background load land on whichever variant runs
+ * last. The scheduler runs them in blocks instead: each block runs every
+ * variant once, in a new random order. The drift then affects all the
+ * variants alike, and the timings of a block are compared with each other:
+ * the ratio of the time of a variant to the time of the reference variant
+ * in the same block cancels what the block had in common.
+ *
+ * The order is drawn from a seeded generator, so that a schedule is
+ * reproducible:
+ *
+ * \code
+ * itk::BenchmarkVariantScheduler scheduler(3);
+ * for (int block = 0; block < 20; ++block)
+ * {
+ *   for (const unsigned int variant : scheduler.NextBlock())
+ *   {
+ *     scheduler.AddSample(variant, timeVariant(variant));
+ *   }
+ * }
+ * \endcode
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT BenchmarkVariantScheduler
+{
+public:
+  using OrderType = std::vector<unsigned int>;
+
+  /** At least one variant is scheduled. */
+  explicit BenchmarkVariantScheduler(unsigned int numberOfVariants, uint32_t seed = 0);
+
+  unsigned int
+  GetNumberOfVariants() const
+  {
+    return static_cast<unsigned int>(this->m_Samples.size());
+  }
+
+  uint32_t
+  GetSeed() const
+  {
+    return this->m_Seed;
+  }
+
+  /** Draws the order of the variants in the next block. */
+  const OrderType &
+  NextBlock();
+
+  /** Records the time of a variant in the current block, in seconds. */
+  void
+  AddSample(unsigned int variant, double seconds);
+
+  /** The blocks in which every variant has a time. */
+  SizeValueType
+  GetNumberOfBlocks() const;
+
+  /** The times of a variant, one per block. */
+  const std::vector<double> &
+  GetSamples(unsigned int variant) const
+  {
+    return this->m_Samples[variant];
+  }
+
+  /** The average position of a variant in its blocks, from 0 for the first
+   * one; (n - 1) / 2 for n variants when the order is balanced. */
+  double
+  GetMeanPosition(unsigned int variant) const;
+
+  /** The time of a variant divided by the time of the reference, block by
+   * block: below 1 when the variant is faster. */
+  std::vector<double>
+  GetPairedRatios(unsigned int variant, unsigned int reference) const;
+
+  /** The median of the paired ratios, with its confidence interval. */
+  BenchmarkRobustStatistics
+  GetPairedRatioStatistics(unsigned int variant, unsigned int reference) const;
+
+  /** The blocks in which a variant was faster than the reference. */
+  SizeValueType
+  GetNumberOfFasterBlocks(unsigned int variant, unsigned int reference) const;
+
+  /** Print the schedule and the paired statistics of each variant, named by
+   * names, relative to the reference as a JSON object. */
+  void
+  PrintJSON(std::ostream & os, const std::vector<std::string> & names, unsigned int reference = 0) const;
+
+private:
+  uint32_t                         m_Seed;
+  std::minstd_rand                 m_Generator;
+  OrderType                        m_Order;
+  std::vector<std::vector<double>> m_Samples;
+  std::vector<double>              m_PositionSums;
+  SizeValueType                    m_NumberOfDrawnBlocks{ 0 };
+};
+} // end namespace itk
+
+#endif // itkBenchmarkVariantScheduler_h
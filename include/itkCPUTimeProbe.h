@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCPUTimeProbe_h
+#define itkCPUTimeProbe_h
+
+#include "LOCAL_itkResourceProbe.h"
+#include "PerformanceBenchmarkingExport.h"
+
+namespace itk
+{
+/** \class CPUTimeProbe
+ * \brief Measures the CPU time consumed by all the threads of the process,
+ * together with the elapsed time.
+ *
+ * The probed value is the CPU time of the process (CLOCK_PROCESS_CPUTIME_ID,
+ * or GetProcessTimes() on Windows), in seconds. Each Start()/Stop() pair
+ * also records the elapsed (monotonic) time and the voluntary and
+ * involuntary context switches of the process (getrusage(), not counted on
+ * Windows).
+ *
+ * The reports derive the CPU utilization, CPU time / elapsed time, which is
+ * the mean number of busy threads, and the parallel efficiency,
+ * CPU time / (elapsed time x number of threads). An efficiency far below 1
+ * shows threads waiting on a barrier, or a filter running serially.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT CPUTimeProbe : public LOCAL_ResourceProbe<double, double>
+{
+public:
+  using TimeStampType = double;
+
+  /** Constructor */
+  CPUTimeProbe();
+
+  /** Destructor */
+  ~CPUTimeProbe() override;
+
+  /** Returns the CPU time consumed by the process so far, and samples the
+   * elapsed time and the context switches. */
+  TimeStampType
+  GetInstantValue() const override;
+
+  /** Start measuring. */
+  void
+  Start() override;
+
+  /** Stop measuring, and record the elapsed time and the context switches. */
+  void
+  Stop() override;
+
+  /** Reset the probe */
+  void
+  Reset() override;
+
+  /** Set the number of threads the efficiency is computed for. Zero, the
+   * default, uses MultiThreaderBase::GetGlobalDefaultNumberOfThreads() when
+   * the probe is started. */
+  virtual void
+  SetNumberOfThreads(unsigned int numberOfThreads);
+
+  /** Returns the number of threads the efficiency is computed for. */
+  unsigned int
+  GetNumberOfThreads() const;
+
+  /** Returns the elapsed time of every Start()/Stop() pair. */
+  const std::vector<TimeStampType> &
+  GetWallTimeValues() const
+  {
+    return this->m_WallTimeValues;
+  }
+
+  /** Returns the sum of the elapsed times. */
+  TimeStampType
+  GetTotalWallTime() const
+  {
+    return this->m_TotalWallTime;
+  }
+
+  /** CPU time / elapsed time over all the Start()/Stop() pairs. */
+  double
+  GetCPUUtilization() const;
+
+  /** CPU time / (elapsed time x number of threads) over all the
+   * Start()/Stop() pairs. */
+  double
+  GetParallelEfficiency() const;
+
+  /** Returns the number of voluntary context switches, e.g. waiting on a
+   * lock, over all the Start()/Stop() pairs. */
+  SizeValueType
+  GetVoluntaryContextSwitches() const
+  {
+    return this->m_VoluntaryContextSwitches;
+  }
+
+  /** Returns the number of involuntary context switches, i.e. preemptions,
+   * over all the Start()/Stop() pairs. */
+  SizeValueType
+  GetInvoluntaryContextSwitches() const
+  {
+    return this->m_InvoluntaryContextSwitches;
+  }
+
+protected:
+  /** Print the elapsed time, the utilization, the efficiency and the context
+   * switches. */
+  void
+  PrintJSONMetadata(std::ostream & os) override;
+
+private:
+  /** Samples taken by the last GetInstantValue(). */
+  mutable TimeStampType m_InstantWallTime{ 0.0 };
+  mutable SizeValueType m_InstantVoluntaryContextSwitches{ 0 };
+  mutable SizeValueType m_InstantInvoluntaryContextSwitches{ 0 };
+
+  TimeStampType m_StartWallTime{ 0.0 };
+  SizeValueType m_StartVoluntaryContextSwitches{ 0 };
+  SizeValueType m_StartInvoluntaryContextSwitches{ 0 };
+
+  unsigned int m_NumberOfThreads{ 0 };
+  unsigned int m_MeasuredNumberOfThreads{ 1 };
+
+  std::vector<TimeStampType> m_WallTimeValues;
+  TimeStampType              m_TotalWallTime{ 0.0 };
+  SizeValueType              m_VoluntaryContextSwitches{ 0 };
+  SizeValueType              m_InvoluntaryContextSwitches{ 0 };
+};
+} // end namespace itk
+
+#endif // itkCPUTimeProbe_h
@@ -0,0 +1,43 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCPUTimeProbesCollector_h
+#define itkCPUTimeProbesCollector_h
+
+#include "LOCAL_itkResourceProbesCollectorBase.h"
+#include "itkCPUTimeProbe.h"
+
+namespace itk
+{
+/** \class CPUTimeProbesCollector
+ * \brief Aggregates a set of CPUTimeProbe.
+ *
+ * \sa CPUTimeProbe
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT CPUTimeProbesCollector : public LOCAL_ResourceProbesCollectorBase<CPUTimeProbe>
+{
+public:
+  /** Constructor */
+  CPUTimeProbesCollector();
+
+  /** Destructor */
+  ~CPUTimeProbesCollector() override;
+};
+} // end namespace itk
+
+#endif // itkCPUTimeProbesCollector_h
@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkConcurrentProbesCollector_h
+#define itkConcurrentProbesCollector_h
+
+#include "itkIntTypes.h"
+
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/** \class ConcurrentProbesCollector
+ *  \brief A probes collector that can be started and stopped from several
+ *  threads at once.
+ *
+ *  The probes of TCollector, a LOCAL_ResourceProbesCollectorBase, are not
+ *  thread-safe. A ConcurrentProbesCollector gives each thread its own copy
+ *  of every probe: Start() and Stop() with a probe handle update the probe
+ *  of the calling thread without any lock, so work units inside
+ *  DynamicThreadedGenerateData() or a ParallelizeImageRegion() lambda can be
+ *  timed. Registering a name with GetProbeHandle() takes a lock, and so do
+ *  the first use of a probe by a thread and the reports.
+ *
+ *  The probes of all the threads are merged when a report is printed, or by
+ *  MergeThreadProbes(); this must not happen while threads are measuring.
+ *  The reports then include, for each probe, the statistics of every thread
+ *  and the load imbalance: the largest total of a thread divided by the
+ *  mean total of the threads.
+ *
+ *  \code
+ *  itk::HighPriorityRealTimeConcurrentProbesCollector collector;
+ *  const auto handle = collector.GetProbeHandle("WorkUnit");
+ *  mt->ParallelizeImageRegion<3>(region, [&](const RegionType & subregion) {
+ *    collector.Start(handle);
+ *    ProcessRegion(subregion);
+ *    collector.Stop(handle);
+ *  }, nullptr);
+ *  collector.Report();
+ *  \endcode
+ *
+ *  The probes of a thread are configured like the ones of the collector
+ *  when the thread first starts them, so the collector settings (clock
+ *  source, overhead subtraction, ...) should be chosen before measuring.
+ *
+ *  \sa LOCAL_ResourceProbesCollectorBase
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+template <typename TCollector>
+class ITK_TEMPLATE_EXPORT ConcurrentProbesCollector : public TCollector
+{
+public:
+  using Superclass = TCollector;
+  using ProbeType = typename Superclass::ProbeType;
+  using ProbeHandleType = typename Superclass::ProbeHandleType;
+  using ProbeValueType = typename Superclass::ProbeValueType;
+
+  ConcurrentProbesCollector();
+
+  ~ConcurrentProbesCollector() override;
+
+  using Superclass::Start;
+  using Superclass::Stop;
+
+  /** Stop the probe of the calling thread with a particular name. */
+  void
+  Stop(const char * name) override;
+
+  /** Returns the handle of the probe with a particular name. If the probe
+   * does not exist, it will be created. */
+  ProbeHandleType
+  GetProbeHandle(const char * name) override;
+
+  /** Start the probe of the calling thread, without any lock. */
+  void
+  Start(ProbeHandleType handle) override;
+
+  /** Stop the probe of the calling thread, without any lock. */
+  void
+  Stop(ProbeHandleType handle) override;
+
+  /** Start a scope nested in the current scope of the calling thread. */
+  ProbeHandleType
+  StartScope(const char * name) override;
+
+  /** Stop the current scope of the calling thread. */
+  void
+  StopScope(ProbeHandleType handle) override;
+
+  /** Destroy the set of probes of the collector and of all the threads. */
+  void
+  Clear() override;
+
+  /** Replace the probes of the collector, returned by GetProbe(), with the
+   *  merge of the probes of all the threads. */
+  virtual void
+  MergeThreadProbes();
+
+  /** Returns the number of threads that started a probe. */
+  SizeValueType
+  GetNumberOfThreads() const;
+
+  /** Report the statistics of each thread and the load imbalance of each
+   *  probe. */
+  virtual void
+  ThreadReport(std::ostream & os = std::cout, bool useTabs = false);
+
+  /** Report the summary of results from all probes */
+  void
+  Report(std::ostream & os = std::cout,
+         bool           printSystemInfo = true,
+         bool           printReportHead = true,
+         bool           useTabs = false) override;
+  using Superclass::Report;
+
+  /** Expanded report of the summary of results from all probes */
+  void
+  ExpandedReport(std::ostream & os = std::cout,
+                 bool           printSystemInfo = true,
+                 bool           printReportHead = true,
+                 bool           useTabs = false) override;
+  using Superclass::ExpandedReport;
+
+protected:
+  /** Merge the probes of the threads. */
+  void
+  PrepareReport() override;
+
+  /** Add the statistics of each thread to the JSON report. */
+  void
+  PrintJSONCollectorInformation(std::ostream & os) override;
+
+private:
+  /** The probes and the scopes of one thread. */
+  struct ThreadProbes
+  {
+    std::deque<ProbeType>        m_Probes;
+    std::vector<ProbeHandleType> m_ScopeStack;
+  };
+
+  /** The probes of the calling thread in each collector, by collector
+   *  identifier. */
+  using ThreadProbesCacheType = std::vector<std::pair<SizeValueType, ThreadProbes *>>;
+
+  /** Returns the cache of the calling thread. */
+  static ThreadProbesCacheType &
+  GetThreadProbesCache();
+
+  /** Returns the identifiers of the collectors that exist, protected by
+   *  GetCollectorIdsMutex(). */
+  static std::set<SizeValueType> &
+  GetCollectorIds();
+
+  static std::mutex &
+  GetCollectorIdsMutex();
+
+  /** Drop the entries of the destroyed collectors from the cache of the
+   *  calling thread. */
+  static void
+  PruneThreadProbesCache();
+
+  /** Returns the probes of the calling thread, created on first use. */
+  ThreadProbes &
+  GetThreadProbes();
+
+  /** Returns the probe of the calling thread with a handle. */
+  ProbeType &
+  GetThreadProbe(ProbeHandleType handle);
+
+  /** Largest total of a thread divided by the mean total of the threads
+   *  that measured a probe. */
+  double
+  GetLoadImbalance(ProbeHandleType handle) const;
+
+  /** Identifies the collector in the thread local caches of the threads. */
+  SizeValueType m_CollectorId;
+
+  /** Protects the registration of the probes and of the threads. Recursive,
+   *  for the reports merge the probes of the threads under the lock. */
+  mutable std::recursive_mutex m_Mutex;
+
+  /** Never shrinks while the collector exists: the threads keep pointers. */
+  std::deque<std::unique_ptr<ThreadProbes>> m_ThreadProbes;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkConcurrentProbesCollector.hxx"
+#endif
+
+#endif // itkConcurrentProbesCollector_h
@@ -0,0 +1,429 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkConcurrentProbesCollector_hxx
+#define itkConcurrentProbesCollector_hxx
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace itk
+{
+
+template <typename TCollector>
+ConcurrentProbesCollector<TCollector>::ConcurrentProbesCollector()
+{
+  std::lock_guard<std::mutex> lock(GetCollectorIdsMutex());
+  static SizeValueType        numberOfCollectors = 0;
+  this->m_CollectorId = ++numberOfCollectors;
+  GetCollectorIds().insert(this->m_CollectorId);
+}
+
+
+template <typename TCollector>
+ConcurrentProbesCollector<TCollector>::~ConcurrentProbesCollector()
+{
+  std::lock_guard<std::mutex> lock(GetCollectorIdsMutex());
+  GetCollectorIds().erase(this->m_CollectorId);
+}
+
+
+template <typename TCollector>
+typename ConcurrentProbesCollector<TCollector>::ThreadProbesCacheType &
+ConcurrentProbesCollector<TCollector>::GetThreadProbesCache()
+{
+  // Each thread caches the probes it uses in every collector. The
+  // identifiers are never reused, so the entries of destroyed collectors
+  // are never matched, and they are pruned when a collector is added.
+  thread_local ThreadProbesCacheType threadProbesCache;
+  return threadProbesCache;
+}
+
+
+template <typename TCollector>
+std::set<SizeValueType> &
+ConcurrentProbesCollector<TCollector>::GetCollectorIds()
+{
+  static std::set<SizeValueType> collectorIds;
+  return collectorIds;
+}
+
+
+template <typename TCollector>
+std::mutex &
+ConcurrentProbesCollector<TCollector>::GetCollectorIdsMutex()
+{
+  static std::mutex collectorIdsMutex;
+  return collectorIdsMutex;
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::PruneThreadProbesCache()
+{
+  ThreadProbesCacheType &         threadProbesCache = GetThreadProbesCache();
+  std::lock_guard<std::mutex>     lock(GetCollectorIdsMutex());
+  const std::set<SizeValueType> & collectorIds = GetCollectorIds();
+  threadProbesCache.erase(std::remove_if(threadProbesCache.begin(),
+                                         threadProbesCache.end(),
+                                         [&collectorIds](const typename ThreadProbesCacheType::value_type & entry) {
+                                           return collectorIds.count(entry.first) == 0;
+                                         }),
+                          threadProbesCache.end());
+}
+
+
+template <typename TCollector>
+typename ConcurrentProbesCollector<TCollector>::ThreadProbes &
+ConcurrentProbesCollector<TCollector>::GetThreadProbes()
+{
+  ThreadProbesCacheType & threadProbesCache = GetThreadProbesCache();
+  for (const auto & entry : threadProbesCache)
+  {
+    if (entry.first == this->m_CollectorId)
+    {
+      return *entry.second;
+    }
+  }
+  PruneThreadProbesCache();
+
+  ThreadProbes * threadProbes;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+    this->m_ThreadProbes.push_back(std::make_unique<ThreadProbes>());
+    threadProbes = this->m_ThreadProbes.back().get();
+  }
+  threadProbesCache.emplace_back(this->m_CollectorId, threadProbes);
+  return *threadProbes;
+}
+
+
+template <typename TCollector>
+typename ConcurrentProbesCollector<TCollector>::ProbeType &
+ConcurrentProbesCollector<TCollector>::GetThreadProbe(ProbeHandleType handle)
+{
+  std::deque<ProbeType> & probes = this->GetThreadProbes().m_Probes;
+  if (handle >= probes.size())
+  {
+    // Copy the configuration of the probes of the collector.
+    std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+    itkAssertInDebugAndIgnoreInReleaseMacro(handle < this->m_Probes.size());
+    while (probes.size() <= handle)
+    {
+      probes.push_back(this->m_Probes[probes.size()]);
+      probes.back().Reset();
+    }
+  }
+  return probes[handle];
+}
+
+
+template <typename TCollector>
+typename ConcurrentProbesCollector<TCollector>::ProbeHandleType
+ConcurrentProbesCollector<TCollector>::GetProbeHandle(const char * name)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  return Superclass::GetProbeHandle(name);
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::Stop(const char * name)
+{
+  ProbeHandleType handle;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+    const auto                            pos = this->m_ProbeHandles.find(name);
+    if (pos == this->m_ProbeHandles.end())
+    {
+      itkGenericExceptionMacro(<< "The probe \"" << name << "\" does not exist. It can not be stopped.");
+    }
+    handle = pos->second;
+  }
+  this->Stop(handle);
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::Start(ProbeHandleType handle)
+{
+  this->GetThreadProbe(handle).Start();
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::Stop(ProbeHandleType handle)
+{
+  this->GetThreadProbe(handle).Stop();
+}
+
+
+template <typename TCollector>
+typename ConcurrentProbesCollector<TCollector>::ProbeHandleType
+ConcurrentProbesCollector<TCollector>::StartScope(const char * name)
+{
+  std::vector<ProbeHandleType> & scopeStack = this->GetThreadProbes().m_ScopeStack;
+  const ProbeHandleType          parent = scopeStack.empty() ? Superclass::NoParentHandle : scopeStack.back();
+
+  ProbeHandleType handle;
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+    std::string                           path;
+    if (parent != Superclass::NoParentHandle)
+    {
+      path = this->m_Probes[parent].GetNameOfProbe() + '/';
+    }
+    path += name;
+    handle = Superclass::GetProbeHandle(path.c_str());
+    this->m_ParentHandles[handle] = parent;
+  }
+  scopeStack.push_back(handle);
+  this->Start(handle);
+  return handle;
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::StopScope(ProbeHandleType handle)
+{
+  std::vector<ProbeHandleType> & scopeStack = this->GetThreadProbes().m_ScopeStack;
+  if (scopeStack.empty() || scopeStack.back() != handle)
+  {
+    itkGenericExceptionMacro(<< "The probe handle " << handle
+                             << " is not the current scope of the thread. It can not be stopped.");
+  }
+  scopeStack.pop_back();
+  this->Stop(handle);
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::Clear()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  Superclass::Clear();
+  for (auto & threadProbes : this->m_ThreadProbes)
+  {
+    threadProbes->m_Probes.clear();
+    threadProbes->m_ScopeStack.clear();
+  }
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::MergeThreadProbes()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  for (ProbeHandleType handle = 0; handle < this->m_Probes.size(); ++handle)
+  {
+    ProbeType & probe = this->m_Probes[handle];
+    probe.Reset();
+    for (const auto & threadProbes : this->m_ThreadProbes)
+    {
+      if (handle < threadProbes->m_Probes.size())
+      {
+        probe.Merge(threadProbes->m_Probes[handle]);
+      }
+    }
+  }
+}
+
+
+template <typename TCollector>
+SizeValueType
+ConcurrentProbesCollector<TCollector>::GetNumberOfThreads() const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  return static_cast<SizeValueType>(this->m_ThreadProbes.size());
+}
+
+
+template <typename TCollector>
+double
+ConcurrentProbesCollector<TCollector>::GetLoadImbalance(ProbeHandleType handle) const
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+
+  double        maximumTotal = 0.0;
+  double        sumOfTotals = 0.0;
+  SizeValueType numberOfThreads = 0;
+  for (const auto & threadProbes : this->m_ThreadProbes)
+  {
+    if (handle < threadProbes->m_Probes.size() && threadProbes->m_Probes[handle].GetNumberOfStops() > 0)
+    {
+      const auto total = static_cast<double>(threadProbes->m_Probes[handle].GetTotal());
+      maximumTotal = std::max(maximumTotal, total);
+      sumOfTotals += total;
+      ++numberOfThreads;
+    }
+  }
+  if (numberOfThreads == 0 || sumOfTotals <= 0.0)
+  {
+    return 1.0;
+  }
+  return maximumTotal * static_cast<double>(numberOfThreads) / sumOfTotals;
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::ThreadReport(std::ostream & os, bool useTabs)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+
+  constexpr unsigned int tabwidth = 15;
+
+  std::stringstream ss;
+  if (useTabs)
+  {
+    ss << std::left << '\t' << "Name Of Probe" << std::left << '\t' << "Thread" << std::left << '\t' << "Iterations"
+       << std::left << '\t' << "Total" << std::left << '\t' << "Mean" << std::left << '\t' << "Imbalance";
+  }
+  else
+  {
+    ss << std::left << std::setw(tabwidth * 2) << "Name Of Probe" << std::left << std::setw(tabwidth) << "Thread"
+       << std::left << std::setw(tabwidth) << "Iterations" << std::left << std::setw(tabwidth) << "Total" << std::left
+       << std::setw(tabwidth) << "Mean" << std::left << std::setw(tabwidth) << "Imbalance";
+  }
+  os << ss.str() << std::endl;
+
+  for (const auto & named : this->m_ProbeHandles)
+  {
+    const ProbeHandleType handle = named.second;
+    for (SizeValueType thread = 0; thread < this->m_ThreadProbes.size(); ++thread)
+    {
+      const std::deque<ProbeType> & probes = this->m_ThreadProbes[thread]->m_Probes;
+      if (handle >= probes.size() || probes[handle].GetNumberOfStops() == 0)
+      {
+        continue;
+      }
+      ss.str("");
+      if (useTabs)
+      {
+        ss << std::left << '\t' << named.first << std::left << '\t' << thread << std::left << '\t'
+           << probes[handle].GetNumberOfIteration() << std::left << '\t' << probes[handle].GetTotal() << std::left
+           << '\t' << probes[handle].GetMean() << std::left << '\t' << this->GetLoadImbalance(handle);
+      }
+      else
+      {
+        ss << std::left << std::setw(tabwidth * 2) << named.first << std::left << std::setw(tabwidth) << thread
+           << std::left << std::setw(tabwidth) << probes[handle].GetNumberOfIteration() << std::left
+           << std::setw(tabwidth) << probes[handle].GetTotal() << std::left << std::setw(tabwidth)
+           << probes[handle].GetMean() << std::left << std::setw(tabwidth) << this->GetLoadImbalance(handle);
+      }
+      os << ss.str() << std::endl;
+    }
+  }
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::Report(std::ostream & os,
+                                              bool           printSystemInfo,
+                                              bool           printReportHead,
+                                              bool           useTabs)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  Superclass::Report(os, printSystemInfo, printReportHead, useTabs);
+  if (!this->m_ThreadProbes.empty())
+  {
+    os << std::endl;
+    this->ThreadReport(os, useTabs);
+  }
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::ExpandedReport(std::ostream & os,
+                                                      bool           printSystemInfo,
+                                                      bool           printReportHead,
+                                                      bool           useTabs)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  Superclass::ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
+  if (!this->m_ThreadProbes.empty())
+  {
+    os << std::endl;
+    this->ThreadReport(os, useTabs);
+  }
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::PrepareReport()
+{
+  Superclass::PrepareReport();
+  this->MergeThreadProbes();
+}
+
+
+template <typename TCollector>
+void
+ConcurrentProbesCollector<TCollector>::PrintJSONCollectorInformation(std::ostream & os)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->m_Mutex);
+  Superclass::PrintJSONCollectorInformation(os);
+
+  os << "  \"NumberOfThreads\": " << this->m_ThreadProbes.size() << ",\n";
+  os << "  \"ThreadStatistics\": [";
+  bool firstProbe = true;
+  for (const auto & named : this->m_ProbeHandles)
+  {
+    const ProbeHandleType handle = named.second;
+    os << (firstProbe ? "\n" : ",\n");
+    firstProbe = false;
+    os << "    {\n";
+    os << "      \"Name\": \"" << named.first << "\",\n";
+    os << "      \"LoadImbalance\": " << this->GetLoadImbalance(handle) << ",\n";
+    os << "      \"Threads\": [";
+    bool firstThread = true;
+    for (SizeValueType thread = 0; thread < this->m_ThreadProbes.size(); ++thread)
+    {
+      const std::deque<ProbeType> & probes = this->m_ThreadProbes[thread]->m_Probes;
+      if (handle >= probes.size() || probes[handle].GetNumberOfStops() == 0)
+      {
+        continue;
+      }
+      const ProbeType & probe = probes[handle];
+      os << (firstThread ? "\n" : ",\n");
+      firstThread = false;
+      os << "        { \"Thread\": " << thread << ", \"Iterations\": " << probe.GetNumberOfIteration()
+         << ", \"Total\": " << probe.GetTotal() << ", \"Mean\": " << probe.GetMean()
+         << ", \"Minimum\": " << probe.GetMinimum() << ", \"Maximum\": " << probe.GetMaximum() << " }";
+    }
+    os << (firstThread ? "]\n" : "\n      ]\n");
+    os << "    }";
+  }
+  os << (firstProbe ? "],\n" : "\n  ],\n");
+}
+
+} // end namespace itk
+
+#endif // itkConcurrentProbesCollector_hxx
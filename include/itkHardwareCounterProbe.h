@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHardwareCounterProbe_h
+#define itkHardwareCounterProbe_h
+
+#include "LOCAL_itkResourceProbe.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace itk
+{
+/** \class HardwareCounterProbe
+ * \brief Counts CPU events with the Linux perf_event_open interface.
+ *
+ * Every Start()/Stop() pair records the number of cycles, instructions,
+ * last level cache misses, branch misses and data TLB misses of the region.
+ * The cycles are the probed value, reported like the value of the other
+ * probes; the JSON report adds the values of every counter and the derived
+ * ratios: instructions per cycle and misses per kilo-instruction.
+ *
+ * The counters are opened once per process, in user space only, for all
+ * the threads of the process, and are inherited by the threads created
+ * afterwards, such as the ITK worker threads. They are scaled when the
+ * kernel multiplexes them.
+ *
+ * When the counters are not available (other systems than Linux, a
+ * restrictive /proc/sys/kernel/perf_event_paranoid, virtual machines, ...)
+ * the probe measures zeros, IsAvailable() returns false and the JSON report
+ * gives the reason. A counter that is not supported by the processor is
+ * omitted from the reports.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT HardwareCounterProbe : public LOCAL_ResourceProbe<double, double>
+{
+public:
+  using CounterValueType = double;
+
+  enum class HardwareCounterEnum : uint8_t
+  {
+    Cycles,
+    Instructions,
+    LLCMisses,
+    BranchMisses,
+    DTLBMisses
+  };
+
+  static constexpr unsigned int NumberOfCounters = 5;
+
+  using CounterArrayType = std::array<CounterValueType, NumberOfCounters>;
+
+  /** Constructor */
+  HardwareCounterProbe();
+
+  /** Destructor */
+  ~HardwareCounterProbe() override;
+
+  /** Returns the number of cycles counted so far, and reads all the other
+   * counters. */
+  CounterValueType
+  GetInstantValue() const override;
+
+  /** Start counting. */
+  void
+  Start() override;
+
+  /** Stop counting, and record the value of every counter. */
+  void
+  Stop() override;
+
+  /** Reset the probe */
+  void
+  Reset() override;
+
+  /** Whether the counters could be opened. */
+  bool
+  IsAvailable() const;
+
+  /** Whether a counter is supported and recorded. */
+  bool
+  IsAvailable(HardwareCounterEnum counter) const;
+
+  /** Why the counters could not be opened, empty if they are available. */
+  std::string
+  GetUnavailabilityReason() const;
+
+  /** Returns the values of a counter for every Start()/Stop() pair. */
+  const std::vector<CounterValueType> &
+  GetCounterValues(HardwareCounterEnum counter) const;
+
+  /** Returns the sum of the values of a counter. */
+  CounterValueType
+  GetCounterTotal(HardwareCounterEnum counter) const;
+
+  /** Instructions per cycle over all the Start()/Stop() pairs. */
+  double
+  GetInstructionsPerCycle() const;
+
+  /** Misses of a counter per thousand instructions over all the
+   * Start()/Stop() pairs. */
+  double
+  GetMissesPerKiloInstruction(HardwareCounterEnum counter) const;
+
+  /** Name of a counter, as printed in the reports. */
+  static const char *
+  ToString(HardwareCounterEnum counter);
+
+protected:
+  /** Print the values of every counter and the derived ratios. */
+  void
+  PrintJSONMetadata(std::ostream & os) override;
+
+private:
+  class CounterSet;
+
+  /** The counters are shared by all the probes of the process. */
+  std::shared_ptr<CounterSet> m_CounterSet;
+
+  mutable CounterArrayType                                    m_InstantCounts{};
+  CounterArrayType                                            m_StartCounts{};
+  CounterArrayType                                            m_CounterTotals{};
+  std::array<std::vector<CounterValueType>, NumberOfCounters> m_CounterValues;
+};
+
+/** Prints the name of a counter. */
+extern PerformanceBenchmarking_EXPORT std::ostream &
+operator<<(std::ostream & out, const HardwareCounterProbe::HardwareCounterEnum value);
+} // end namespace itk
+
+#endif // itkHardwareCounterProbe_h
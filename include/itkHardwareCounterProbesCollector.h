@@ -0,0 +1,48 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHardwareCounterProbesCollector_h
+#define itkHardwareCounterProbesCollector_h
+
+#include "LOCAL_itkResourceProbesCollectorBase.h"
+#include "itkHardwareCounterProbe.h"
+
+namespace itk
+{
+/** \class HardwareCounterProbesCollector
+ * \brief Aggregates a set of HardwareCounterProbe.
+ *
+ * \sa HardwareCounterProbe
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT HardwareCounterProbesCollector
+  : public LOCAL_ResourceProbesCollectorBase<HardwareCounterProbe>
+{
+public:
+  /** Constructor */
+  HardwareCounterProbesCollector();
+
+  /** Destructor */
+  ~HardwareCounterProbesCollector() override;
+
+  /** Whether the hardware counters could be opened. */
+  bool
+  IsAvailable() const;
+};
+} // end namespace itk
+
+#endif // itkHardwareCounterProbesCollector_h
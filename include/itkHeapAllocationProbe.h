@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHeapAllocationProbe_h
+#define itkHeapAllocationProbe_h
+
+#include "LOCAL_itkResourceProbe.h"
+#include "itkHeapAllocationTracker.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class HeapAllocationProbe
+ * \brief Counts the heap allocations of the probed code.
+ *
+ * The probed value is the number of calls to operator new between Start()
+ * and Stop(), from all the threads of the process. Every Start()/Stop()
+ * pair also records the allocated bytes and the deallocations, and, with
+ * SetRecordCallSites(), the allocations of every call site so that the
+ * code allocating the most can be found.
+ *
+ * The allocations are only counted when the module is configured with
+ * PerformanceBenchmarking_TRACK_HEAP_ALLOCATIONS;
+ * HeapAllocationTracker::IsAvailable() tells whether they are. Recording
+ * the call sites copies the call site table at Start() and Stop(), so it
+ * should not be enabled for probes that also measure time.
+ *
+ * \sa HeapAllocationTracker
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT HeapAllocationProbe : public LOCAL_ResourceProbe<double, double>
+{
+public:
+  using CountValueType = double;
+  using CallSite = HeapAllocationTracker::CallSite;
+
+  /** Constructor */
+  HeapAllocationProbe();
+
+  /** Destructor */
+  ~HeapAllocationProbe() override;
+
+  /** Returns the number of allocations since the start of the process, and
+   * samples the other counters. */
+  CountValueType
+  GetInstantValue() const override;
+
+  /** Start tracking the allocations, and counting. */
+  void
+  Start() override;
+
+  /** Stop counting, and tracking the allocations. */
+  void
+  Stop() override;
+
+  /** Reset the probe */
+  void
+  Reset() override;
+
+  /** Record the allocations of every call site. Off by default. */
+  void
+  SetRecordCallSites(bool recordCallSites)
+  {
+    this->m_RecordCallSites = recordCallSites;
+  }
+
+  bool
+  GetRecordCallSites() const
+  {
+    return this->m_RecordCallSites;
+  }
+
+  /** Returns the allocated bytes of every Start()/Stop() pair. */
+  const std::vector<SizeValueType> &
+  GetAllocatedBytesValues() const
+  {
+    return this->m_AllocatedBytesValues;
+  }
+
+  /** Returns the deallocations of every Start()/Stop() pair. */
+  const std::vector<SizeValueType> &
+  GetDeallocationsValues() const
+  {
+    return this->m_DeallocationsValues;
+  }
+
+  /** Returns the call sites of all the Start()/Stop() pairs, sorted by
+   * decreasing number of allocations, at most numberOfCallSites of them. */
+  std::vector<CallSite>
+  GetTopCallSites(size_t numberOfCallSites = 10) const;
+
+protected:
+  /** Print the bytes, the deallocations and the top call sites. */
+  void
+  PrintJSONMetadata(std::ostream & os) override;
+
+private:
+  bool m_RecordCallSites{ false };
+  bool m_Tracking{ false };
+  bool m_TrackingCallSites{ false };
+
+  mutable HeapAllocationTracker::Counters m_InstantCounters;
+  HeapAllocationTracker::Counters         m_StartCounters;
+
+  std::vector<SizeValueType> m_AllocatedBytesValues;
+  std::vector<SizeValueType> m_DeallocationsValues;
+
+  std::vector<CallSite> m_StartCallSites;
+  std::vector<CallSite> m_StopCallSites;
+  /** Allocations of all the pairs, indexed as the call site table. */
+  std::vector<CallSite> m_CallSites;
+};
+} // end namespace itk
+
+#endif // itkHeapAllocationProbe_h
@@ -0,0 +1,66 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHeapAllocationProbesCollector_h
+#define itkHeapAllocationProbesCollector_h
+
+#include "LOCAL_itkResourceProbesCollectorBase.h"
+#include "itkHeapAllocationProbe.h"
+
+namespace itk
+{
+/** \class HeapAllocationProbesCollector
+ * \brief Aggregates a set of HeapAllocationProbe.
+ *
+ * The HighPriorityRealTimeProbesCollector pairs its time probes with the
+ * probes of a HeapAllocationProbesCollector when allocation probes are
+ * enabled.
+ *
+ * \sa HeapAllocationProbe
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT HeapAllocationProbesCollector
+  : public LOCAL_ResourceProbesCollectorBase<HeapAllocationProbe>
+{
+public:
+  /** Constructor */
+  HeapAllocationProbesCollector();
+
+  /** Destructor */
+  ~HeapAllocationProbesCollector() override;
+
+  /** Record the call sites of the existing and future probes. */
+  virtual void
+  SetRecordCallSites(bool recordCallSites);
+
+  bool
+  GetRecordCallSites() const
+  {
+    return this->m_RecordCallSites;
+  }
+
+protected:
+  /** Apply the collector call site recording to a new probe. */
+  void
+  InitializeProbe(HeapAllocationProbe & probe) override;
+
+private:
+  bool m_RecordCallSites{ false };
+};
+} // end namespace itk
+
+#endif // itkHeapAllocationProbesCollector_h
@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkHeapAllocationTracker_h
+#define itkHeapAllocationTracker_h
+
+#include "itkIntTypes.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class HeapAllocationTracker
+ * \brief Counts the heap allocations made through operator new.
+ *
+ * When the module is configured with PerformanceBenchmarking_TRACK_HEAP_ALLOCATIONS,
+ * the global operator new and operator delete (all the sized, array, aligned
+ * and nothrow forms) are replaced by versions that count the allocations,
+ * the deallocations and the allocated bytes, and optionally the allocations
+ * of every call site. IsAvailable() is false otherwise, and the counters
+ * stay at zero.
+ *
+ * The counters are process wide and are only updated while tracking is
+ * started, so that the cost outside of the probed code is a single relaxed
+ * load per allocation. Memory allocated with malloc() directly is not
+ * counted.
+ *
+ * \sa HeapAllocationProbe
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT HeapAllocationTracker
+{
+public:
+  /** Allocations made from one call site, the return address of operator
+   * new. */
+  struct CallSite
+  {
+    const void *  m_Address{ nullptr };
+    SizeValueType m_Allocations{ 0 };
+    SizeValueType m_Bytes{ 0 };
+  };
+
+  /** Snapshot of the counters. */
+  struct Counters
+  {
+    SizeValueType m_Allocations{ 0 };
+    SizeValueType m_Deallocations{ 0 };
+    SizeValueType m_AllocatedBytes{ 0 };
+  };
+
+  /** Whether operator new and operator delete are replaced. */
+  static bool
+  IsAvailable();
+
+  /** Count the allocations until the matching StopTracking(). The calls
+   * may be nested, the allocations are counted while at least one tracking
+   * is started, and their call sites while one of them records them. */
+  static void
+  StartTracking(bool recordCallSites = false);
+
+  static void
+  StopTracking(bool recordCallSites = false);
+
+  /** Returns the counters since the start of the process. */
+  static Counters
+  GetCounters();
+
+  /** Copy the call site table. The call sites keep their index, so that two
+   * copies can be subtracted entry by entry; unused entries have a null
+   * address. */
+  static void
+  GetCallSites(std::vector<CallSite> & callSites);
+
+  /** Number of allocations that were not recorded because the call site
+   * table is full. */
+  static SizeValueType
+  GetNumberOfDroppedCallSites();
+
+  /** Returns the function and offset of a call site, or its address when
+   * the symbol is unknown. */
+  static std::string
+  GetCallSiteName(const void * address);
+};
+} // end namespace itk
+
+#endif // itkHeapAllocationTracker_h
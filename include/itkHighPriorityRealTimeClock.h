@@ -20,12 +20,9 @@
 #define itkHighPriorityRealTimeClock_h
 
 #include "itkRealTimeClock.h"
+#include "itkBenchmarkExecutionContext.h"
 #include "PerformanceBenchmarkingExport.h"
 
-#if defined(_WIN32)
-#  include <windows.h>
-#endif // defined(_WIN32)
-
 namespace itk
 {
 
@@ -34,6 +31,11 @@ namespace itk
  *
  * It subclasses from RealTimeClock to bump the process priority.
  *
+ * The priority, and the other settings of the BenchmarkExecutionContext,
+ * are applied by the first clock that is created and restored when the
+ * last one is destroyed, so that the clocks of the probes do not undo
+ * each other.
+ *
  * \ingroup PerformanceBenchmarking
  *
  */
@@ -58,22 +60,15 @@ protected:
   /** Destructor */
   ~HighPriorityRealTimeClock() override;
 
-  /** Method for raising and restoring the priority */
+  /** Method for raising and restoring the priority, by acquiring and
+   * releasing the BenchmarkExecutionContext. */
   virtual void
   RaisePriority();
   virtual void
   RestorePriority();
 
 private:
-#if defined(_WIN32)
-  DWORD m_OldPriorityClass;
-  int   m_OldThreadPriority;
-#else
-  int m_OldProcessPriority;
-#endif //  defined(_WIN32)
-
-  void
-  DisplayErrorMessage();
+  bool m_PriorityRaised{ false };
 };
 
 } // end of namespace itk
@@ -20,6 +20,7 @@
 
 #include "LOCAL_itkResourceProbe.h"
 #include "itkHighPriorityRealTimeClock.h"
+#include "itkBenchmarkClockSource.h"
 
 namespace itk
 {
@@ -59,8 +60,48 @@ public:
   /** Get a handle to m_RealTimeClock. */
   itkGetConstObjectMacro(HighPriorityRealTimeClock, HighPriorityRealTimeClock);
 
+  /** Select the clock read by GetInstantValue(). It must not be changed
+   * between a Start() and the matching Stop(). */
+  virtual void
+  SetClockSource(BenchmarkClockSource::ClockSourceEnum clockSource);
+
+  /** Returns the clock read by GetInstantValue(), which differs from the
+   * requested one when that one is not available. */
+  BenchmarkClockSource::ClockSourceEnum
+  GetClockSource() const
+  {
+    return this->m_ClockSource.GetClockSource();
+  }
+
+  /** Set the work of one iteration: the voxels it processes and the bytes
+   * it reads and writes. The JSON report then has the throughput of the
+   * median time, in voxels and bytes per second, and the smallest cache
+   * that holds the bytes. 0, the default, when unknown. */
+  virtual void
+  SetWorkload(SizeValueType voxels, SizeValueType bytes);
+
+  SizeValueType
+  GetWorkloadVoxels() const
+  {
+    return this->m_WorkloadVoxels;
+  }
+
+  SizeValueType
+  GetWorkloadBytes() const
+  {
+    return this->m_WorkloadBytes;
+  }
+
+protected:
+  /** Print the clock source and its resolution, and the workload. */
+  void
+  PrintJSONMetadata(std::ostream & os) override;
+
 private:
   HighPriorityRealTimeClock::Pointer m_HighPriorityRealTimeClock;
+  BenchmarkClockSource               m_ClockSource;
+  SizeValueType                      m_WorkloadVoxels{ 0 };
+  SizeValueType                      m_WorkloadBytes{ 0 };
 };
 } // end namespace itk
 #endif // itkHighPriorityRealTimeProbe_h
@@ -19,12 +19,39 @@
 #define itkHighPriorityRealTimeProbesCollector_h
 
 #include "LOCAL_itkResourceProbesCollectorBase.h"
+#include "itkBenchmarkExecutionContext.h"
 #include "itkHighPriorityRealTimeProbe.h"
+#include "itkHeapAllocationProbesCollector.h"
+#include "itkMemoryFootprintProbesCollector.h"
+#include "itkConcurrentProbesCollector.h"
 #include <map>
 
 namespace itk
 {
 /** \class HighPriorityRealTimeProbeCollector
+ * \brief Aggregates a set of HighPriorityRealTimeProbe.
+ *
+ * All the probes of a collector read the clock selected with
+ * SetClockSource(), the RealTimeClock by default.
+ *
+ * With SetMemoryProbesEnabled(), or when the ITKPERFORMANCEBENCHMARK_MEMORY_PROBE
+ * environment variable is set to ON, every probe started with a handle is
+ * paired with a MemoryFootprintProbe of the same name. The memory probe is
+ * started before, and stopped after, the time probe, and is reported after
+ * the time probes.
+ *
+ * Likewise, with SetAllocationProbesEnabled(), or when
+ * ITKPERFORMANCEBENCHMARK_ALLOCATION_PROBE is set to ON, or to CALLSITES to
+ * also record the call sites, every probe is paired with a
+ * HeapAllocationProbe, started after the memory probe.
+ *
+ * The probes of a HighPriorityRealTimeConcurrentProbesCollector only
+ * measure time.
+ *
+ * The collector holds the BenchmarkExecutionContext while it exists, so
+ * that the context is applied once, before the probe overhead is
+ * calibrated, rather than each time the collector has no probe.
+ *
  *
  *  \brief Computes the multiple time passed between multiple pairs of
  *         two points in code.
@@ -43,14 +70,127 @@ class PerformanceBenchmarking_EXPORT HighPriorityRealTimeProbesCollector
   : public LOCAL_ResourceProbesCollectorBase<HighPriorityRealTimeProbe>
 {
 public:
+  using Superclass = LOCAL_ResourceProbesCollectorBase<HighPriorityRealTimeProbe>;
+
   /** Constructor */
   HighPriorityRealTimeProbesCollector();
 
   /** Destructor */
   ~HighPriorityRealTimeProbesCollector() override;
 
+  /** Select the clock read by the existing and future probes, and calibrate
+   * the probe overhead again. */
+  virtual void
+  SetClockSource(BenchmarkClockSource::ClockSourceEnum clockSource);
+
+  /** Returns the requested clock source. */
+  BenchmarkClockSource::ClockSourceEnum
+  GetClockSource() const
+  {
+    return this->m_ClockSource;
+  }
+
+  /** Measure the resident memory and the page faults of every probe. The
+   * default is read from the ITKPERFORMANCEBENCHMARK_MEMORY_PROBE environment
+   * variable. */
+  virtual void
+  SetMemoryProbesEnabled(bool enabled);
+
+  bool
+  GetMemoryProbesEnabled() const
+  {
+    return this->m_MemoryProbesEnabled;
+  }
+
+  /** Returns the memory probes, empty unless they are enabled. */
+  const MemoryFootprintProbesCollector &
+  GetMemoryProbes() const
+  {
+    return this->m_MemoryProbes;
+  }
+
+  /** Count the heap allocations of every probe. The default is read from
+   * the ITKPERFORMANCEBENCHMARK_ALLOCATION_PROBE environment variable. */
+  virtual void
+  SetAllocationProbesEnabled(bool enabled);
+
+  bool
+  GetAllocationProbesEnabled() const
+  {
+    return this->m_AllocationProbesEnabled;
+  }
+
+  /** Record the call sites of the allocations of every probe. */
+  virtual void
+  SetRecordAllocationCallSites(bool recordCallSites);
+
+  /** Returns the allocation probes, empty unless they are enabled. */
+  const HeapAllocationProbesCollector &
+  GetAllocationProbes() const
+  {
+    return this->m_AllocationProbes;
+  }
+
+  /** Set the workload of one iteration of the probe of a name, creating the
+   * probe if it does not exist. \sa HighPriorityRealTimeProbe::SetWorkload */
+  virtual void
+  SetWorkload(const char * id, SizeValueType voxels, SizeValueType bytes);
+
+  using Superclass::Start;
+  using Superclass::Stop;
+  using Superclass::Report;
+  using Superclass::ExpandedReport;
+
+  void
+  Start(ProbeHandleType handle) override;
+
+  void
+  Stop(ProbeHandleType handle) override;
+
+  void
+  Report(std::ostream & os = std::cout,
+         bool           printSystemInfo = true,
+         bool           printReportHead = true,
+         bool           useTabs = false) override;
+
+  void
+  ExpandedReport(std::ostream & os = std::cout,
+                 bool           printSystemInfo = true,
+                 bool           printReportHead = true,
+                 bool           useTabs = false) override;
+
+  void
+  Clear() override;
+
+protected:
+  /** Apply the collector clock source to a new probe. */
+  void
+  InitializeProbe(HighPriorityRealTimeProbe & probe) override;
+
+  /** Print the settings of the BenchmarkExecutionContext, and the memory
+   * and the allocation probes when they are enabled. */
+  void
+  PrintJSONCollectorInformation(std::ostream & os) override;
+
 private:
+  BenchmarkExecutionContext::Guard m_ExecutionContextGuard;
+
+  BenchmarkClockSource::ClockSourceEnum m_ClockSource{ BenchmarkClockSource::ClockSourceEnum::RealTimeClock };
+
+  bool                           m_MemoryProbesEnabled{ false };
+  MemoryFootprintProbesCollector m_MemoryProbes;
+  /** Memory probe handle of each time probe, indexed by handle, or
+   * NoParentHandle if the probe has not been started with memory probes. */
+  std::vector<ProbeHandleType> m_MemoryProbeHandles;
+
+  bool                          m_AllocationProbesEnabled{ false };
+  HeapAllocationProbesCollector m_AllocationProbes;
+  std::vector<ProbeHandleType>  m_AllocationProbeHandles;
 };
+
+/** A HighPriorityRealTimeProbesCollector that can be used from several
+ * threads at once. \sa ConcurrentProbesCollector */
+using HighPriorityRealTimeConcurrentProbesCollector = ConcurrentProbesCollector<HighPriorityRealTimeProbesCollector>;
 } // end namespace itk
 
 #endif // itkHighPriorityRealTimeProbe_h
@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryFootprintProbe_h
+#define itkMemoryFootprintProbe_h
+
+#include "LOCAL_itkResourceProbe.h"
+#include "itkMemoryUsageObserver.h"
+#include "PerformanceBenchmarkingExport.h"
+
+#include <vector>
+
+namespace itk
+{
+/** \class MemoryFootprintProbe
+ * \brief Measures the resident memory and the page faults of the process.
+ *
+ * The probed value is the resident set size (RSS) in kilobytes, so the
+ * values are the RSS change of every Start()/Stop() pair. Each pair also
+ * records the high-water mark of the RSS during the pair, and the minor
+ * and major page faults of the process.
+ *
+ * On Linux, Start() resets the high-water mark (VmHWM) to the current RSS
+ * by writing to /proc/self/clear_refs, so that the peak is the one of the
+ * pair; the peak of an enclosing probe is therefore lost when probes are
+ * nested. When the reset is not permitted the peak is the one of the
+ * process so far, and PeakResetAvailable is false in the JSON report.
+ * Elsewhere the RSS is read with MemoryUsageObserver and no peak or page
+ * faults are recorded.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT MemoryFootprintProbe : public LOCAL_ResourceProbe<double, double>
+{
+public:
+  using MemoryLoadType = double;
+
+  /** Constructor */
+  MemoryFootprintProbe();
+
+  /** Destructor */
+  ~MemoryFootprintProbe() override;
+
+  /** Returns the resident set size in kilobytes, and samples the page
+   * faults. */
+  MemoryLoadType
+  GetInstantValue() const override;
+
+  /** Reset the high-water mark, and start measuring. */
+  void
+  Start() override;
+
+  /** Stop measuring, and record the peak and the page faults. */
+  void
+  Stop() override;
+
+  /** Reset the probe */
+  void
+  Reset() override;
+
+  /** Returns the high-water mark of the RSS during every Start()/Stop()
+   * pair, in kilobytes. */
+  const std::vector<MemoryLoadType> &
+  GetPeakValues() const
+  {
+    return this->m_PeakValues;
+  }
+
+  /** Returns the largest high-water mark of the RSS, in kilobytes. */
+  MemoryLoadType
+  GetPeak() const;
+
+  /** Returns the largest increase of the RSS over its value at Start(), in
+   * kilobytes. */
+  MemoryLoadType
+  GetPeakIncrease() const
+  {
+    return this->m_PeakIncrease;
+  }
+
+  /** Whether the high-water mark is reset by Start(). */
+  bool
+  GetPeakResetAvailable() const
+  {
+    return this->m_PeakResetAvailable;
+  }
+
+  /** Returns the minor page faults of every Start()/Stop() pair. */
+  const std::vector<SizeValueType> &
+  GetMinorPageFaultValues() const
+  {
+    return this->m_MinorPageFaultValues;
+  }
+
+  /** Returns the major page faults, which required I/O, of every
+   * Start()/Stop() pair. */
+  const std::vector<SizeValueType> &
+  GetMajorPageFaultValues() const
+  {
+    return this->m_MajorPageFaultValues;
+  }
+
+protected:
+  /** Print the peaks and the page faults. */
+  void
+  PrintJSONMetadata(std::ostream & os) override;
+
+private:
+  /** Returns the high-water mark of the RSS in kilobytes, 0 if unknown. */
+  MemoryLoadType
+  ReadPeak() const;
+
+  mutable MemoryUsageObserver m_MemoryObserver;
+
+  mutable MemoryLoadType m_InstantResidentSetSize{ 0.0 };
+  mutable SizeValueType  m_InstantMinorPageFaults{ 0 };
+  mutable SizeValueType  m_InstantMajorPageFaults{ 0 };
+  MemoryLoadType         m_StartResidentSetSize{ 0.0 };
+  SizeValueType          m_StartMinorPageFaults{ 0 };
+  SizeValueType          m_StartMajorPageFaults{ 0 };
+
+  bool                        m_PeakResetAvailable{ false };
+  std::vector<MemoryLoadType> m_PeakValues;
+  MemoryLoadType              m_PeakIncrease{ 0.0 };
+  std::vector<SizeValueType>  m_MinorPageFaultValues;
+  std::vector<SizeValueType>  m_MajorPageFaultValues;
+};
+} // end namespace itk
+
+#endif // itkMemoryFootprintProbe_h
@@ -0,0 +1,47 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMemoryFootprintProbesCollector_h
+#define itkMemoryFootprintProbesCollector_h
+
+#include "LOCAL_itkResourceProbesCollectorBase.h"
+#include "itkMemoryFootprintProbe.h"
+
+namespace itk
+{
+/** \class MemoryFootprintProbesCollector
+ * \brief Aggregates a set of MemoryFootprintProbe.
+ *
+ * The HighPriorityRealTimeProbesCollector pairs its time probes with the
+ * probes of a MemoryFootprintProbesCollector when memory probes are enabled.
+ *
+ * \sa MemoryFootprintProbe
+ * \ingroup PerformanceBenchmarking
+ */
+class PerformanceBenchmarking_EXPORT MemoryFootprintProbesCollector
+  : public LOCAL_ResourceProbesCollectorBase<MemoryFootprintProbe>
+{
+public:
+  /** Constructor */
+  MemoryFootprintProbesCollector();
+
+  /** Destructor */
+  ~MemoryFootprintProbesCollector() override;
+};
+} // end namespace itk
+
+#endif // itkMemoryFootprintProbesCollector_h
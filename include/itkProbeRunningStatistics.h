@@ -0,0 +1,109 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkProbeRunningStatistics_h
+#define itkProbeRunningStatistics_h
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+/** \class ProbeRunningStatistics
+ *  \brief Streaming moments of the values measured by a resource probe.
+ *
+ *   Each call to AddValue() updates the count, the compensated (Kahan) sum
+ *   and the Welford mean and sum of squared deviations in constant time and
+ *   memory, so the summary statistics of a probe are always available
+ *   without keeping or revisiting the individual measurements.
+ *
+ *   \sa LOCAL_ResourceProbe
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+template <typename ValueType, typename MeanType>
+class ITK_TEMPLATE_EXPORT ProbeRunningStatistics
+{
+public:
+  using CountType = SizeValueType;
+
+  ProbeRunningStatistics();
+
+  /** Forget all the values added so far. */
+  void
+  Reset();
+
+  /** Account for one more measured value. */
+  void
+  AddValue(ValueType value);
+
+  /** Account for all the values added to another object, as if they had
+   *  been added to this one (Chan et al. pairwise update). */
+  void
+  Merge(const ProbeRunningStatistics & other);
+
+  /** Number of values added since the last Reset(). */
+  CountType
+  GetCount() const
+  {
+    return this->m_Count;
+  }
+
+  /** Compensated sum of the values. */
+  ValueType
+  GetTotal() const
+  {
+    return this->m_Total;
+  }
+
+  /** Arithmetic mean of the values, 0 if no value was added. */
+  MeanType
+  GetMean() const
+  {
+    return this->m_Mean;
+  }
+
+  /** Unbiased sample variance, 0 if fewer than two values were added. */
+  MeanType
+  GetVariance() const;
+
+  /** Square root of GetVariance(). */
+  MeanType
+  GetStandardDeviation() const;
+
+  /** Standard deviation of the mean, 0 if no value was added. */
+  MeanType
+  GetStandardError() const;
+
+private:
+  /** Compensated (Kahan) addition to the total. */
+  void
+  AddToTotal(ValueType value);
+
+  CountType m_Count;
+  ValueType m_Total;
+  ValueType m_TotalCompensation;
+  MeanType  m_Mean;
+  MeanType  m_SumOfSquaredDeviations;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkProbeRunningStatistics.hxx"
+#endif
+
+#endif // itkProbeRunningStatistics_h
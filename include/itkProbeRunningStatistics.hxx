@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkProbeRunningStatistics_hxx
+#define itkProbeRunningStatistics_hxx
+
+#include <cmath>
+
+#include "itkNumericTraits.h"
+
+namespace itk
+{
+
+template <typename ValueType, typename MeanType>
+ProbeRunningStatistics<ValueType, MeanType>::ProbeRunningStatistics()
+{
+  this->Reset();
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+ProbeRunningStatistics<ValueType, MeanType>::Reset()
+{
+  this->m_Count = NumericTraits<CountType>::ZeroValue();
+  this->m_Total = NumericTraits<ValueType>::ZeroValue();
+  this->m_TotalCompensation = NumericTraits<ValueType>::ZeroValue();
+  this->m_Mean = NumericTraits<MeanType>::ZeroValue();
+  this->m_SumOfSquaredDeviations = NumericTraits<MeanType>::ZeroValue();
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+ProbeRunningStatistics<ValueType, MeanType>::AddValue(ValueType value)
+{
+  ++this->m_Count;
+  this->AddToTotal(value);
+
+  // Welford's update of the mean and of the sum of squared deviations.
+  const MeanType delta = static_cast<MeanType>(value) - this->m_Mean;
+  this->m_Mean += delta / static_cast<MeanType>(this->m_Count);
+  this->m_SumOfSquaredDeviations += delta * (static_cast<MeanType>(value) - this->m_Mean);
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+ProbeRunningStatistics<ValueType, MeanType>::Merge(const ProbeRunningStatistics & other)
+{
+  if (other.m_Count == 0)
+  {
+    return;
+  }
+  if (this->m_Count == 0)
+  {
+    *this = other;
+    return;
+  }
+
+  const auto     count = static_cast<MeanType>(this->m_Count);
+  const auto     otherCount = static_cast<MeanType>(other.m_Count);
+  const MeanType mergedCount = count + otherCount;
+  const MeanType delta = other.m_Mean - this->m_Mean;
+
+  this->m_Mean += delta * otherCount / mergedCount;
+  this->m_SumOfSquaredDeviations += other.m_SumOfSquaredDeviations + delta * delta * count * otherCount / mergedCount;
+  this->m_Count += other.m_Count;
+  this->AddToTotal(other.m_Total);
+  this->AddToTotal(-other.m_TotalCompensation);
+}
+
+
+template <typename ValueType, typename MeanType>
+void
+ProbeRunningStatistics<ValueType, MeanType>::AddToTotal(ValueType value)
+{
+  // Kahan summation keeps the total accurate over millions of small values.
+  const ValueType compensatedValue = value - this->m_TotalCompensation;
+  const ValueType total = this->m_Total + compensatedValue;
+  this->m_TotalCompensation = (total - this->m_Total) - compensatedValue;
+  this->m_Total = total;
+}
+
+
+template <typename ValueType, typename MeanType>
+MeanType
+ProbeRunningStatistics<ValueType, MeanType>::GetVariance() const
+{
+  if (this->m_Count < 2)
+  {
+    return NumericTraits<MeanType>::ZeroValue();
+  }
+  return this->m_SumOfSquaredDeviations / static_cast<MeanType>(this->m_Count - 1);
+}
+
+
+template <typename ValueType, typename MeanType>
+MeanType
+ProbeRunningStatistics<ValueType, MeanType>::GetStandardDeviation() const
+{
+  return static_cast<MeanType>(std::sqrt(static_cast<double>(this->GetVariance())));
+}
+
+
+template <typename ValueType, typename MeanType>
+MeanType
+ProbeRunningStatistics<ValueType, MeanType>::GetStandardError() const
+{
+  if (this->m_Count == 0)
+  {
+    return NumericTraits<MeanType>::ZeroValue();
+  }
+  return static_cast<MeanType>(static_cast<double>(this->GetStandardDeviation()) /
+                               std::sqrt(static_cast<double>(this->m_Count)));
+}
+
+} // end namespace itk
+
+#endif // itkProbeRunningStatistics_hxx
@@ -0,0 +1,390 @@
+"""Compare two sets of benchmark results, and gate on regressions.
+
+The results are the JSON files written by WriteExpandedReport, given as two
+files or two directories searched recursively (the baseline first). The
+values of the probes of the same name are pooled, without their warm-up
+iterations. For each probe present on both sides:
+
+  Speedup   baseline median / candidate median, > 1 when the candidate is
+            faster, with a bootstrap confidence interval
+  p         two-sided p-value of a Mann-Whitney U test (or Welch's t test)
+  Delta     Cliff's delta effect size, from -1 (the candidate is always
+            faster) to 1 (always slower)
+  g         Hedges' g, the difference of the means in pooled standard
+            deviations
+
+A probe regressed when it is significantly slower (p < alpha) by more than
+the threshold, or by more than the noise floor recorded in either set of
+results if that is larger. A probe recorded without its values, with only
+its mean, has insufficient data: a mean is not a sample. The exit code is 0
+without regression, 1 with a regression, and 2 when the results can not be
+compared.
+
+  python -m itk_perf_shim.compare base-results/ head-results/ --json comparison.json
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import random
+import statistics
+import sys
+from pathlib import Path
+
+EXIT_OK = 0
+EXIT_REGRESSION = 1
+EXIT_ERROR = 2
+
+# Exact Mann-Whitney p-values are computed up to this many pairs of values.
+_EXACT_MANN_WHITNEY_PAIRS = 400
+
+
+class ComparisonError(RuntimeError):
+    pass
+
+
+def _result_files(path: Path) -> list[Path]:
+    if path.is_dir():
+        return sorted(path.rglob("*.json"))
+    if path.is_file():
+        return [path]
+    raise ComparisonError(f"No results at {path}")
+
+
+def load_results(path: str | Path) -> tuple[dict[str, list[float]], float, set[str]]:
+    """Return {probe name: steady-state values} pooled over the JSON files of
+    a path, the largest noise floor recorded in them (0 if none), and the
+    names of the probes recorded without their values in some file."""
+    probes: dict[str, list[float]] = {}
+    noise_floor = 0.0
+    aggregates_only: set[str] = set()
+    for result_file in _result_files(Path(path)):
+        try:
+            with result_file.open() as f:
+                doc = json.load(f)
+        except ValueError as e:
+            raise ComparisonError(f"Unexpected JSON content in {result_file}: {e}") from e
+        if not isinstance(doc, dict) or "Probes" not in doc:
+            continue
+        noise_floor = max(noise_floor, float(doc.get("NoiseFloor", {}).get("NoiseFloor", 0.0)))
+        for probe in doc["Probes"]:
+            values = [float(v) for v in probe.get("Values", [])]
+            values = values[int(probe.get("WarmUpIterations", 0)):]
+            if not values and "Mean" in probe:
+                aggregates_only.add(probe["Name"])
+            probes.setdefault(probe["Name"], []).extend(values)
+    if not probes:
+        raise ComparisonError(f"No probes in the results at {path}")
+    return probes, noise_floor, aggregates_only
+
+
+def _mean_variance(values: list[float]) -> tuple[float, float]:
+    mean = statistics.fmean(values)
+    variance = statistics.variance(values, mean) if len(values) > 1 else 0.0
+    return mean, variance
+
+
+def _normal_sf(z: float) -> float:
+    """Survival function of the standard normal distribution."""
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def _incomplete_beta(a: float, b: float, x: float) -> float:
+    """Regularized incomplete beta function I_x(a, b), by Lentz's continued
+    fraction."""
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    if x > (a + 1.0) / (a + b + 2.0):
+        return 1.0 - _incomplete_beta(b, a, 1.0 - x)
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b)
+                     + a * math.log(x) + b * math.log(1.0 - x)) / a
+    tiny = 1e-300
+    c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    result = d
+    for m in range(1, 300):
+        for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                          -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            result *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return front * result
+
+
+def welch_t_test(baseline: list[float], candidate: list[float]) -> float:
+    """Two-sided p-value of Welch's t test, nan with fewer than two values."""
+    if len(baseline) < 2 or len(candidate) < 2:
+        return float("nan")
+    mean_a, var_a = _mean_variance(baseline)
+    mean_b, var_b = _mean_variance(candidate)
+    se2_a, se2_b = var_a / len(baseline), var_b / len(candidate)
+    if se2_a + se2_b == 0.0:
+        return 1.0 if mean_a == mean_b else 0.0
+    t = (mean_b - mean_a) / math.sqrt(se2_a + se2_b)
+    df = (se2_a + se2_b) ** 2 / (se2_a ** 2 / (len(baseline) - 1) + se2_b ** 2 / (len(candidate) - 1))
+    return _incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+
+def _ranks(values: list[float]) -> tuple[list[float], float]:
+    """Mid-ranks of values, and the tie correction sum(t^3 - t)."""
+    order = sorted(range(len(values)), key=values.__getitem__)
+    ranks = [0.0] * len(values)
+    tie_correction = 0.0
+    i = 0
+    while i < len(order):
+        j = i
+        while j + 1 < len(order) and values[order[j + 1]] == values[order[i]]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[order[k]] = (i + j) / 2.0 + 1.0
+        tied = j - i + 1
+        tie_correction += tied ** 3 - tied
+        i = j + 1
+    return ranks, tie_correction
+
+
+def _exact_mann_whitney_p(u: float, n1: int, n2: int) -> float:
+    """Two-sided exact p-value of U without ties, from the number of ways to
+    reach each U (the partitions of U into n1 parts at most n2)."""
+    # f(n1, n2, u) = f(n1 - 1, n2, u - n2) + f(n1, n2 - 1, u), by whether the
+    # largest value is of the first sample.
+    table: dict[tuple[int, int], list[int]] = {}
+
+    def frequencies(a: int, b: int) -> list[int]:
+        if (a, b) in table:
+            return table[(a, b)]
+        if a == 0 or b == 0:
+            result = [1]
+        else:
+            with_a = frequencies(a - 1, b)
+            without_a = frequencies(a, b - 1)
+            result = [0] * (a * b + 1)
+            for value, count in enumerate(without_a):
+                result[value] += count
+            for value, count in enumerate(with_a):
+                result[value + b] += count
+        table[(a, b)] = result
+        return result
+
+    distribution = frequencies(n1, n2)
+    total = sum(distribution)
+    extreme = min(u, n1 * n2 - u)
+    tail = sum(distribution[:int(math.floor(extreme)) + 1])
+    return min(1.0, 2.0 * tail / total)
+
+
+def mann_whitney_u_test(baseline: list[float], candidate: list[float]) -> float:
+    """Two-sided p-value of the Mann-Whitney U test: exact for small samples
+    without ties, from the normal approximation with the tie and continuity
+    corrections otherwise."""
+    n1, n2 = len(baseline), len(candidate)
+    if n1 == 0 or n2 == 0:
+        return float("nan")
+    ranks, tie_correction = _ranks(baseline + candidate)
+    u = sum(ranks[:n1]) - n1 * (n1 + 1) / 2.0
+    if tie_correction == 0.0 and n1 * n2 <= _EXACT_MANN_WHITNEY_PAIRS:
+        return _exact_mann_whitney_p(u, n1, n2)
+    n = n1 + n2
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_correction / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2.0) - 0.5) / math.sqrt(variance)
+    return min(1.0, 2.0 * _normal_sf(max(z, 0.0)))
+
+
+def cliffs_delta(baseline: list[float], candidate: list[float]) -> float:
+    """P(candidate > baseline) - P(candidate < baseline), from -1 to 1."""
+    if not baseline or not candidate:
+        return float("nan")
+    ranks, _ = _ranks(baseline + candidate)
+    n1, n2 = len(baseline), len(candidate)
+    u_candidate = sum(ranks[n1:]) - n2 * (n2 + 1) / 2.0
+    return 2.0 * u_candidate / (n1 * n2) - 1.0
+
+
+def hedges_g(baseline: list[float], candidate: list[float]) -> float:
+    """Standardized difference of the means, with the small sample correction."""
+    n1, n2 = len(baseline), len(candidate)
+    if n1 < 2 or n2 < 2:
+        return float("nan")
+    mean_a, var_a = _mean_variance(baseline)
+    mean_b, var_b = _mean_variance(candidate)
+    pooled = math.sqrt(((n1 - 1) * var_a + (n2 - 1) * var_b) / (n1 + n2 - 2))
+    if pooled == 0.0:
+        return 0.0 if mean_a == mean_b else math.copysign(math.inf, mean_b - mean_a)
+    return (mean_b - mean_a) / pooled * (1.0 - 3.0 / (4.0 * (n1 + n2) - 9.0))
+
+
+def speedup_interval(baseline: list[float], candidate: list[float], confidence: float = 0.95,
+                     resamples: int = 2000, seed: int = 0) -> tuple[float, float]:
+    """Percentile bootstrap interval of baseline median / candidate median."""
+    rng = random.Random(seed)
+    ratios = []
+    for _ in range(resamples):
+        base = statistics.median(rng.choices(baseline, k=len(baseline)))
+        head = statistics.median(rng.choices(candidate, k=len(candidate)))
+        ratios.append(base / head if head > 0 else math.inf)
+    ratios.sort()
+    tail = (1.0 - confidence) / 2.0
+    return (ratios[int(tail * (resamples - 1))], ratios[int(math.ceil((1.0 - tail) * (resamples - 1)))])
+
+
+def compare_probe(baseline: list[float], candidate: list[float], alpha: float, threshold: float,
+                  test: str = "mann-whitney", confidence: float = 0.95) -> dict:
+    """The comparison of the values of one probe, as a JSON object."""
+    base_median = statistics.median(baseline)
+    head_median = statistics.median(candidate)
+    speedup = base_median / head_median if head_median > 0 else math.inf
+    low, high = speedup_interval(baseline, candidate, confidence)
+    if test == "welch":
+        p_value = welch_t_test(baseline, candidate)
+    else:
+        p_value = mann_whitney_u_test(baseline, candidate)
+
+    significant = not math.isnan(p_value) and p_value < alpha
+    if significant and speedup < 1.0 / (1.0 + threshold):
+        verdict = "regression"
+    elif significant and speedup > 1.0 + threshold:
+        verdict = "improvement"
+    elif math.isnan(p_value):
+        verdict = "insufficient"
+    else:
+        verdict = "unchanged"
+    return {
+        "BaselineMedian": base_median,
+        "CandidateMedian": head_median,
+        "BaselineCount": len(baseline),
+        "CandidateCount": len(candidate),
+        "Speedup": speedup,
+        "SpeedupLower": low,
+        "SpeedupUpper": high,
+        "Test": test,
+        "PValue": p_value,
+        "CliffsDelta": cliffs_delta(baseline, candidate),
+        "HedgesG": hedges_g(baseline, candidate),
+        "Verdict": verdict,
+    }
+
+
+def compare_results(baseline_path: str | Path, candidate_path: str | Path, alpha: float = 0.05,
+                    threshold: float = 0.05, test: str = "mann-whitney",
+                    confidence: float = 0.95) -> dict:
+    """Compare two sets of results; the JSON document of the comparison."""
+    baseline, baseline_noise, baseline_aggregates = load_results(baseline_path)
+    candidate, candidate_noise, candidate_aggregates = load_results(candidate_path)
+    effective_threshold = max(threshold, baseline_noise, candidate_noise)
+    probes = {}
+    for name in sorted(set(baseline) | set(candidate)):
+        if name not in baseline or name not in candidate:
+            probes[name] = {"Verdict": "missing",
+                            "MissingFrom": "candidate" if name in baseline else "baseline"}
+            continue
+        if name in baseline_aggregates or name in candidate_aggregates:
+            probes[name] = {"Verdict": "insufficient",
+                            "AggregatesOnlyIn": "baseline" if name in baseline_aggregates else "candidate"}
+            continue
+        probes[name] = compare_probe(baseline[name], candidate[name], alpha, effective_threshold,
+                                     test, confidence)
+    verdicts = [probe["Verdict"] for probe in probes.values()]
+    return {
+        "Baseline": str(baseline_path),
+        "Candidate": str(candidate_path),
+        "Alpha": alpha,
+        "Threshold": threshold,
+        "NoiseFloor": max(baseline_noise, candidate_noise),
+        "EffectiveThreshold": effective_threshold,
+        "ConfidenceLevel": confidence,
+        "Probes": probes,
+        "Regressions": verdicts.count("regression"),
+        "Improvements": verdicts.count("improvement"),
+    }
+
+
+def format_table(comparison: dict) -> str:
+    """One row per probe, the regressions marked."""
+    probes = comparison["Probes"]
+    width = max([len("Probe")] + [len(name) for name in probes])
+    lines = ["{0:{1}}  {2:>12}  {3:>12}  {4:>22}  {5:>9}  {6:>6}  {7:>7}  Verdict".format(
+        "Probe", width, "Baseline", "Candidate", "Speedup [CI]", "p", "Delta", "g")]
+    for name, probe in probes.items():
+        if probe["Verdict"] == "missing":
+            lines.append("{0:{1}}  missing from the {2}".format(name, width, probe["MissingFrom"]))
+            continue
+        if "AggregatesOnlyIn" in probe:
+            lines.append("{0:{1}}  insufficient data, no values in the {2}".format(
+                name, width, probe["AggregatesOnlyIn"]))
+            continue
+        lines.append("{0:{1}}  {2:>12.6g}  {3:>12.6g}  {4:>22}  {5:>9.3g}  {6:>6.2f}  {7:>7.2f}  {8}".format(
+            name, width, probe["BaselineMedian"], probe["CandidateMedian"],
+            "{0:.3f} [{1:.3f}, {2:.3f}]".format(probe["Speedup"], probe["SpeedupLower"], probe["SpeedupUpper"]),
+            probe["PValue"], probe["CliffsDelta"], probe["HedgesG"],
+            probe["Verdict"].upper() if probe["Verdict"] == "regression" else probe["Verdict"]))
+    lines.append("{0} regression(s), {1} improvement(s); threshold {2:.1%}, alpha {3}".format(
+        comparison["Regressions"], comparison["Improvements"], comparison["EffectiveThreshold"],
+        comparison["Alpha"]))
+    return "\n".join(lines)
+
+
+def add_arguments(parser: argparse.ArgumentParser) -> None:
+    parser.add_argument("baseline", help="JSON result file or directory of the baseline")
+    parser.add_argument("candidate", help="JSON result file or directory to compare with it")
+    parser.add_argument("--alpha", type=float, default=0.05,
+                        help="significance level of the test (default: 0.05)")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="smallest relative slowdown that is a regression (default: 0.05)")
+    parser.add_argument("--test", choices=("mann-whitney", "welch"), default="mann-whitney",
+                        help="significance test (default: mann-whitney)")
+    parser.add_argument("--confidence", type=float, default=0.95,
+                        help="confidence level of the speedup intervals (default: 0.95)")
+    parser.add_argument("--json", metavar="FILE",
+                        help="also write the comparison as JSON, '-' for the standard output")
+
+
+def _without_non_finite(value):
+    """value with its infinite and nan numbers replaced by None, which JSON
+    can represent as null."""
+    if isinstance(value, float) and not math.isfinite(value):
+        return None
+    if isinstance(value, dict):
+        return {key: _without_non_finite(item) for key, item in value.items()}
+    if isinstance(value, (list, tuple)):
+        return [_without_non_finite(item) for item in value]
+    return value
+
+
+def run(args: argparse.Namespace) -> int:
+    """Compare the results of parsed arguments; returns the exit code."""
+    try:
+        comparison = compare_results(args.baseline, args.candidate, args.alpha, args.threshold,
+                                     args.test, args.confidence)
+    except ComparisonError as e:
+        sys.stderr.write(f"{e}\n")
+        return EXIT_ERROR
+    if args.json == "-":
+        json.dump(_without_non_finite(comparison), sys.stdout, indent=2, allow_nan=False)
+        sys.stdout.write("\n")
+    else:
+        print(format_table(comparison))
+        if args.json:
+            with open(args.json, "w") as f:
+                json.dump(_without_non_finite(comparison), f, indent=2, allow_nan=False)
+    return EXIT_REGRESSION if comparison["Regressions"] else EXIT_OK
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(prog="python -m itk_perf_shim.compare",
+                                     description=__doc__.splitlines()[0])
+    add_arguments(parser)
+    return run(parser.parse_args(argv))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,95 @@
+"""Sweep the thread placement policies over the benchmarks.
+
+Each benchmark is run once per policy of
+ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT, which pins the calling thread and
+the workers of ITK's global thread pool to one CPU each:
+
+  None           no pinning, the OS places the threads
+  Compact        one thread per core, filling a last level cache first
+  ScatterCores   one thread per core, alternating between the packages
+  ScatterCaches  one thread per core, alternating between the caches
+  SMTSiblings    all the hardware threads of a core before the next core
+
+The placement only differs when there are fewer threads than CPUs, so the
+sweep sets ITK_GLOBAL_DEFAULT_NUMBER_OF_THREADS; it applies to the
+benchmarks whose registry entry passes -1 threads.
+
+  python -m itk_perf_shim.placement --threads 8 filtering.gradient_magnitude
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import sys
+
+from .registry import BENCHMARKS
+from .runner import default_statistic, run_benchmark
+
+POLICIES = ("None", "Compact", "ScatterCores", "ScatterCaches", "SMTSiblings")
+
+
+def sweep_thread_placement(
+    names: list[str] | None = None,
+    policies: tuple[str, ...] | list[str] = POLICIES,
+    threads: int | None = None,
+    statistic: str | None = None,
+) -> dict[str, dict[str, float]]:
+    """Return {benchmark: {policy: seconds}} for the given benchmarks."""
+    results: dict[str, dict[str, float]] = {}
+    for name in names or sorted(BENCHMARKS):
+        results[name] = {}
+        for policy in policies:
+            environment = {"ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT": policy}
+            if threads:
+                environment["ITK_GLOBAL_DEFAULT_NUMBER_OF_THREADS"] = str(threads)
+            results[name][policy] = run_benchmark(name, statistic, environment=environment)
+    return results
+
+
+def format_table(results: dict[str, dict[str, float]]) -> str:
+    """One row per benchmark, the time of each policy relative to the first
+    one in parentheses and the fastest policy last."""
+    if not results:
+        return ""
+    policies = list(next(iter(results.values())))
+    width = max(len(name) for name in results)
+    lines = ["{0:{1}}  {2}  Fastest".format(
+        "Benchmark", width, "  ".join("{0:>20}".format(p) for p in policies))]
+    for name, timings in results.items():
+        reference = timings[policies[0]]
+        cells = []
+        for policy in policies:
+            seconds = timings[policy]
+            ratio = seconds / reference if reference > 0 else float("nan")
+            cells.append("{0:>20}".format("{0:.4g}s ({1:.2f})".format(seconds, ratio)))
+        fastest = min(timings, key=timings.get)
+        lines.append("{0:{1}}  {2}  {3}".format(name, width, "  ".join(cells), fastest))
+    return "\n".join(lines)
+
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(prog="python -m itk_perf_shim.placement",
+                                     description=__doc__.splitlines()[0])
+    parser.add_argument("names", nargs="*",
+                        help="benchmarks of the registry, all of them by default")
+    parser.add_argument("-p", "--policies", nargs="+", default=list(POLICIES),
+                        help="thread placement policies to compare")
+    parser.add_argument("-t", "--threads", type=int,
+                        help="number of threads, fewer than the CPUs")
+    parser.add_argument("-s", "--statistic",
+                        help="probe statistic, e.g. Mean, Median or Percentile99")
+    parser.add_argument("-o", "--output", help="also write the results as JSON")
+    args = parser.parse_args(argv)
+
+    results = sweep_thread_placement(args.names, args.policies, args.threads, args.statistic)
+    print(format_table(results))
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"Threads": args.threads, "Statistic": args.statistic or default_statistic(),
+                       "Results": results}, f, indent=2)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
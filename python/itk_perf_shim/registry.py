@@ -43,7 +43,7 @@ BENCHMARKS = {
         "exe": "UnaryAddBenchmark",
         "args": [
             "{timings_json}", "{iterations}", "1",
-            "{brain}", "{brain}", "{output_dir}/UnaryAddBenchmark.mha",
+            "{brain}", "{output_dir}/UnaryAddBenchmark.mha",
         ],
         "iterations": 10,
     },
@@ -1,9 +1,11 @@
-"""Invoke a benchmark executable, parse its jsonxx output, return mean seconds.
+"""Invoke a benchmark executable, parse its jsonxx output, return probe seconds.
 
 Environment contract (set by the ASV/GHA caller):
   ITK_BENCHMARK_BIN   — dir containing benchmark executables (required)
   ITK_BENCHMARK_DATA  — ExternalData root holding the BRAIN image fixture (required)
   ITK_BENCHMARK_SCRATCH — scratch dir for output images (optional; tempdir otherwise)
+  ITK_BENCHMARK_STATISTIC — default probe statistic (optional; "Mean" otherwise),
+                          e.g. "Median" to track a robust estimator
 """
 
 from __future__ import annotations
@@ -42,33 +44,79 @@ def _find_exe(bin_dir: Path, exe: str) -> Path:
     raise BenchmarkError(f"Executable {exe!r} not found under {bin_dir}")
 
 
-def _mean_probe_seconds(timings_json: Path) -> float:
-    """Parse HighPriorityRealTimeProbesCollector JSON; average all probes' means.
+# Alternative spellings accepted for a requested probe statistic.
+_STATISTIC_KEYS = {
+    "Mean": ("Mean", "mean", "MeanTime", "Mean (s)"),
+    "Median": ("Median", "Percentile50"),
+}
+
+# The robust estimators of the JSON reports, which a single preemption does
+# not dominate.
+ROBUST_STATISTICS = ("Median", "MedianAbsoluteDeviation", "InterquartileRange",
+                     "MedianConfidenceIntervalLower", "MedianConfidenceIntervalUpper")
+
+
+def default_statistic() -> str:
+    """The statistic returned by run_benchmark when none is requested."""
+    return os.environ.get("ITK_BENCHMARK_STATISTIC") or "Mean"
+
+
+# Suffix of the probes timed after the caches were evicted.
+COLD_PROBE_SUFFIX = " (cold)"
+
+
+def _probe_statistic_seconds(timings_json: Path, statistic: str = "Mean",
+                             cold: bool = False) -> float:
+    """Parse HighPriorityRealTimeProbesCollector JSON; average one statistic over all probes.
 
     The jsonxx output shape (per WriteExpandedReport + JSONReport) is roughly:
-      { "Probes": [ { "Name": "...", "Mean": <sec>, "Min": ..., "Max": ... }, ... ],
+      { "Probes": [ { "Name": "...", "Mean": <sec>, "Minimum": ..., "Maximum": ...,
+                      "Percentile50": ..., "Percentile99": ..., ... }, ... ],
         "SystemInformation": {...}, "ITKBuildInformation": {...}, ... }
-    We reduce to a single scalar per benchmark by averaging probe means, since each
-    C++ benchmark typically has one dominant probe. Multi-probe benchmarks can be
-    parametrized later.
+    ``statistic`` is any per-probe key, e.g. "Mean" or "Percentile99" to track
+    tail latency. We reduce to a single scalar per benchmark by averaging it over
+    the probes, since each C++ benchmark typically has one dominant probe.
+    Multi-probe benchmarks can be parametrized later.
+    With ITKPERFORMANCEBENCHMARK_CACHE_MODE=Both a benchmark reports a warm and
+    a cold probe side by side; ``cold`` selects which of the two is averaged,
+    and BenchmarkError is raised when there is none of them.
     """
     with timings_json.open() as f:
         doc = json.load(f)
     probes = doc.get("Probes") or doc.get("probes") or []
     if not probes:
         raise BenchmarkError(f"No probes in {timings_json}: keys={list(doc)}")
-    means = []
+    probes = [p for p in probes
+              if str(p.get("Name", "")).endswith(COLD_PROBE_SUFFIX) == cold]
+    if not probes:
+        # The other probes measure something else: falling back to them would
+        # report warm times as cold ones, or the reverse.
+        raise BenchmarkError(f"No {'cold' if cold else 'warm'} probes in {timings_json}; "
+                             "is ITKPERFORMANCEBENCHMARK_CACHE_MODE set?")
+    values = []
     for p in probes:
-        for key in ("Mean", "mean", "MeanTime", "Mean (s)"):
+        for key in _STATISTIC_KEYS.get(statistic, (statistic,)):
             if key in p:
-                means.append(float(p[key]))
+                values.append(float(p[key]))
                 break
-    if not means:
-        raise BenchmarkError(f"No Mean field in probes of {timings_json}")
-    return sum(means) / len(means)
+    if not values:
+        raise BenchmarkError(f"No {statistic} field in probes of {timings_json}")
+    return sum(values) / len(values)
+
 
+def run_benchmark(name: str, statistic: str | None = None,
+                  environment: dict[str, str] | None = None,
+                  cache: str | None = None) -> float:
+    """Run one benchmark and return a probe statistic in seconds.
 
-def run_benchmark(name: str) -> float:
+    ``statistic`` is a per-probe key of the JSON report, ITK_BENCHMARK_STATISTIC
+    or "Mean" by default; "Median" is the robust alternative.
+
+    ``environment`` adds variables to the environment of the executable, e.g.
+    ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT to select the thread placement.
+    ``cache`` is "Warm" or "Cold" and sets ITKPERFORMANCEBENCHMARK_CACHE_MODE;
+    the cold iterations evict the caches and the input pages before each run.
+    """
     if name not in BENCHMARKS:
         raise BenchmarkError(f"Unknown benchmark {name!r}")
     spec = BENCHMARKS[name]
@@ -91,10 +139,16 @@ def run_benchmark(name: str) -> float:
     }
     argv = [str(exe)] + [a.format(**subs) for a in spec["args"]]
     try:
-        proc = subprocess.run(argv, capture_output=True, text=True, check=True)
+        proc = subprocess.run(
+            argv, capture_output=True, text=True, check=True,
+            env={**os.environ, **(environment or {}),
+                 **({"ITKPERFORMANCEBENCHMARK_CACHE_MODE": cache} if cache else {})},
+        )
     except subprocess.CalledProcessError as e:
         raise BenchmarkError(
             f"{name} failed (rc={e.returncode}):\nstdout={e.stdout}\nstderr={e.stderr}"
         ) from e
     _ = proc  # stdout contains the human-readable report; we parse the JSON file
-    return _mean_probe_seconds(timings_json)
+    statistic = statistic or default_statistic()
+    cold = (cache or "").lower() == "cold"
+    return _probe_statistic_seconds(timings_json, statistic, cold)
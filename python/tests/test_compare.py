@@ -0,0 +1,81 @@
+"""Known-answer tests of the statistics and the exit codes of compare.
+
+  cd python && python -m unittest discover -s tests
+"""
+
+from __future__ import annotations
+
+import contextlib
+import io
+import json
+import math
+import tempfile
+import unittest
+from pathlib import Path
+
+from itk_perf_shim import compare
+
+
+def _write_results(directory: Path, values: list[float]) -> None:
+    directory.mkdir()
+    document = {"Probes": [{"Name": "Filter", "Values": values, "WarmUpIterations": 0}]}
+    (directory / "results.json").write_text(json.dumps(document))
+
+
+class StatisticsTest(unittest.TestCase):
+    def test_mann_whitney_exact(self):
+        # U = 0 is one of the C(6, 3) = 20 orders, on each side.
+        self.assertAlmostEqual(compare.mann_whitney_u_test([1, 2, 3], [4, 5, 6]), 2 / 20)
+        self.assertAlmostEqual(compare.mann_whitney_u_test([1, 2, 3, 4, 5], [6, 7, 8, 9, 10]), 2 / 252)
+        self.assertAlmostEqual(compare.mann_whitney_u_test([4, 5, 6], [1, 2, 3]), 2 / 20)
+
+    def test_mann_whitney_ties(self):
+        # The mid-ranks give U = 5 of 36, the ties sum(t^3 - t) = 42, so
+        # z = (18 - 5 - 0.5) / sqrt(36 / 12 * (13 - 42 / 132)).
+        z = 12.5 / math.sqrt(3.0 * (13.0 - 42.0 / 132.0))
+        self.assertAlmostEqual(compare.mann_whitney_u_test([1, 2, 2, 3, 4, 5], [3, 4, 5, 5, 6, 7]),
+                               math.erfc(z / math.sqrt(2.0)))
+        self.assertEqual(compare.mann_whitney_u_test([1, 1, 1], [1, 1, 1]), 1.0)
+
+    def test_welch(self):
+        # t = 3 / sqrt(2 / 3) with 4 degrees of freedom, and t = 3 / sqrt(2.5)
+        # with 5.88, p from a numerical integration of Student's t density.
+        self.assertAlmostEqual(compare.welch_t_test([1, 2, 3], [4, 5, 6]), 0.0213116411, places=8)
+        self.assertAlmostEqual(compare.welch_t_test([1, 2, 3, 4, 5], [2, 4, 6, 8, 10]), 0.1075311949, places=8)
+        self.assertTrue(math.isnan(compare.welch_t_test([1], [2, 3])))
+
+    def test_cliffs_delta(self):
+        self.assertEqual(compare.cliffs_delta([1, 2, 3], [4, 5, 6]), 1.0)
+        self.assertEqual(compare.cliffs_delta([4, 5, 6], [1, 2, 3]), -1.0)
+        # 3 is above 2 values and below 1 of the baseline, 5 above all 4.
+        self.assertAlmostEqual(compare.cliffs_delta([1, 2, 3, 4], [3, 5]), 5 / 8)
+
+    def test_hedges_g(self):
+        # A difference of 3 standard deviations, times 1 - 3 / (4 * 6 - 9).
+        self.assertAlmostEqual(compare.hedges_g([1, 2, 3], [4, 5, 6]), 2.4)
+        self.assertAlmostEqual(compare.hedges_g([4, 5, 6], [1, 2, 3]), -2.4)
+        self.assertEqual(compare.hedges_g([1, 1], [1, 1]), 0.0)
+
+
+class ExitCodeTest(unittest.TestCase):
+    def _run(self, baseline: list[float] | None, candidate: list[float]) -> int:
+        with tempfile.TemporaryDirectory() as directory:
+            baseline_path = Path(directory) / "baseline"
+            candidate_path = Path(directory) / "candidate"
+            if baseline is not None:
+                _write_results(baseline_path, baseline)
+            _write_results(candidate_path, candidate)
+            with contextlib.redirect_stdout(io.StringIO()), contextlib.redirect_stderr(io.StringIO()):
+                return compare.main([str(baseline_path), str(candidate_path)])
+
+    def test_exit_codes(self):
+        values = [1.0 + 0.01 * i for i in range(20)]
+        self.assertEqual(self._run(values, values), compare.EXIT_OK)
+        self.assertEqual(self._run(values, [1.5 * value for value in values]), compare.EXIT_REGRESSION)
+        self.assertEqual(self._run(values, [value / 1.5 for value in values]), compare.EXIT_OK)
+        self.assertEqual(self._run(None, values), compare.EXIT_ERROR)
+        self.assertEqual((compare.EXIT_OK, compare.EXIT_REGRESSION, compare.EXIT_ERROR), (0, 1, 2))
+
+
+if __name__ == "__main__":
+    unittest.main()
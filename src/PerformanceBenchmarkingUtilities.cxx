@@ -17,10 +17,25 @@
  *=========================================================================*/
 #include "PerformanceBenchmarkingInformation.h"
 #include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkExecutionContext.h"
+#include "itkBenchmarkLoopDriver.h"
+#include "itkBenchmarkNoiseFloor.h"
+#include "itkBenchmarkSystemInformation.h"
+#include <itksys/CommandLineArguments.hxx>
+#include <itksys/SystemInformation.hxx>
 #include <itksys/SystemTools.hxx>
+#if ITK_VERSION_MAJOR >= 5 && !defined(ITK_USES_NUMBEROFTHREADS)
+#  include "itkThreadPool.h"
+#endif
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <ostream>
 #include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
 
 /**  Decorate with json from an environmental variable
  *
@@ -58,6 +73,138 @@ getEnvJsonMap()
 }
 
 
+/** The JSON object of the last pre-flight noise check, empty if it did not run. */
+static std::string &
+GetPreflightJson()
+{
+  static std::string preflightJson;
+  return preflightJson;
+}
+
+
+/** The iteration control of each probe timed by TimeIterations(). */
+static jsonxx::Object &
+GetIterationControlJson()
+{
+  static jsonxx::Object iterationControlJson;
+  return iterationControlJson;
+}
+
+
+/** The paired comparison of the variants timed by TimeVariants(). */
+static jsonxx::Object &
+GetVariantComparisonJson()
+{
+  static jsonxx::Object variantComparisonJson;
+  return variantComparisonJson;
+}
+
+
+/** The JSON report of the probes of the last WriteExpandedReport(). */
+static std::string &
+GetLastProbesJson()
+{
+  static std::string lastProbesJson;
+  return lastProbesJson;
+}
+
+
+static std::string
+GetEnvUpperCase(const char * name)
+{
+  const char * value = itksys::SystemTools::GetEnv(name);
+  std::string  upperCaseValue(value != nullptr ? value : "");
+  std::transform(upperCaseValue.begin(), upperCaseValue.end(), upperCaseValue.begin(), [](unsigned char c) {
+    return static_cast<char>(std::toupper(c));
+  });
+  return upperCaseValue;
+}
+
+
+/** Whether a variable is set to something else than 0, Off or False;
+ * defaultValue when it is not set. */
+static bool
+GetEnvFlag(const char * name, bool defaultValue)
+{
+  const std::string value = GetEnvUpperCase(name);
+  if (value.empty())
+  {
+    return defaultValue;
+  }
+  return value != "0" && value != "OFF" && value != "FALSE" && value != "NO";
+}
+
+
+static double
+GetEnvNumber(const char * name, double defaultValue)
+{
+  const char * value = itksys::SystemTools::GetEnv(name);
+  if (value != nullptr)
+  {
+    try
+    {
+      return std::stod(value);
+    }
+    catch (const std::exception &)
+    {
+      std::cerr << "Invalid " << name << ": " << value << std::endl;
+    }
+  }
+  return defaultValue;
+}
+
+
+/** The options of the benchmark being run. */
+static BenchmarkOptions &
+GetCurrentBenchmarkOptions()
+{
+  static BenchmarkOptions options;
+  return options;
+}
+
+
+/** Parses the whole of a value; false when it is not a T. */
+template <typename T>
+static bool
+ParseOptionValue(const std::string & value, T & result)
+{
+  std::istringstream stream(value);
+  T                  parsed{};
+  if (!(stream >> parsed) || !(stream >> std::ws).eof())
+  {
+    return false;
+  }
+  result = parsed;
+  return true;
+}
+
+
+/** Parses a size such as 128, 64,64,32 or 64x64x32. */
+static bool
+ParseSizeOptionValue(std::string value, std::vector<unsigned int> & size)
+{
+  std::replace(value.begin(), value.end(), ',', ' ');
+  std::replace(value.begin(), value.end(), 'x', ' ');
+  std::istringstream        stream(value);
+  std::vector<unsigned int> parsed;
+  int                       extent = 0;
+  while (stream >> extent)
+  {
+    if (extent < 1)
+    {
+      return false;
+    }
+    parsed.push_back(static_cast<unsigned int>(extent));
+  }
+  if (parsed.empty() || !(stream >> std::ws).eof())
+  {
+    return false;
+  }
+  size = parsed;
+  return true;
+}
+
+
 static std::string
 PerformanceGuessGitHash()
 {
@@ -119,12 +266,14 @@ WriteExpandedReport(const std::string &                        timingsFileName,
                     bool                                       printReportHead,
                     bool                                       useTabs)
 {
+  collector.SetExcludeWarmUp(GetEnvFlag("ITKPERFORMANCEBENCHMARK_EXCLUDE_WARMUP", true));
   collector.Report(std::cout, printSystemInfo, printReportHead, useTabs);
-  std::ofstream timingsFile(timingsFileName, std::ios_base::out);
-  if (timingsFileName.find(".json"))
+  std::ofstream     timingsFile(timingsFileName, std::ios_base::out);
+  std::stringstream probejsonstream;
+  collector.JSONReport(probejsonstream, printSystemInfo);
+  GetLastProbesJson() = probejsonstream.str();
+  if (GetBenchmarkOptions().m_Format == BenchmarkOptions::FormatEnum::JSON)
   {
-    std::stringstream probejsonstream;
-    collector.JSONReport(probejsonstream, printSystemInfo);
     const std::string finalJsonString = DecorateWithBuildInformation(probejsonstream.str());
     timingsFile << finalJsonString;
   }
@@ -136,6 +285,10 @@ WriteExpandedReport(const std::string &                        timingsFileName,
     collector.ExpandedReport(timingsFile, printSystemInfo, printReportHead, useTabs);
   }
   timingsFile.close();
+  // The iteration control and the variant comparisons belong to this report,
+  // not to the next benchmark run by the same process.
+  GetIterationControlJson().reset();
+  GetVariantComparisonJson().reset();
 }
 
 std::string
@@ -191,6 +344,23 @@ DecorateWithBuildInformation(std::string inputJson)
     runTimeEnvJsonObject << "ReportWritingLoadAverage" << loadAverage;
     o << "RunTimeInformation" << runTimeEnvJsonObject;
   }
+  if (!GetPreflightJson().empty())
+  {
+    // The load and the noise measured before the benchmark ran.
+    jsonxx::Object noiseFloorObject;
+    noiseFloorObject.parse(GetPreflightJson());
+    o << "NoiseFloor" << noiseFloorObject;
+  }
+  if (!GetIterationControlJson().empty())
+  {
+    // How many iterations each probe ran, and why it stopped.
+    o << "IterationControl" << GetIterationControlJson();
+  }
+  if (!GetVariantComparisonJson().empty())
+  {
+    // How the variants of each comparison performed relative to each other.
+    o << "VariantComparison" << GetVariantComparisonJson();
+  }
   {
     jsonxx::Object auxEnvironmentObject;
     auxEnvironmentObject.parse(getEnvJsonMap());
@@ -204,3 +374,527 @@ DecorateWithBuildInformation(std::string inputJson)
   // std::cout << o.json() << std::endl;
   return o.json();
 }
+
+
+bool
+RunBenchmarkPreflight()
+{
+  std::string       mode = "Warn";
+  const std::string upperCaseValue = GetEnvUpperCase("ITKPERFORMANCEBENCHMARK_PREFLIGHT");
+  if (!upperCaseValue.empty())
+  {
+    if (upperCaseValue == "OFF" || upperCaseValue == "0" || upperCaseValue == "FALSE" || upperCaseValue == "NO")
+    {
+      return true;
+    }
+    if (upperCaseValue == "WAIT")
+    {
+      mode = "Wait";
+    }
+    else if (upperCaseValue == "REFUSE")
+    {
+      mode = "Refuse";
+    }
+    else if (upperCaseValue != "WARN" && upperCaseValue != "ON")
+    {
+      std::cerr << "Unknown ITKPERFORMANCEBENCHMARK_PREFLIGHT mode: " << upperCaseValue << std::endl;
+    }
+  }
+  const double maximumNoiseFloor = GetEnvNumber("ITKPERFORMANCEBENCHMARK_NOISE_THRESHOLD", 0.02);
+  const double timeout = GetEnvNumber("ITKPERFORMANCEBENCHMARK_PREFLIGHT_TIMEOUT", 60.0);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const auto getWaitTime = [startTime]() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  };
+  // The noise floor is measured in the execution context of the benchmarks:
+  // on their CPUs, at their priority.
+  const itk::BenchmarkNoiseFloor noiseFloor = [&]() {
+    const itk::BenchmarkExecutionContext::Guard executionContext;
+    itk::BenchmarkNoiseFloor                    measured = itk::BenchmarkNoiseFloor::Measure();
+    while (mode == "Wait" && !measured.GetIssues(maximumNoiseFloor).empty() && getWaitTime() < timeout)
+    {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      measured = itk::BenchmarkNoiseFloor::Measure();
+    }
+    return measured;
+  }();
+  const double waitTime = getWaitTime();
+
+  for (const std::string & warning : noiseFloor.GetConfigurationWarnings())
+  {
+    std::cerr << "Warning: " << warning << std::endl;
+  }
+  const std::vector<std::string> issues = noiseFloor.GetIssues(maximumNoiseFloor);
+  for (const std::string & issue : issues)
+  {
+    std::cerr << "Warning: " << issue << std::endl;
+  }
+
+  std::stringstream noiseFloorJson;
+  noiseFloor.PrintJSON(noiseFloorJson, maximumNoiseFloor);
+  jsonxx::Object preflightObject;
+  preflightObject.parse(noiseFloorJson.str());
+  preflightObject << "PreflightMode" << mode;
+  preflightObject << "PreflightWaitTime" << waitTime;
+  GetPreflightJson() = preflightObject.json();
+
+  if (mode == "Refuse" && !issues.empty())
+  {
+    std::cerr << "The machine is too noisy to benchmark, set ITKPERFORMANCEBENCHMARK_PREFLIGHT=Warn to run anyway"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+
+bool
+ParseBenchmarkOptions(int                              argc,
+                      char *                           argv[],
+                      const std::vector<std::string> & positionalNames,
+                      BenchmarkOptions &               options)
+{
+  std::string iterations;
+  std::string threads;
+  std::string minimumTime;
+  std::string warmUpIterations;
+  std::string clock;
+  std::string pin;
+  std::string format;
+  std::string size;
+
+  itksys::CommandLineArguments arguments;
+  arguments.Initialize(argc, argv);
+  arguments.StoreUnusedArguments(true);
+  arguments.AddArgument("--iterations",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &iterations,
+                        "number of iterations, the minimum of the benchmark loops");
+  arguments.AddArgument("--threads",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &threads,
+                        "number of threads, the ITK default when not positive");
+  arguments.AddArgument("--min-time",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &minimumTime,
+                        "seconds each benchmark loop runs at least");
+  arguments.AddArgument("--warmup",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &warmUpIterations,
+                        "untimed runs before the timed ones");
+  arguments.AddArgument("--clock",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &clock,
+                        "clock of the probes: RealTimeClock, Monotonic, MonotonicRaw or InvariantTSC");
+  arguments.AddArgument("--pin",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &pin,
+                        "thread placement policy, e.g. Compact, or CPU list, e.g. 0-3,8");
+  arguments.AddArgument(
+    "--format", itksys::CommandLineArguments::SPACE_ARGUMENT, &format, "format of the timings file: JSON or Text");
+  arguments.AddArgument("--size",
+                        itksys::CommandLineArguments::SPACE_ARGUMENT,
+                        &size,
+                        "size of the generated inputs, e.g. 128 or 64,64,32");
+
+  const auto printUsage = [&arguments, &positionalNames, argv](const std::string & error) {
+    std::cerr << error << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << argv[0] << " [options]";
+    for (const auto & name : positionalNames)
+    {
+      std::cerr << " " << name;
+    }
+    std::cerr << std::endl << arguments.GetHelp() << std::endl;
+    return false;
+  };
+  if (!arguments.Parse())
+  {
+    return printUsage("Invalid options");
+  }
+
+  // The unused arguments are the positional ones, after the program name.
+  int     unusedArgc = 0;
+  char ** unusedArgv = nullptr;
+  arguments.GetUnusedArguments(&unusedArgc, &unusedArgv);
+  const std::vector<std::string> positional(unusedArgv + std::min(unusedArgc, 1), unusedArgv + unusedArgc);
+  arguments.DeleteRemainingArguments(unusedArgc, &unusedArgv);
+
+  size_t next = 0;
+  for (const auto & slot : positionalNames)
+  {
+    if (slot == "...")
+    {
+      options.m_RemainingArguments.assign(positional.begin() + next, positional.end());
+      next = positional.size();
+      break;
+    }
+    const bool        optional = slot.size() > 2 && slot.front() == '[' && slot.back() == ']';
+    const std::string name = optional ? slot.substr(1, slot.size() - 2) : slot;
+    std::string *     option = nullptr;
+    if (name == "iterations")
+    {
+      option = &iterations;
+    }
+    else if (name == "threads")
+    {
+      option = &threads;
+    }
+    else if (name == "size")
+    {
+      option = &size;
+    }
+    if (option != nullptr && !option->empty())
+    {
+      // Given as an option, the slot is skipped.
+      continue;
+    }
+    if (next == positional.size())
+    {
+      if (optional)
+      {
+        continue;
+      }
+      return printUsage("Missing " + name);
+    }
+    const std::string & value = positional[next++];
+    if (option != nullptr)
+    {
+      *option = value;
+    }
+    else if (name == "timingsFile")
+    {
+      options.m_TimingsFileName = value;
+    }
+    else
+    {
+      options.m_Arguments[name] = value;
+    }
+  }
+  if (next < positional.size())
+  {
+    return printUsage("Unexpected argument: " + positional[next]);
+  }
+
+  if (!iterations.empty() && (!ParseOptionValue(iterations, options.m_Iterations) || options.m_Iterations < 1))
+  {
+    return printUsage("Invalid iterations: " + iterations);
+  }
+  if (!threads.empty() && !ParseOptionValue(threads, options.m_Threads))
+  {
+    return printUsage("Invalid threads: " + threads);
+  }
+  if (!minimumTime.empty() && (!ParseOptionValue(minimumTime, options.m_MinimumTime) || options.m_MinimumTime < 0.0))
+  {
+    return printUsage("Invalid minimum time: " + minimumTime);
+  }
+  if (!warmUpIterations.empty() &&
+      (!ParseOptionValue(warmUpIterations, options.m_WarmUpIterations) || options.m_WarmUpIterations < 0))
+  {
+    return printUsage("Invalid warm-up iterations: " + warmUpIterations);
+  }
+  if (!clock.empty() && !itk::BenchmarkClockSource::FromString(clock, options.m_ClockSource))
+  {
+    return printUsage("Unknown clock: " + clock);
+  }
+  if (!format.empty())
+  {
+    std::transform(format.begin(), format.end(), format.begin(), [](unsigned char c) {
+      return static_cast<char>(std::toupper(c));
+    });
+    if (format == "JSON")
+    {
+      options.m_Format = BenchmarkOptions::FormatEnum::JSON;
+    }
+    else if (format == "TEXT")
+    {
+      options.m_Format = BenchmarkOptions::FormatEnum::Text;
+    }
+    else
+    {
+      return printUsage("Unknown format: " + format);
+    }
+  }
+  if (!size.empty() && !ParseSizeOptionValue(size, options.m_Size))
+  {
+    return printUsage("Invalid size: " + size);
+  }
+  // A size sweep of the runner sets the size of every benchmark it runs.
+  const char * sweptSize = itksys::SystemTools::GetEnv("ITKPERFORMANCEBENCHMARK_SIZE");
+  if (sweptSize != nullptr && *sweptSize != '\0' && !ParseSizeOptionValue(sweptSize, options.m_Size))
+  {
+    return printUsage(std::string("Invalid ITKPERFORMANCEBENCHMARK_SIZE: ") + sweptSize);
+  }
+  // The threads are placed by the option of each benchmark of the process,
+  // e.g. of the runner, or by the environment without it. A policy places
+  // them on the CPUs the process may run on, and a CPU list restricts them.
+  const itk::BenchmarkExecutionContext::Settings defaults = itk::BenchmarkExecutionContext::GetEnvironmentSettings();
+  itk::BenchmarkExecutionContext::Settings       settings = itk::BenchmarkExecutionContext::GetSettings();
+  std::vector<unsigned int>                      cpuAffinity = defaults.m_CPUAffinity;
+  auto                                           threadPlacement = defaults.m_ThreadPlacement;
+  if (!pin.empty() && !itk::BenchmarkThreadPlacement::FromString(pin, threadPlacement))
+  {
+    cpuAffinity = itk::BenchmarkSystemInformation::ParseCPUList(pin);
+    if (cpuAffinity.empty())
+    {
+      return printUsage("Unknown thread placement policy or CPU list: " + pin);
+    }
+  }
+  options.m_Pin = pin;
+  if (settings.m_CPUAffinity != cpuAffinity || settings.m_ThreadPlacement != threadPlacement)
+  {
+    settings.m_CPUAffinity = cpuAffinity;
+    settings.m_ThreadPlacement = threadPlacement;
+    itk::BenchmarkExecutionContext::SetSettings(settings);
+  }
+
+  options.m_TimingsFileName = ReplaceOccurrence(options.m_TimingsFileName, "__DATESTAMP__", PerfDateStamp());
+  GetCurrentBenchmarkOptions() = options;
+  return true;
+}
+
+
+const BenchmarkOptions &
+GetBenchmarkOptions()
+{
+  return GetCurrentBenchmarkOptions();
+}
+
+
+void
+SetUpBenchmarkCollector(itk::HighPriorityRealTimeProbesCollector & collector)
+{
+  // Selecting a clock calibrates the probe overhead again.
+  if (collector.GetClockSource() != GetBenchmarkOptions().m_ClockSource)
+  {
+    collector.SetClockSource(GetBenchmarkOptions().m_ClockSource);
+  }
+}
+
+
+const std::string &
+GetLastBenchmarkReport()
+{
+  return GetLastProbesJson();
+}
+
+
+bool
+SetUpBenchmarkEnvironment(int threads)
+{
+  // A thread scaling sweep overrides the threads of the command line.
+  const double sweptThreads = GetEnvNumber("ITKPERFORMANCEBENCHMARK_THREADS", 0.0);
+  if (sweptThreads >= 1.0)
+  {
+    threads = static_cast<int>(sweptThreads);
+  }
+  if (threads > 0)
+  {
+    MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+  }
+#if ITK_VERSION_MAJOR >= 5 && !defined(ITK_USES_NUMBEROFTHREADS)
+  // The pool creates its workers on first use, with the global default
+  // number of threads, and adds workers when a filter uses more. They are
+  // all created now, so that the execution context places them when it is
+  // acquired, and placed again if it is already held.
+  if (itk::MultiThreaderBase::GetGlobalDefaultThreader() == itk::MultiThreaderBase::ThreaderEnum::Pool)
+  {
+    const itk::ThreadPool::Pointer pool = itk::ThreadPool::GetInstance();
+    const itk::ThreadIdType        poolThreads = pool->GetMaximumNumberOfThreads();
+    const itk::ThreadIdType        requestedThreads = MultiThreaderName::GetGlobalDefaultNumberOfThreads();
+    if (poolThreads < requestedThreads)
+    {
+      pool->AddThreads(requestedThreads - poolThreads);
+    }
+  }
+#endif
+  itk::BenchmarkExecutionContext::Reapply();
+  return RunBenchmarkPreflight();
+}
+
+
+itk::BenchmarkLoopDriver
+CreateBenchmarkLoopDriver(int iterations)
+{
+  // The iterations argument is the minimum, and the maximum unless the
+  // iterations are adaptive.
+  const double targetRelativeHalfWidth = GetEnvNumber("ITKPERFORMANCEBENCHMARK_TARGET_CI", 0.0);
+  const double timeBudget = GetEnvNumber("ITKPERFORMANCEBENCHMARK_TIME_BUDGET", 0.0);
+  const double minimumTime = GetBenchmarkOptions().m_MinimumTime;
+  const bool   adaptive = targetRelativeHalfWidth > 0.0 || timeBudget > 0.0 || minimumTime > 0.0;
+  const double minimumIterations = GetEnvNumber("ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS", iterations);
+  const double maximumIterations =
+    GetEnvNumber("ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS", adaptive ? std::max(iterations, 1000) : iterations);
+  return itk::BenchmarkLoopDriver(static_cast<itk::SizeValueType>(std::max(minimumIterations, 1.0)),
+                                  static_cast<itk::SizeValueType>(std::max(maximumIterations, 1.0)),
+                                  timeBudget,
+                                  targetRelativeHalfWidth,
+                                  minimumTime);
+}
+
+
+void
+AddIterationControlToReport(const std::string & probeName, const itk::BenchmarkLoopDriver & driver)
+{
+  std::ostringstream driverJson;
+  driver.PrintJSON(driverJson);
+  jsonxx::Object driverObject;
+  driverObject.parse(driverJson.str());
+  GetIterationControlJson() << probeName << driverObject;
+  if (driver.GetTimeBudget() > 0.0 || driver.GetTargetRelativeHalfWidth() > 0.0 || driver.GetMinimumTime() > 0.0)
+  {
+    std::cout << probeName << ": " << driver.GetIterations() << " iterations, stopped by "
+              << driver.GetStoppingReason() << std::endl;
+  }
+}
+
+
+void
+TimeIterations(itk::HighPriorityRealTimeProbesCollector &                       collector,
+               const std::string &                                              probeName,
+               int                                                              iterations,
+               const std::function<void()> &                                    prepare,
+               const std::function<void()> &                                    run,
+               const std::vector<itk::BenchmarkCacheEvictor::MemoryRangeType> & inputs,
+               const BenchmarkWorkload &                                        workload)
+{
+  const std::string mode = GetEnvUpperCase("ITKPERFORMANCEBENCHMARK_CACHE_MODE");
+  if (!mode.empty() && mode != "WARM" && mode != "COLD" && mode != "BOTH")
+  {
+    std::cerr << "Unknown ITKPERFORMANCEBENCHMARK_CACHE_MODE: " << mode << std::endl;
+  }
+  const bool warm = mode != "COLD";
+  const bool cold = mode == "COLD" || mode == "BOTH";
+
+  SetUpBenchmarkCollector(collector);
+  for (int ii = 0; ii < GetBenchmarkOptions().m_WarmUpIterations; ++ii)
+  {
+    prepare();
+    run();
+  }
+
+  itk::BenchmarkLoopDriver warmDriver = CreateBenchmarkLoopDriver(iterations);
+  itk::BenchmarkLoopDriver coldDriver(warmDriver);
+
+  using ProbeHandleType = itk::HighPriorityRealTimeProbesCollector::ProbeHandleType;
+  ProbeHandleType                             warmProbe{};
+  ProbeHandleType                             coldProbe{};
+  std::unique_ptr<itk::BenchmarkCacheEvictor> evictor;
+  if (warm)
+  {
+    warmProbe = collector.GetProbeHandle(probeName.c_str());
+    collector.SetWorkload(probeName.c_str(), workload.m_Voxels, workload.m_Bytes);
+  }
+  if (cold)
+  {
+    coldProbe = collector.GetProbeHandle((probeName + " (cold)").c_str());
+    collector.SetWorkload((probeName + " (cold)").c_str(), workload.m_Voxels, workload.m_Bytes);
+    evictor = std::make_unique<itk::BenchmarkCacheEvictor>();
+    evictor->SetPageOut(GetEnvFlag("ITKPERFORMANCEBENCHMARK_PAGE_OUT", false));
+  }
+
+  // The time of an iteration, after the overhead correction of the probe.
+  const auto timeIteration = [&collector, &run](ProbeHandleType probe) {
+    const double total = collector.GetProbe(probe).GetTotal();
+    collector.Start(probe);
+    run();
+    collector.Stop(probe);
+    return collector.GetProbe(probe).GetTotal() - total;
+  };
+  for (;;)
+  {
+    // In Both mode, each mode stops on its own, and the budget is shared.
+    const bool runWarm = warm && warmDriver.Continue();
+    const bool runCold = cold && coldDriver.Continue();
+    if (!runWarm && !runCold)
+    {
+      break;
+    }
+    if (runWarm)
+    {
+      prepare();
+      warmDriver.AddSample(timeIteration(warmProbe));
+    }
+    if (runCold)
+    {
+      prepare();
+      evictor->Evict(inputs);
+      coldDriver.AddSample(timeIteration(coldProbe));
+    }
+  }
+
+  if (warm)
+  {
+    AddIterationControlToReport(probeName, warmDriver);
+  }
+  if (cold)
+  {
+    AddIterationControlToReport(probeName + " (cold)", coldDriver);
+  }
+}
+
+
+void
+TimeVariants(itk::HighPriorityRealTimeProbesCollector & collector,
+             const std::string &                        comparisonName,
+             const std::vector<BenchmarkVariantType> &  variants,
+             int                                        iterations,
+             const BenchmarkWorkload &                  workload)
+{
+  if (variants.empty())
+  {
+    return;
+  }
+  const auto seed = static_cast<uint32_t>(GetEnvNumber("ITKPERFORMANCEBENCHMARK_VARIANT_SEED", 0.0));
+  itk::BenchmarkVariantScheduler scheduler(static_cast<unsigned int>(variants.size()), seed);
+  itk::BenchmarkLoopDriver       driver = CreateBenchmarkLoopDriver(iterations);
+
+  SetUpBenchmarkCollector(collector);
+
+  using ProbeHandleType = itk::HighPriorityRealTimeProbesCollector::ProbeHandleType;
+  std::vector<ProbeHandleType> probes;
+  std::vector<std::string>     names;
+  const int                    warmUpIterations = std::max(GetBenchmarkOptions().m_WarmUpIterations, 1);
+  for (const auto & variant : variants)
+  {
+    probes.push_back(collector.GetProbeHandle(variant.first.c_str()));
+    collector.SetWorkload(variant.first.c_str(), workload.m_Voxels, workload.m_Bytes);
+    names.push_back(variant.first);
+    for (int ii = 0; ii < warmUpIterations; ++ii)
+    {
+      variant.second();
+    }
+  }
+
+  while (driver.Continue())
+  {
+    double blockTime = 0.0;
+    for (const unsigned int variant : scheduler.NextBlock())
+    {
+      // The time of an iteration, after the overhead correction of the probe.
+      const double total = collector.GetProbe(probes[variant]).GetTotal();
+      collector.Start(probes[variant]);
+      variants[variant].second();
+      collector.Stop(probes[variant]);
+      const double seconds = collector.GetProbe(probes[variant]).GetTotal() - total;
+      scheduler.AddSample(variant, seconds);
+      blockTime += seconds;
+    }
+    driver.AddSample(blockTime);
+  }
+
+  AddIterationControlToReport(comparisonName, driver);
+  std::ostringstream schedulerJson;
+  scheduler.PrintJSON(schedulerJson, names);
+  jsonxx::Object schedulerObject;
+  schedulerObject.parse(schedulerJson.str());
+  GetVariantComparisonJson() << comparisonName << schedulerObject;
+  for (unsigned int variant = 1; variant < variants.size(); ++variant)
+  {
+    const itk::BenchmarkRobustStatistics ratios = scheduler.GetPairedRatioStatistics(variant, 0);
+    std::cout << names[variant] << " / " << names[0] << ": " << ratios.GetMedian() << " ["
+              << ratios.GetMedianConfidenceInterval().first << ", " << ratios.GetMedianConfidenceInterval().second
+              << "]" << std::endl;
+  }
+}
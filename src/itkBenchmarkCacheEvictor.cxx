@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkCacheEvictor.h"
+#include "itkBenchmarkSystemInformation.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#  include <emmintrin.h>
+#  define ITK_BENCHMARK_HAS_CLFLUSH
+#endif
+#if defined(__linux__)
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+
+/** Keeps the compiler from removing the reads of the buffer. */
+volatile unsigned char evictionSink = 0;
+
+} // namespace
+
+
+BenchmarkCacheEvictor::BenchmarkCacheEvictor(size_t bufferSize)
+{
+  if (bufferSize == 0)
+  {
+    SizeValueType lastLevelCacheSize = 0;
+    for (const auto & cache : BenchmarkSystemInformation::GetInstance().GetCaches())
+    {
+      lastLevelCacheSize = std::max(lastLevelCacheSize, cache.m_Size);
+      if (cache.m_LineSize > 0)
+      {
+        this->m_LineSize = cache.m_LineSize;
+      }
+    }
+    bufferSize = std::max(static_cast<size_t>(4 * lastLevelCacheSize), size_t{ 32 } << 20);
+  }
+  // Touch the pages once, so that evicting does not fault them in.
+  this->m_Buffer.assign(bufferSize, 1);
+}
+
+
+void
+BenchmarkCacheEvictor::Evict(const std::vector<MemoryRangeType> & ranges)
+{
+  unsigned char * buffer = this->m_Buffer.data();
+  unsigned char   sum = 0;
+  for (size_t ii = 0; ii < this->m_Buffer.size(); ii += this->m_LineSize)
+  {
+    buffer[ii] = static_cast<unsigned char>(buffer[ii] + 1);
+  }
+  for (size_t ii = 0; ii < this->m_Buffer.size(); ii += this->m_LineSize)
+  {
+    sum = static_cast<unsigned char>(sum + buffer[ii]);
+  }
+  evictionSink = sum;
+
+  for (const MemoryRangeType & range : ranges)
+  {
+    if (range.first == nullptr || range.second == 0)
+    {
+      continue;
+    }
+#if defined(ITK_BENCHMARK_HAS_CLFLUSH)
+    const auto * begin = static_cast<const char *>(range.first);
+    for (size_t offset = 0; offset < range.second; offset += this->m_LineSize)
+    {
+      _mm_clflush(begin + offset);
+    }
+    _mm_clflush(begin + range.second - 1);
+#endif
+#if defined(__linux__) && defined(MADV_PAGEOUT)
+    if (this->m_PageOut)
+    {
+      // madvise() requires the start of a page.
+      const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+      const auto start = reinterpret_cast<uintptr_t>(range.first);
+      const auto alignedStart = start - start % pageSize;
+      madvise(reinterpret_cast<void *>(alignedStart), range.second + (start - alignedStart), MADV_PAGEOUT);
+    }
+#endif
+  }
+#if defined(ITK_BENCHMARK_HAS_CLFLUSH)
+  _mm_mfence();
+#endif
+}
+
+
+bool
+BenchmarkCacheEvictor::IsFlushAvailable()
+{
+#if defined(ITK_BENCHMARK_HAS_CLFLUSH)
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+bool
+BenchmarkCacheEvictor::IsPageOutAvailable()
+{
+#if defined(__linux__) && defined(MADV_PAGEOUT)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // end namespace itk
@@ -0,0 +1,311 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkClockSource.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+#if defined(_WIN32)
+#  include <intrin.h>
+#else
+#  include <ctime>
+#  if defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#    include <x86intrin.h>
+#  endif
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#  define ITK_BENCHMARK_HAS_TSC
+#endif
+
+namespace itk
+{
+namespace
+{
+
+using TimeStampType = BenchmarkClockSource::TimeStampType;
+
+#if defined(CLOCK_MONOTONIC_RAW)
+TimeStampType
+ReadPOSIXClock(clockid_t clockId)
+{
+  timespec now;
+  clock_gettime(clockId, &now);
+  return static_cast<TimeStampType>(now.tv_sec) + static_cast<TimeStampType>(now.tv_nsec) * 1e-9;
+}
+#endif
+
+TimeStampType
+ReadMonotonic()
+{
+#if defined(CLOCK_MONOTONIC_RAW)
+  return ReadPOSIXClock(CLOCK_MONOTONIC);
+#else
+  return std::chrono::duration<TimeStampType>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+TimeStampType
+ReadMonotonicRaw()
+{
+#if defined(CLOCK_MONOTONIC_RAW)
+  return ReadPOSIXClock(CLOCK_MONOTONIC_RAW);
+#else
+  return ReadMonotonic();
+#endif
+}
+
+#if defined(ITK_BENCHMARK_HAS_TSC)
+bool
+CPUHasInvariantTSC()
+{
+  // CPUID.80000001H:EDX[27] reports rdtscp, CPUID.80000007H:EDX[8] reports a
+  // time stamp counter running at a constant rate in all power states.
+#  if defined(_WIN32)
+  int registers[4];
+  __cpuid(registers, 0x80000000);
+  if (static_cast<unsigned int>(registers[0]) < 0x80000007u)
+  {
+    return false;
+  }
+  __cpuid(registers, 0x80000001);
+  const bool hasRDTSCP = (registers[3] & (1 << 27)) != 0;
+  __cpuid(registers, 0x80000007);
+  return hasRDTSCP && (registers[3] & (1 << 8)) != 0;
+#  else
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007u)
+  {
+    return false;
+  }
+  __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx);
+  const bool hasRDTSCP = (edx & (1u << 27)) != 0;
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  return hasRDTSCP && (edx & (1u << 8)) != 0;
+#  endif
+}
+
+inline uint64_t
+ReadTSC()
+{
+  // The fences keep the read from being reordered with the timed code.
+  unsigned int processor;
+  _mm_lfence();
+  const uint64_t ticks = __rdtscp(&processor);
+  _mm_lfence();
+  return ticks;
+}
+#endif
+
+/** Invariant TSC frequency and origin, calibrated once per process. */
+struct TSCCalibration
+{
+  double   m_Frequency{ 0.0 };
+  uint64_t m_Origin{ 0 };
+
+  TSCCalibration()
+  {
+#if defined(ITK_BENCHMARK_HAS_TSC)
+    if (!CPUHasInvariantTSC())
+    {
+      return;
+    }
+    // Count ticks over a 20 ms busy wait on the raw monotonic clock.
+    constexpr TimeStampType calibrationTime = 0.02;
+    this->m_Origin = ReadTSC();
+    const TimeStampType startTime = ReadMonotonicRaw();
+    TimeStampType       endTime = startTime;
+    while (endTime - startTime < calibrationTime)
+    {
+      endTime = ReadMonotonicRaw();
+    }
+    const uint64_t endTicks = ReadTSC();
+    this->m_Frequency = static_cast<double>(endTicks - this->m_Origin) / (endTime - startTime);
+#endif
+  }
+};
+
+const TSCCalibration &
+GetTSCCalibration()
+{
+  static const TSCCalibration calibration;
+  return calibration;
+}
+
+} // namespace
+
+
+BenchmarkClockSource::BenchmarkClockSource(ClockSourceEnum clockSource, const RealTimeClock * realTimeClock)
+  : m_RequestedClockSource(clockSource)
+  , m_ClockSource(clockSource)
+  , m_RealTimeClock(realTimeClock)
+{
+  if (clockSource == ClockSourceEnum::RealTimeClock && realTimeClock == nullptr)
+  {
+    itkGenericExceptionMacro(<< "A RealTimeClock is required to read the RealTimeClock source.");
+  }
+  if (!IsAvailable(clockSource))
+  {
+    this->m_ClockSource =
+      IsAvailable(ClockSourceEnum::MonotonicRaw) ? ClockSourceEnum::MonotonicRaw : ClockSourceEnum::Monotonic;
+  }
+}
+
+
+BenchmarkClockSource::TimeStampType
+BenchmarkClockSource::GetTimeInSeconds() const
+{
+  switch (this->m_ClockSource)
+  {
+#if defined(ITK_BENCHMARK_HAS_TSC)
+    case ClockSourceEnum::InvariantTSC:
+    {
+      const TSCCalibration & calibration = GetTSCCalibration();
+      return static_cast<TimeStampType>(ReadTSC() - calibration.m_Origin) / calibration.m_Frequency;
+    }
+#endif
+    case ClockSourceEnum::MonotonicRaw:
+      return ReadMonotonicRaw();
+    case ClockSourceEnum::Monotonic:
+      return ReadMonotonic();
+    case ClockSourceEnum::RealTimeClock:
+    default:
+      return this->m_RealTimeClock->GetTimeInSeconds();
+  }
+}
+
+
+BenchmarkClockSource::TimeStampType
+BenchmarkClockSource::GetResolution() const
+{
+  switch (this->m_ClockSource)
+  {
+    case ClockSourceEnum::InvariantTSC:
+      return 1.0 / GetInvariantTSCFrequency();
+#if defined(CLOCK_MONOTONIC_RAW)
+    case ClockSourceEnum::MonotonicRaw:
+    case ClockSourceEnum::Monotonic:
+    {
+      timespec resolution;
+      clock_getres(this->m_ClockSource == ClockSourceEnum::MonotonicRaw ? CLOCK_MONOTONIC_RAW : CLOCK_MONOTONIC,
+                   &resolution);
+      return static_cast<TimeStampType>(resolution.tv_sec) + static_cast<TimeStampType>(resolution.tv_nsec) * 1e-9;
+    }
+#else
+    case ClockSourceEnum::MonotonicRaw:
+    case ClockSourceEnum::Monotonic:
+      return static_cast<TimeStampType>(std::chrono::steady_clock::period::num) /
+             static_cast<TimeStampType>(std::chrono::steady_clock::period::den);
+#endif
+    case ClockSourceEnum::RealTimeClock:
+    default:
+      return 1.0 / this->m_RealTimeClock->GetFrequency();
+  }
+}
+
+
+bool
+BenchmarkClockSource::IsAvailable(ClockSourceEnum clockSource)
+{
+  switch (clockSource)
+  {
+    case ClockSourceEnum::InvariantTSC:
+      return GetInvariantTSCFrequency() > 0.0;
+    case ClockSourceEnum::MonotonicRaw:
+#if defined(CLOCK_MONOTONIC_RAW)
+      return true;
+#else
+      return false;
+#endif
+    case ClockSourceEnum::RealTimeClock:
+    case ClockSourceEnum::Monotonic:
+    default:
+      return true;
+  }
+}
+
+
+double
+BenchmarkClockSource::GetInvariantTSCFrequency()
+{
+  return GetTSCCalibration().m_Frequency;
+}
+
+
+const char *
+BenchmarkClockSource::ToString(ClockSourceEnum clockSource)
+{
+  switch (clockSource)
+  {
+    case ClockSourceEnum::RealTimeClock:
+      return "RealTimeClock";
+    case ClockSourceEnum::Monotonic:
+      return "Monotonic";
+    case ClockSourceEnum::MonotonicRaw:
+      return "MonotonicRaw";
+    case ClockSourceEnum::InvariantTSC:
+      return "InvariantTSC";
+    default:
+      return "INVALID VALUE FOR itk::BenchmarkClockSource::ClockSourceEnum";
+  }
+}
+
+
+bool
+BenchmarkClockSource::FromString(const std::string & name, ClockSourceEnum & clockSource)
+{
+  std::string lowerCaseName(name);
+  std::transform(lowerCaseName.begin(), lowerCaseName.end(), lowerCaseName.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+  if (lowerCaseName == "tsc")
+  {
+    clockSource = ClockSourceEnum::InvariantTSC;
+    return true;
+  }
+  for (const auto candidate : { ClockSourceEnum::RealTimeClock,
+                                 ClockSourceEnum::Monotonic,
+                                 ClockSourceEnum::MonotonicRaw,
+                                 ClockSourceEnum::InvariantTSC })
+  {
+    std::string candidateName(ToString(candidate));
+    std::transform(candidateName.begin(), candidateName.end(), candidateName.begin(), [](unsigned char c) {
+      return static_cast<char>(std::tolower(c));
+    });
+    if (lowerCaseName == candidateName)
+    {
+      clockSource = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+std::ostream &
+operator<<(std::ostream & out, const BenchmarkClockSource::ClockSourceEnum value)
+{
+  return out << BenchmarkClockSource::ToString(value);
+}
+
+} // end namespace itk
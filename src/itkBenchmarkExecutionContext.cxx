@@ -0,0 +1,707 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkExecutionContext.h"
+#include "itkBenchmarkSystemInformation.h"
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <climits>
+#  include <sys/mman.h>
+#  include <sys/resource.h>
+#  include <sys/time.h>
+#  if defined(__linux__)
+#    include <dirent.h>
+#    include <sched.h>
+#    include <sys/prctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#  endif
+#endif
+
+namespace itk
+{
+namespace
+{
+
+using SchedulingPolicyEnum = BenchmarkExecutionContext::SchedulingPolicyEnum;
+using ThreadPlacementEnum = BenchmarkExecutionContext::ThreadPlacementEnum;
+
+std::string
+ToUpper(std::string value)
+{
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+    return static_cast<char>(std::toupper(c));
+  });
+  return value;
+}
+
+bool
+IsEnabledInEnvironment(const char * name)
+{
+  const char * value = itksys::SystemTools::GetEnv(name);
+  if (value == nullptr)
+  {
+    return false;
+  }
+  const std::string upperCaseValue = ToUpper(value);
+  return !upperCaseValue.empty() && upperCaseValue != "0" && upperCaseValue != "OFF" && upperCaseValue != "FALSE" &&
+         upperCaseValue != "NO";
+}
+
+std::string
+ErrorMessage(const char * what)
+{
+  return std::string(what) + ": " + std::strerror(errno);
+}
+
+#if defined(__linux__)
+/** Scheduling state of one thread, to be restored. */
+struct ThreadState
+{
+  pid_t       m_ThreadId{ 0 };
+  int         m_Nice{ 0 };
+  int         m_Policy{ SCHED_OTHER };
+  sched_param m_Parameters{};
+  cpu_set_t   m_Affinity{};
+  bool        m_HasAffinity{ false };
+};
+
+std::vector<pid_t>
+GetThreadIds()
+{
+  std::vector<pid_t> threadIds;
+  if (DIR * tasks = opendir("/proc/self/task"))
+  {
+    while (const dirent * task = readdir(tasks))
+    {
+      if (task->d_name[0] != '.')
+      {
+        threadIds.push_back(static_cast<pid_t>(std::stol(task->d_name)));
+      }
+    }
+    closedir(tasks);
+  }
+  // The calling thread first, then the others in the order they were
+  // created, as far as their ids tell.
+  const auto callingThreadId = static_cast<pid_t>(syscall(SYS_gettid));
+  std::sort(threadIds.begin(), threadIds.end());
+  threadIds.erase(std::remove(threadIds.begin(), threadIds.end(), callingThreadId), threadIds.end());
+  threadIds.insert(threadIds.begin(), callingThreadId);
+  return threadIds;
+}
+#endif
+
+/** The process wide state, guarded by its mutex. */
+struct ContextState
+{
+  std::mutex                                 m_Mutex;
+  unsigned int                               m_ReferenceCount{ 0 };
+  bool                                       m_HasSettings{ false };
+  BenchmarkExecutionContext::Settings        m_Settings;
+  BenchmarkExecutionContext::AppliedSettings m_Applied;
+#if defined(_WIN32)
+  DWORD                                      m_OldPriorityClass{ 0 };
+  HANDLE                                     m_Thread{ nullptr };
+  int                                        m_OldThreadPriority{ THREAD_PRIORITY_ERROR_RETURN };
+  DWORD_PTR                                  m_OldProcessAffinity{ 0 };
+#elif defined(__linux__)
+  std::vector<ThreadState>                   m_ThreadStates;
+#else
+  int                                        m_OldProcessPriority{ 0 };
+#endif
+
+  void
+  ReadSettingsFromEnvironment();
+
+  void
+  Apply();
+
+  void
+  Restore();
+};
+
+ContextState &
+GetState()
+{
+  static ContextState state;
+  return state;
+}
+
+
+void
+ContextState::ReadSettingsFromEnvironment()
+{
+  this->m_Settings = BenchmarkExecutionContext::GetEnvironmentSettings();
+  this->m_HasSettings = true;
+}
+
+
+void
+ContextState::Apply()
+{
+  const BenchmarkExecutionContext::Settings & settings = this->m_Settings;
+  BenchmarkExecutionContext::AppliedSettings  applied;
+
+#if defined(_WIN32)
+  if (settings.m_SchedulingPolicy != SchedulingPolicyEnum::None)
+  {
+    if (settings.m_SchedulingPolicy != SchedulingPolicyEnum::Nice)
+    {
+      applied.m_Messages.emplace_back("Real-time scheduling is not supported, the priority is raised instead");
+    }
+    // REALTIME_PRIORITY_CLASS will pretty much block the mouse, cause
+    // some program to lose socket connection, etc.
+    this->m_OldPriorityClass = ::GetPriorityClass(::GetCurrentProcess());
+    if (this->m_OldPriorityClass == 0 || !::SetPriorityClass(::GetCurrentProcess(), HIGH_PRIORITY_CLASS))
+    {
+      this->m_OldPriorityClass = 0;
+      applied.m_Messages.emplace_back("The priority class could not be set");
+    }
+    this->m_Thread = ::OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, ::GetCurrentThreadId());
+    this->m_OldThreadPriority =
+      this->m_Thread != nullptr ? ::GetThreadPriority(this->m_Thread) : THREAD_PRIORITY_ERROR_RETURN;
+    if (this->m_OldThreadPriority == THREAD_PRIORITY_ERROR_RETURN ||
+        !::SetThreadPriority(this->m_Thread, THREAD_PRIORITY_TIME_CRITICAL))
+    {
+      this->m_OldThreadPriority = THREAD_PRIORITY_ERROR_RETURN;
+      applied.m_Messages.emplace_back("The thread priority could not be set");
+    }
+    if (this->m_OldPriorityClass != 0)
+    {
+      applied.m_SchedulingPolicy = SchedulingPolicyEnum::Nice;
+      applied.m_Priority = THREAD_PRIORITY_TIME_CRITICAL;
+    }
+  }
+  if (!settings.m_CPUAffinity.empty())
+  {
+    DWORD_PTR processAffinity = 0;
+    DWORD_PTR systemAffinity = 0;
+    DWORD_PTR affinity = 0;
+    for (const unsigned int cpu : settings.m_CPUAffinity)
+    {
+      if (cpu < 8 * sizeof(DWORD_PTR))
+      {
+        affinity |= DWORD_PTR{ 1 } << cpu;
+      }
+    }
+    if (::GetProcessAffinityMask(::GetCurrentProcess(), &processAffinity, &systemAffinity) &&
+        ::SetProcessAffinityMask(::GetCurrentProcess(), affinity))
+    {
+      this->m_OldProcessAffinity = processAffinity;
+      applied.m_CPUAffinity = settings.m_CPUAffinity;
+    }
+    else
+    {
+      applied.m_Messages.emplace_back("The process affinity could not be set");
+    }
+  }
+  if (settings.m_ThreadPlacement != ThreadPlacementEnum::None)
+  {
+    applied.m_Messages.emplace_back("Placing the threads is not supported");
+  }
+  if (settings.m_LockMemory)
+  {
+    applied.m_Messages.emplace_back("Locking the memory is not supported");
+  }
+#else
+#  if defined(__linux__)
+  cpu_set_t affinity;
+  CPU_ZERO(&affinity);
+  for (const unsigned int cpu : settings.m_CPUAffinity)
+  {
+    if (cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &affinity);
+    }
+  }
+
+  std::vector<unsigned int> placementCPUs;
+  if (settings.m_ThreadPlacement != ThreadPlacementEnum::None)
+  {
+    std::vector<unsigned int> cpus = settings.m_CPUAffinity;
+    cpu_set_t                 allowed;
+    CPU_ZERO(&allowed);
+    if (cpus.empty() && sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0)
+    {
+      for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+          cpus.push_back(cpu);
+        }
+      }
+    }
+    placementCPUs = BenchmarkThreadPlacement::GetCPUOrder(settings.m_ThreadPlacement, cpus);
+  }
+
+  bool   niceFailed = false;
+  bool   realTimeFailed = false;
+  bool   affinityFailed = false;
+  size_t threadIndex = 0;
+  for (const pid_t threadId : GetThreadIds())
+  {
+    ThreadState state;
+    state.m_ThreadId = threadId;
+    errno = 0;
+    state.m_Nice = getpriority(PRIO_PROCESS, static_cast<id_t>(threadId));
+    if (state.m_Nice == -1 && errno != 0)
+    {
+      // The thread exited.
+      continue;
+    }
+    state.m_Policy = sched_getscheduler(threadId);
+    sched_getparam(threadId, &state.m_Parameters);
+
+    bool realTime = false;
+    if (settings.m_SchedulingPolicy == SchedulingPolicyEnum::FIFO ||
+        settings.m_SchedulingPolicy == SchedulingPolicyEnum::RoundRobin)
+    {
+      const int   policy = settings.m_SchedulingPolicy == SchedulingPolicyEnum::FIFO ? SCHED_FIFO : SCHED_RR;
+      sched_param parameters{};
+      parameters.sched_priority =
+        std::max(sched_get_priority_min(policy), std::min(settings.m_RealTimePriority, sched_get_priority_max(policy)));
+      realTime = sched_setscheduler(threadId, policy, &parameters) == 0;
+      if (realTime)
+      {
+        applied.m_SchedulingPolicy = settings.m_SchedulingPolicy;
+        applied.m_Priority = parameters.sched_priority;
+      }
+      else if (!realTimeFailed)
+      {
+        realTimeFailed = true;
+        applied.m_Messages.push_back(ErrorMessage("sched_setscheduler") + ", the priority is raised instead");
+      }
+    }
+    if (!realTime && settings.m_SchedulingPolicy != SchedulingPolicyEnum::None)
+    {
+      // Technically only root can upgrade our priority, i.e. set the priority
+      // to such a low value that the system will favor our process for
+      // scheduling. In most other cases, we would get an EACCESS.
+      if (setpriority(PRIO_PROCESS, static_cast<id_t>(threadId), -NZERO) == 0)
+      {
+        if (applied.m_SchedulingPolicy == SchedulingPolicyEnum::None)
+        {
+          applied.m_SchedulingPolicy = SchedulingPolicyEnum::Nice;
+          applied.m_Priority = -NZERO;
+        }
+      }
+      else if (!niceFailed)
+      {
+        niceFailed = true;
+        applied.m_Messages.push_back(ErrorMessage("setpriority"));
+      }
+    }
+
+    if (!settings.m_CPUAffinity.empty() || !placementCPUs.empty())
+    {
+      // The calling thread, first, may run on all the placement CPUs, so that
+      // the threads it creates afterwards are not confined to one CPU; the
+      // other threads are pinned to one CPU each, in the order of the policy.
+      cpu_set_t threadAffinity = affinity;
+      if (!placementCPUs.empty())
+      {
+        CPU_ZERO(&threadAffinity);
+        for (const unsigned int cpu : placementCPUs)
+        {
+          if (threadIndex == 0 || cpu == placementCPUs[(threadIndex - 1) % placementCPUs.size()])
+          {
+            CPU_SET(cpu, &threadAffinity);
+          }
+        }
+      }
+      state.m_HasAffinity = sched_getaffinity(threadId, sizeof(cpu_set_t), &state.m_Affinity) == 0;
+      if (sched_setaffinity(threadId, sizeof(cpu_set_t), &threadAffinity) == 0)
+      {
+        applied.m_CPUAffinity = settings.m_CPUAffinity;
+        if (!placementCPUs.empty())
+        {
+          applied.m_ThreadPlacement = settings.m_ThreadPlacement;
+          if (threadIndex > 0)
+          {
+            applied.m_ThreadCPUs.push_back(placementCPUs[(threadIndex - 1) % placementCPUs.size()]);
+          }
+        }
+      }
+      else if (!affinityFailed)
+      {
+        affinityFailed = true;
+        applied.m_Messages.push_back(ErrorMessage("sched_setaffinity"));
+      }
+    }
+    this->m_ThreadStates.push_back(state);
+    ++threadIndex;
+  }
+#  else
+  if (settings.m_SchedulingPolicy != SchedulingPolicyEnum::None)
+  {
+    if (settings.m_SchedulingPolicy != SchedulingPolicyEnum::Nice)
+    {
+      applied.m_Messages.emplace_back("Real-time scheduling is not supported, the priority is raised instead");
+    }
+    errno = 0;
+    this->m_OldProcessPriority = getpriority(PRIO_PROCESS, 0);
+#    ifdef __APPLE__
+    const int priority = -20;
+#    else
+    const int priority = -NZERO;
+#    endif
+    if (setpriority(PRIO_PROCESS, 0, priority) == 0)
+    {
+      applied.m_SchedulingPolicy = SchedulingPolicyEnum::Nice;
+      applied.m_Priority = priority;
+    }
+    else
+    {
+      applied.m_Messages.push_back(ErrorMessage("setpriority"));
+    }
+  }
+  if (!settings.m_CPUAffinity.empty())
+  {
+    applied.m_Messages.emplace_back("Setting the CPU affinity is not supported");
+  }
+  if (settings.m_ThreadPlacement != ThreadPlacementEnum::None)
+  {
+    applied.m_Messages.emplace_back("Placing the threads is not supported");
+  }
+#  endif
+
+  if (settings.m_LockMemory)
+  {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+    {
+      applied.m_MemoryLocked = true;
+    }
+    else
+    {
+      applied.m_Messages.push_back(ErrorMessage("mlockall"));
+    }
+  }
+#endif
+
+  if (settings.m_DisableTransparentHugePages)
+  {
+#if defined(__linux__) && defined(PR_SET_THP_DISABLE)
+    if (prctl(PR_SET_THP_DISABLE, 1, 0, 0, 0) == 0)
+    {
+      applied.m_TransparentHugePagesDisabled = true;
+    }
+    else
+    {
+      applied.m_Messages.push_back(ErrorMessage("prctl(PR_SET_THP_DISABLE)"));
+    }
+#else
+    applied.m_Messages.emplace_back("Disabling the transparent huge pages is not supported");
+#endif
+  }
+
+  this->m_Applied = applied;
+}
+
+
+void
+ContextState::Restore()
+{
+#if defined(_WIN32)
+  if (this->m_OldPriorityClass != 0)
+  {
+    ::SetPriorityClass(::GetCurrentProcess(), this->m_OldPriorityClass);
+    this->m_OldPriorityClass = 0;
+  }
+  if (this->m_Thread != nullptr)
+  {
+    if (this->m_OldThreadPriority != THREAD_PRIORITY_ERROR_RETURN)
+    {
+      ::SetThreadPriority(this->m_Thread, this->m_OldThreadPriority);
+    }
+    ::CloseHandle(this->m_Thread);
+    this->m_Thread = nullptr;
+  }
+  if (this->m_OldProcessAffinity != 0)
+  {
+    ::SetProcessAffinityMask(::GetCurrentProcess(), this->m_OldProcessAffinity);
+    this->m_OldProcessAffinity = 0;
+  }
+#else
+#  if defined(__linux__)
+  // Lowering the priority back is always permitted; the threads that exited
+  // in the meantime are ignored.
+  for (const ThreadState & state : this->m_ThreadStates)
+  {
+    if (this->m_Applied.m_SchedulingPolicy == SchedulingPolicyEnum::FIFO ||
+        this->m_Applied.m_SchedulingPolicy == SchedulingPolicyEnum::RoundRobin)
+    {
+      sched_setscheduler(state.m_ThreadId, state.m_Policy, &state.m_Parameters);
+    }
+    if (this->m_Applied.m_SchedulingPolicy != SchedulingPolicyEnum::None)
+    {
+      setpriority(PRIO_PROCESS, static_cast<id_t>(state.m_ThreadId), state.m_Nice);
+    }
+    if (state.m_HasAffinity)
+    {
+      sched_setaffinity(state.m_ThreadId, sizeof(cpu_set_t), &state.m_Affinity);
+    }
+  }
+  this->m_ThreadStates.clear();
+#  else
+  if (this->m_Applied.m_SchedulingPolicy != SchedulingPolicyEnum::None)
+  {
+    setpriority(PRIO_PROCESS, 0, this->m_OldProcessPriority);
+  }
+#  endif
+  if (this->m_Applied.m_MemoryLocked)
+  {
+    munlockall();
+  }
+#endif
+#if defined(__linux__) && defined(PR_SET_THP_DISABLE)
+  if (this->m_Applied.m_TransparentHugePagesDisabled)
+  {
+    prctl(PR_SET_THP_DISABLE, 0, 0, 0, 0);
+  }
+#endif
+}
+
+} // namespace
+
+
+void
+BenchmarkExecutionContext::Acquire()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  if (state.m_ReferenceCount++ == 0)
+  {
+    if (!state.m_HasSettings)
+    {
+      state.ReadSettingsFromEnvironment();
+    }
+    state.Apply();
+  }
+}
+
+
+void
+BenchmarkExecutionContext::Release()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  if (state.m_ReferenceCount > 0 && --state.m_ReferenceCount == 0)
+  {
+    state.Restore();
+  }
+}
+
+
+bool
+BenchmarkExecutionContext::IsActive()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  return state.m_ReferenceCount > 0;
+}
+
+
+void
+BenchmarkExecutionContext::SetSettings(const Settings & settings)
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  if (state.m_ReferenceCount > 0)
+  {
+    state.Restore();
+  }
+  state.m_Settings = settings;
+  state.m_HasSettings = true;
+  if (state.m_ReferenceCount > 0)
+  {
+    state.Apply();
+  }
+}
+
+
+void
+BenchmarkExecutionContext::Reapply()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  if (state.m_ReferenceCount > 0)
+  {
+    state.Restore();
+    state.Apply();
+  }
+}
+
+
+BenchmarkExecutionContext::Settings
+BenchmarkExecutionContext::GetSettings()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  if (!state.m_HasSettings)
+  {
+    state.ReadSettingsFromEnvironment();
+  }
+  return state.m_Settings;
+}
+
+
+BenchmarkExecutionContext::Settings
+BenchmarkExecutionContext::GetEnvironmentSettings()
+{
+  Settings settings;
+  if (const char * scheduling = itksys::SystemTools::GetEnv("ITKPERFORMANCEBENCHMARK_SCHEDULING"))
+  {
+    if (!FromString(scheduling, settings.m_SchedulingPolicy))
+    {
+      std::cerr << "Unknown ITKPERFORMANCEBENCHMARK_SCHEDULING policy: " << scheduling << std::endl;
+    }
+  }
+  if (const char * affinity = itksys::SystemTools::GetEnv("ITKPERFORMANCEBENCHMARK_CPU_AFFINITY"))
+  {
+    settings.m_CPUAffinity = BenchmarkSystemInformation::ParseCPUList(affinity);
+  }
+  if (const char * placement = itksys::SystemTools::GetEnv("ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT"))
+  {
+    if (!BenchmarkThreadPlacement::FromString(placement, settings.m_ThreadPlacement))
+    {
+      std::cerr << "Unknown ITKPERFORMANCEBENCHMARK_THREAD_PLACEMENT policy: " << placement << std::endl;
+    }
+  }
+  settings.m_LockMemory = IsEnabledInEnvironment("ITKPERFORMANCEBENCHMARK_LOCK_MEMORY");
+  settings.m_DisableTransparentHugePages = IsEnabledInEnvironment("ITKPERFORMANCEBENCHMARK_DISABLE_THP");
+  return settings;
+}
+
+
+BenchmarkExecutionContext::AppliedSettings
+BenchmarkExecutionContext::GetAppliedSettings()
+{
+  ContextState &              state = GetState();
+  std::lock_guard<std::mutex> lock(state.m_Mutex);
+  return state.m_Applied;
+}
+
+
+void
+BenchmarkExecutionContext::PrintJSON(std::ostream & os)
+{
+  const Settings        requested = GetSettings();
+  const AppliedSettings applied = GetAppliedSettings();
+
+  const auto printCPUs = [&os](const std::vector<unsigned int> & cpus) {
+    os << '[';
+    for (size_t ii = 0; ii < cpus.size(); ++ii)
+    {
+      os << (ii > 0 ? ", " : "") << cpus[ii];
+    }
+    os << ']';
+  };
+
+  os << "{\n";
+  os << "    \"Active\": " << (IsActive() ? "true" : "false") << ",\n";
+  os << "    \"RequestedSchedulingPolicy\": \"" << ToString(requested.m_SchedulingPolicy) << "\",\n";
+  os << "    \"SchedulingPolicy\": \"" << ToString(applied.m_SchedulingPolicy) << "\",\n";
+  os << "    \"Priority\": " << applied.m_Priority << ",\n";
+  os << "    \"RequestedCPUAffinity\": ";
+  printCPUs(requested.m_CPUAffinity);
+  os << ",\n    \"CPUAffinity\": ";
+  printCPUs(applied.m_CPUAffinity);
+  os << ",\n";
+  os << "    \"RequestedThreadPlacement\": \"" << requested.m_ThreadPlacement << "\",\n";
+  os << "    \"ThreadPlacement\": \"" << applied.m_ThreadPlacement << "\",\n";
+  os << "    \"ThreadCPUs\": ";
+  printCPUs(applied.m_ThreadCPUs);
+  os << ",\n";
+  os << "    \"MemoryLocked\": " << (applied.m_MemoryLocked ? "true" : "false") << ",\n";
+  os << "    \"TransparentHugePagesDisabled\": " << (applied.m_TransparentHugePagesDisabled ? "true" : "false")
+     << ",\n";
+  os << "    \"Messages\": [";
+  for (size_t ii = 0; ii < applied.m_Messages.size(); ++ii)
+  {
+    std::string message = applied.m_Messages[ii];
+    std::replace(message.begin(), message.end(), '"', '\'');
+    os << (ii > 0 ? ", \"" : "\"") << message << '"';
+  }
+  os << "]\n  }";
+}
+
+
+const char *
+BenchmarkExecutionContext::ToString(SchedulingPolicyEnum policy)
+{
+  switch (policy)
+  {
+    case SchedulingPolicyEnum::None:
+      return "None";
+    case SchedulingPolicyEnum::Nice:
+      return "Nice";
+    case SchedulingPolicyEnum::FIFO:
+      return "FIFO";
+    case SchedulingPolicyEnum::RoundRobin:
+      return "RoundRobin";
+    default:
+      return "INVALID VALUE FOR itk::BenchmarkExecutionContext::SchedulingPolicyEnum";
+  }
+}
+
+
+bool
+BenchmarkExecutionContext::FromString(const std::string & name, SchedulingPolicyEnum & policy)
+{
+  const std::string upperCaseName = ToUpper(name);
+  if (upperCaseName == "RR" || upperCaseName == "SCHED_RR")
+  {
+    policy = SchedulingPolicyEnum::RoundRobin;
+    return true;
+  }
+  if (upperCaseName == "SCHED_FIFO")
+  {
+    policy = SchedulingPolicyEnum::FIFO;
+    return true;
+  }
+  for (const auto candidate : { SchedulingPolicyEnum::None,
+                                 SchedulingPolicyEnum::Nice,
+                                 SchedulingPolicyEnum::FIFO,
+                                 SchedulingPolicyEnum::RoundRobin })
+  {
+    if (upperCaseName == ToUpper(ToString(candidate)))
+    {
+      policy = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+std::ostream &
+operator<<(std::ostream & out, const BenchmarkExecutionContext::SchedulingPolicyEnum value)
+{
+  return out << BenchmarkExecutionContext::ToString(value);
+}
+
+} // end namespace itk
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkLoopDriver.h"
+#include "itkBenchmarkRobustStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+
+BenchmarkLoopDriver::BenchmarkLoopDriver(SizeValueType minimumIterations,
+                                         SizeValueType maximumIterations,
+                                         TimeStampType timeBudget,
+                                         double        targetRelativeHalfWidth,
+                                         TimeStampType minimumTime)
+  : m_MinimumIterations(std::max<SizeValueType>(minimumIterations, 1))
+  , m_MaximumIterations(std::max(maximumIterations, m_MinimumIterations))
+  , m_TimeBudget(std::max(timeBudget, 0.0))
+  , m_TargetRelativeHalfWidth(std::max(targetRelativeHalfWidth, 0.0))
+  , m_MinimumTime(std::max(minimumTime, 0.0))
+{}
+
+
+bool
+BenchmarkLoopDriver::Continue()
+{
+  if (this->m_StoppingReason != StoppingReasonEnum::Running)
+  {
+    return false;
+  }
+  if (this->m_StartTime < 0.0)
+  {
+    this->m_StartTime = this->m_Clock.GetTimeInSeconds();
+  }
+
+  const SizeValueType iterations = this->GetIterations();
+  if (iterations < this->m_MinimumIterations)
+  {
+    return true;
+  }
+  const bool minimumTimeElapsed = this->GetElapsedTime() >= this->m_MinimumTime;
+  if (!minimumTimeElapsed && iterations < this->m_MaximumIterations)
+  {
+    return true;
+  }
+  if (this->m_TargetRelativeHalfWidth > 0.0 && this->GetRelativeHalfWidth() <= this->m_TargetRelativeHalfWidth)
+  {
+    this->m_StoppingReason = StoppingReasonEnum::ConfidenceTarget;
+  }
+  else if (iterations >= this->m_MaximumIterations)
+  {
+    this->m_StoppingReason = StoppingReasonEnum::MaximumIterations;
+  }
+  else if (this->m_TimeBudget > 0.0)
+  {
+    // The elapsed time per iteration includes the work done between the
+    // timed regions, so that the budget is not overrun.
+    const TimeStampType elapsed = this->GetElapsedTime();
+    if (elapsed + elapsed / static_cast<TimeStampType>(iterations) > this->m_TimeBudget)
+    {
+      this->m_StoppingReason = StoppingReasonEnum::TimeBudget;
+    }
+  }
+  if (this->m_StoppingReason == StoppingReasonEnum::Running && this->m_MinimumTime > 0.0 &&
+      this->m_TargetRelativeHalfWidth == 0.0)
+  {
+    // The minimum time elapsed: the loop was run for time, not precision.
+    this->m_StoppingReason = StoppingReasonEnum::MinimumTime;
+  }
+  if (this->m_StoppingReason == StoppingReasonEnum::Running)
+  {
+    return true;
+  }
+  this->m_StopTime = this->m_Clock.GetTimeInSeconds();
+  return false;
+}
+
+
+void
+BenchmarkLoopDriver::AddSample(TimeStampType seconds)
+{
+  this->m_Statistics.AddValue(seconds);
+}
+
+
+double
+BenchmarkLoopDriver::GetRelativeHalfWidth() const
+{
+  const SizeValueType count = this->m_Statistics.GetCount();
+  const double        mean = this->m_Statistics.GetMean();
+  if (count < 2 || mean <= 0.0)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  return BenchmarkRobustStatistics::GetStudentT95(count - 1) * this->m_Statistics.GetStandardError() / mean;
+}
+
+
+BenchmarkLoopDriver::TimeStampType
+BenchmarkLoopDriver::GetElapsedTime() const
+{
+  if (this->m_StartTime < 0.0)
+  {
+    return 0.0;
+  }
+  return (this->m_StopTime < 0.0 ? this->m_Clock.GetTimeInSeconds() : this->m_StopTime) - this->m_StartTime;
+}
+
+
+const char *
+BenchmarkLoopDriver::ToString(StoppingReasonEnum reason)
+{
+  switch (reason)
+  {
+    case StoppingReasonEnum::Running:
+      return "Running";
+    case StoppingReasonEnum::MaximumIterations:
+      return "MaximumIterations";
+    case StoppingReasonEnum::TimeBudget:
+      return "TimeBudget";
+    case StoppingReasonEnum::ConfidenceTarget:
+      return "ConfidenceTarget";
+    case StoppingReasonEnum::MinimumTime:
+      return "MinimumTime";
+    default:
+      return "INVALID VALUE FOR itk::BenchmarkLoopDriver::StoppingReasonEnum";
+  }
+}
+
+
+void
+BenchmarkLoopDriver::PrintJSON(std::ostream & os) const
+{
+  const double relativeHalfWidth = this->GetRelativeHalfWidth();
+  os << "{\n";
+  os << "    \"Iterations\": " << this->GetIterations() << ",\n";
+  os << "    \"StoppingReason\": \"" << this->m_StoppingReason << "\",\n";
+  os << "    \"MinimumIterations\": " << this->m_MinimumIterations << ",\n";
+  os << "    \"MaximumIterations\": " << this->m_MaximumIterations << ",\n";
+  os << "    \"TimeBudget\": " << this->m_TimeBudget << ",\n";
+  os << "    \"TargetRelativeHalfWidth\": " << this->m_TargetRelativeHalfWidth << ",\n";
+  os << "    \"MinimumTime\": " << this->m_MinimumTime << ",\n";
+  // JSON has no infinity: the unknown half-width of fewer than two samples is
+  // null.
+  os << "    \"RelativeHalfWidth\": ";
+  if (std::isfinite(relativeHalfWidth))
+  {
+    os << relativeHalfWidth << ",\n";
+  }
+  else
+  {
+    os << "null,\n";
+  }
+  os << "    \"ElapsedTime\": " << this->GetElapsedTime() << "\n";
+  os << "  }";
+}
+
+
+std::ostream &
+operator<<(std::ostream & out, const BenchmarkLoopDriver::StoppingReasonEnum value)
+{
+  return out << BenchmarkLoopDriver::ToString(value);
+}
+
+} // end namespace itk
@@ -0,0 +1,301 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkNoiseFloor.h"
+#include "itkBenchmarkClockSource.h"
+#include "itkBenchmarkRobustStatistics.h"
+#include "itkBenchmarkSystemInformation.h"
+#include <itksys/SystemInformation.hxx>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+#if defined(__linux__)
+#  include <sched.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+
+using TimeStampType = BenchmarkNoiseFloor::TimeStampType;
+
+/** A gap between two reads of the clock longer than this is an interruption. */
+constexpr TimeStampType interruptionThreshold = 10e-6;
+
+/** Each spin loop sample lasts about this long. */
+constexpr TimeStampType spinSampleDuration = 50e-6;
+
+/** Number of times the CPU frequency is read during the measurement. */
+constexpr unsigned int frequencySamples = 8;
+
+/** Reads a number from the first line of a file, returns a negative value
+ * if it can not be read. */
+double
+ReadNumber(const std::string & fileName)
+{
+  std::ifstream file(fileName);
+  double        value = -1.0;
+  if (!(file >> value))
+  {
+    return -1.0;
+  }
+  return value;
+}
+
+/** Frequency of the CPU the calling thread runs on, in MHz. */
+double
+ReadCPUFrequency()
+{
+#if defined(__linux__)
+  const int cpu = sched_getcpu();
+  if (cpu >= 0)
+  {
+    const double kHz =
+      ReadNumber("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_cur_freq");
+    return kHz > 0.0 ? kHz / 1000.0 : -1.0;
+  }
+#endif
+  return -1.0;
+}
+
+/** Sum of the thermal throttling events of all the CPUs. */
+SizeValueType
+ReadThrottleEvents()
+{
+  SizeValueType events = 0;
+  for (const BenchmarkSystemInformation::CPUTopology & cpu : BenchmarkSystemInformation::GetInstance().GetCPUTopology())
+  {
+    const std::string throttle =
+      "/sys/devices/system/cpu/cpu" + std::to_string(cpu.m_CPU) + "/thermal_throttle/";
+    for (const char * counter : { "core_throttle_count", "package_throttle_count" })
+    {
+      const double count = ReadNumber(throttle + counter);
+      events += count > 0.0 ? static_cast<SizeValueType>(count) : 0;
+    }
+  }
+  return events;
+}
+
+/** Highest temperature of the thermal zones, in Celsius. */
+double
+ReadMaximumTemperature()
+{
+  double maximum = -1.0;
+  for (unsigned int zone = 0;; ++zone)
+  {
+    const double milliCelsius = ReadNumber("/sys/class/thermal/thermal_zone" + std::to_string(zone) + "/temp");
+    if (milliCelsius < 0.0)
+    {
+      break;
+    }
+    maximum = std::max(maximum, milliCelsius / 1000.0);
+  }
+  return maximum;
+}
+
+
+/** The work timed by the spin loop. */
+unsigned long
+Spin(unsigned long iterations)
+{
+  volatile unsigned long sum = 0;
+  for (unsigned long ii = 0; ii < iterations; ++ii)
+  {
+    sum = sum + ii;
+  }
+  return sum;
+}
+
+} // namespace
+
+
+BenchmarkNoiseFloor
+BenchmarkNoiseFloor::Measure(TimeStampType duration)
+{
+  BenchmarkNoiseFloor measurement;
+
+  itksys::SystemInformation systemInformation;
+  measurement.m_LoadAverage = systemInformation.GetLoadAverage();
+  measurement.m_NumberOfLogicalCPU = std::max(1u, BenchmarkSystemInformation::GetInstance().GetNumberOfLogicalCPU());
+  measurement.m_MaximumTemperature = ReadMaximumTemperature();
+  const SizeValueType throttleEvents = ReadThrottleEvents();
+
+  const BenchmarkClockSource clock(BenchmarkClockSource::ClockSourceEnum::MonotonicRaw);
+
+  // Interruptions: the time between two reads of the clock in a tight loop.
+  const TimeStampType interruptionStart = clock.GetTimeInSeconds();
+  TimeStampType       previous = interruptionStart;
+  TimeStampType       interrupted = 0.0;
+  while (previous - interruptionStart < duration / 2)
+  {
+    const TimeStampType now = clock.GetTimeInSeconds();
+    if (now - previous > interruptionThreshold)
+    {
+      interrupted += now - previous;
+      measurement.m_MaximumInterruption = std::max(measurement.m_MaximumInterruption, now - previous);
+    }
+    previous = now;
+  }
+  measurement.m_InterruptedFraction = interrupted / (previous - interruptionStart);
+
+  // Timer jitter: time a fixed amount of work, calibrated to last about
+  // spinSampleDuration.
+  unsigned long iterations = 1000;
+  for (;;)
+  {
+    const TimeStampType start = clock.GetTimeInSeconds();
+    Spin(iterations);
+    const TimeStampType elapsed = clock.GetTimeInSeconds() - start;
+    if (elapsed >= spinSampleDuration / 4 || iterations > (1ul << 30))
+    {
+      iterations = static_cast<unsigned long>(static_cast<double>(iterations) * spinSampleDuration /
+                                              std::max(elapsed, 1e-9));
+      break;
+    }
+    iterations *= 4;
+  }
+  std::vector<TimeStampType> samples;
+  std::vector<double>        frequencies;
+  const TimeStampType        spinStart = clock.GetTimeInSeconds();
+  TimeStampType              now = spinStart;
+  TimeStampType              nextFrequencyRead = spinStart;
+  while (now - spinStart < duration / 2)
+  {
+    if (now >= nextFrequencyRead)
+    {
+      const double frequency = ReadCPUFrequency();
+      if (frequency > 0.0)
+      {
+        frequencies.push_back(frequency);
+      }
+      nextFrequencyRead += duration / 2 / frequencySamples;
+    }
+    const TimeStampType start = clock.GetTimeInSeconds();
+    Spin(iterations);
+    now = clock.GetTimeInSeconds();
+    samples.push_back(now - start);
+  }
+  std::sort(samples.begin(), samples.end());
+  const double median = BenchmarkRobustStatistics::GetQuantile(samples, 0.5);
+  measurement.m_TimerJitter =
+    median > 0.0 ? (BenchmarkRobustStatistics::GetQuantile(samples, 0.9) - median) / median : 0.0;
+
+  if (!frequencies.empty())
+  {
+    const auto   minmax = std::minmax_element(frequencies.begin(), frequencies.end());
+    const double sum = std::accumulate(frequencies.begin(), frequencies.end(), 0.0);
+    measurement.m_CPUFrequency = sum / static_cast<double>(frequencies.size());
+    measurement.m_CPUFrequencySpread = (*minmax.second - *minmax.first) / measurement.m_CPUFrequency;
+  }
+
+  const SizeValueType throttleEventsAfter = ReadThrottleEvents();
+  measurement.m_ThrottleEvents = throttleEventsAfter > throttleEvents ? throttleEventsAfter - throttleEvents : 0;
+
+  measurement.m_NoiseFloor =
+    std::max({ measurement.m_TimerJitter, measurement.m_InterruptedFraction, measurement.m_CPUFrequencySpread });
+  return measurement;
+}
+
+
+std::vector<std::string>
+BenchmarkNoiseFloor::GetIssues(double maximumNoiseFloor) const
+{
+  std::vector<std::string> issues;
+  std::ostringstream       issue;
+  if (this->m_NoiseFloor > maximumNoiseFloor)
+  {
+    issue << "The noise floor of " << 100.0 * this->m_NoiseFloor << "% exceeds " << 100.0 * maximumNoiseFloor
+          << "% (timer jitter " << 100.0 * this->m_TimerJitter << "%, interrupted "
+          << 100.0 * this->m_InterruptedFraction << "% of the time, CPU frequency spread "
+          << 100.0 * this->m_CPUFrequencySpread << "%)";
+    issues.push_back(issue.str());
+    issue.str("");
+  }
+  if (this->m_LoadAverage > 0.5 * this->m_NumberOfLogicalCPU)
+  {
+    issue << "The load average of " << this->m_LoadAverage << " exceeds half of the " << this->m_NumberOfLogicalCPU
+          << " CPUs";
+    issues.push_back(issue.str());
+    issue.str("");
+  }
+  if (this->m_ThrottleEvents > 0)
+  {
+    issue << "The CPUs were throttled " << this->m_ThrottleEvents << " times, at up to "
+          << this->m_MaximumTemperature << " C";
+    issues.push_back(issue.str());
+  }
+  return issues;
+}
+
+
+std::vector<std::string>
+BenchmarkNoiseFloor::GetConfigurationWarnings() const
+{
+  const BenchmarkSystemInformation & systemInformation = BenchmarkSystemInformation::GetInstance();
+  std::vector<std::string>           warnings;
+  if (systemInformation.GetScalingGovernor() != "Unknown" && systemInformation.GetScalingGovernor() != "performance")
+  {
+    warnings.push_back("The CPU frequency scaling governor is " + systemInformation.GetScalingGovernor() +
+                       ", not performance");
+  }
+  if (systemInformation.GetTurboBoost() == "Enabled")
+  {
+    warnings.emplace_back("Turbo boost is enabled, the CPU frequency depends on the temperature and the load");
+  }
+  return warnings;
+}
+
+
+void
+BenchmarkNoiseFloor::PrintJSON(std::ostream & os, double maximumNoiseFloor) const
+{
+  const auto printStrings = [&os](const std::vector<std::string> & strings) {
+    os << '[';
+    for (size_t ii = 0; ii < strings.size(); ++ii)
+    {
+      std::string value = strings[ii];
+      std::replace(value.begin(), value.end(), '"', '\'');
+      os << (ii > 0 ? ", \"" : "\"") << value << '"';
+    }
+    os << ']';
+  };
+  const std::vector<std::string> issues = this->GetIssues(maximumNoiseFloor);
+
+  os << "{\n";
+  os << "    \"NoiseFloor\": " << this->m_NoiseFloor << ",\n";
+  os << "    \"MaximumNoiseFloor\": " << maximumNoiseFloor << ",\n";
+  os << "    \"Quiet\": " << (issues.empty() ? "true" : "false") << ",\n";
+  os << "    \"TimerJitter\": " << this->m_TimerJitter << ",\n";
+  os << "    \"InterruptedFraction\": " << this->m_InterruptedFraction << ",\n";
+  os << "    \"MaximumInterruption\": " << this->m_MaximumInterruption << ",\n";
+  os << "    \"LoadAverage\": " << this->m_LoadAverage << ",\n";
+  os << "    \"CPUFrequency\": " << this->m_CPUFrequency << ",\n";
+  os << "    \"CPUFrequencySpread\": " << this->m_CPUFrequencySpread << ",\n";
+  os << "    \"MaximumTemperature\": " << this->m_MaximumTemperature << ",\n";
+  os << "    \"ThrottleEvents\": " << this->m_ThrottleEvents << ",\n";
+  os << "    \"Issues\": ";
+  printStrings(issues);
+  os << ",\n    \"ConfigurationWarnings\": ";
+  printStrings(this->GetConfigurationWarnings());
+  os << "\n  }";
+}
+
+} // end namespace itk
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkRegistry.h"
+#include "PerformanceBenchmarkingUtilities.h"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <regex>
+
+namespace itk
+{
+
+BenchmarkRegistry &
+BenchmarkRegistry::GetInstance()
+{
+  static BenchmarkRegistry registry;
+  return registry;
+}
+
+
+bool
+BenchmarkRegistry::Register(const std::string & name, FunctionType function, ArgumentsType defaultArguments)
+{
+  this->m_Benchmarks[name] = BenchmarkEntry{ name, std::move(function), std::move(defaultArguments) };
+  return true;
+}
+
+
+const BenchmarkRegistry::BenchmarkEntry *
+BenchmarkRegistry::Find(const std::string & name) const
+{
+  const auto found = this->m_Benchmarks.find(name);
+  return found != this->m_Benchmarks.end() ? &found->second : nullptr;
+}
+
+
+std::vector<const BenchmarkRegistry::BenchmarkEntry *>
+BenchmarkRegistry::Select(const std::string & filter) const
+{
+  const std::regex                    expression(filter);
+  std::vector<const BenchmarkEntry *> selected;
+  for (const auto & benchmark : this->m_Benchmarks)
+  {
+    if (filter.empty() || std::regex_search(benchmark.first, expression))
+    {
+      selected.push_back(&benchmark.second);
+    }
+  }
+  return selected;
+}
+
+
+int
+BenchmarkRegistry::Run(const BenchmarkEntry & benchmark, const ArgumentsType & arguments) const
+{
+  // argv as main() gets it: writable, and terminated by a null pointer.
+  std::vector<std::string> storage{ benchmark.Name };
+  storage.insert(storage.end(), arguments.begin(), arguments.end());
+  std::vector<char *> argv;
+  for (auto & argument : storage)
+  {
+    argv.push_back(&argument[0]);
+  }
+  argv.push_back(nullptr);
+
+  const auto threads = MultiThreaderName::GetGlobalDefaultNumberOfThreads();
+  int        result = EXIT_FAILURE;
+  try
+  {
+    result = benchmark.Function(static_cast<int>(storage.size()), argv.data());
+  }
+  catch (const std::exception & error)
+  {
+    std::cerr << benchmark.Name << ": " << error.what() << std::endl;
+  }
+  MultiThreaderName::SetGlobalDefaultNumberOfThreads(threads);
+  return result;
+}
+
+
+int
+BenchmarkRegistry::Main(int argc, char * argv[])
+{
+  const BenchmarkRegistry & registry = GetInstance();
+  if (registry.m_Benchmarks.size() != 1)
+  {
+    std::cerr << "Expected one benchmark, " << registry.m_Benchmarks.size() << " are registered" << std::endl;
+    return EXIT_FAILURE;
+  }
+  // The command line is passed as is, argv[0] included, so that the usage
+  // messages name the executable.
+  return registry.m_Benchmarks.begin()->second.Function(argc, argv);
+}
+
+} // end namespace itk
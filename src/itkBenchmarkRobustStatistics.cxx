@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkRobustStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace itk
+{
+namespace
+{
+/** The rank r, from 0, of the largest sorted value x[r] such that the
+ * probability that at most r of n values are below the median, the cumulative
+ * distribution of the binomial distribution B(n, 1/2), is at most
+ * (1 - confidenceLevel) / 2. Then [x[r], x[n - 1 - r]] contains the median at
+ * the confidence level. 0 if n is too small. */
+SizeValueType
+GetMedianConfidenceRank(SizeValueType n, double confidenceLevel)
+{
+  const double tail = (1.0 - confidenceLevel) / 2.0;
+  // The probabilities are summed in the log domain, the first ones underflow
+  // to 0 for a large n.
+  double        logProbability = -static_cast<double>(n) * std::log(2.0);
+  double        cumulativeProbability = std::exp(logProbability);
+  SizeValueType rank = 0;
+  while (rank < n / 2)
+  {
+    logProbability += std::log(static_cast<double>(n - rank) / static_cast<double>(rank + 1));
+    if (cumulativeProbability + std::exp(logProbability) > tail)
+    {
+      break;
+    }
+    cumulativeProbability += std::exp(logProbability);
+    ++rank;
+  }
+  return rank;
+}
+} // namespace
+
+
+BenchmarkRobustStatistics
+BenchmarkRobustStatistics::Compute(std::vector<double> values)
+{
+  BenchmarkRobustStatistics statistics;
+  statistics.m_NumberOfValues = values.size();
+  statistics.m_ConfidenceLevel = 0.95;
+  if (values.empty())
+  {
+    return statistics;
+  }
+
+  std::sort(values.begin(), values.end());
+  statistics.m_Median = GetQuantile(values, 0.5);
+  statistics.m_FirstQuartile = GetQuantile(values, 0.25);
+  statistics.m_ThirdQuartile = GetQuantile(values, 0.75);
+
+  std::vector<double> deviations(values.size());
+  std::transform(values.begin(), values.end(), deviations.begin(), [&statistics](double value) {
+    return std::abs(value - statistics.m_Median);
+  });
+  std::sort(deviations.begin(), deviations.end());
+  statistics.m_MedianAbsoluteDeviation = GetQuantile(deviations, 0.5);
+
+  const double interquartileRange = statistics.GetInterquartileRange();
+  for (const double value : values)
+  {
+    const double distance = std::max(statistics.m_FirstQuartile - value, value - statistics.m_ThirdQuartile);
+    if (distance > 3.0 * interquartileRange)
+    {
+      ++statistics.m_NumberOfSevereOutliers;
+    }
+    else if (distance > 1.5 * interquartileRange)
+    {
+      ++statistics.m_NumberOfMildOutliers;
+    }
+  }
+
+  // Student's t interval of the mean.
+  const auto   n = static_cast<double>(values.size());
+  const double mean = std::accumulate(values.begin(), values.end(), 0.0) / n;
+  statistics.m_MeanConfidenceInterval = { mean, mean };
+  if (values.size() > 1)
+  {
+    double sumOfSquares = 0.0;
+    for (const double value : values)
+    {
+      sumOfSquares += (value - mean) * (value - mean);
+    }
+    const double halfWidth =
+      GetStudentT95(values.size() - 1) * std::sqrt(sumOfSquares / (n - 1.0) / n);
+    statistics.m_MeanConfidenceInterval = { mean - halfWidth, mean + halfWidth };
+  }
+
+  // Distribution-free interval of the median, between order statistics.
+  const SizeValueType rank = GetMedianConfidenceRank(values.size(), statistics.m_ConfidenceLevel);
+  statistics.m_MedianConfidenceInterval = { values[rank], values[values.size() - 1 - rank] };
+  return statistics;
+}
+
+
+double
+BenchmarkRobustStatistics::GetStudentT95(SizeValueType degreesOfFreedom)
+{
+  static constexpr double quantiles[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                          2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                          2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+  constexpr SizeValueType numberOfQuantiles = sizeof(quantiles) / sizeof(quantiles[0]);
+  if (degreesOfFreedom == 0)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  if (degreesOfFreedom <= numberOfQuantiles)
+  {
+    return quantiles[degreesOfFreedom - 1];
+  }
+  // Cornish-Fisher expansion around the normal quantile.
+  constexpr double z = 1.959964;
+  const double     nu = static_cast<double>(degreesOfFreedom);
+  return z + (z * z * z + z) / (4.0 * nu) + (5.0 * std::pow(z, 5) + 16.0 * z * z * z + 3.0 * z) / (96.0 * nu * nu);
+}
+
+} // end namespace itk
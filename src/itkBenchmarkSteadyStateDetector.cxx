@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkSteadyStateDetector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+SizeValueType
+BenchmarkSteadyStateDetector::GetNumberOfWarmUpValues(const std::vector<double> & values)
+{
+  const SizeValueType numberOfValues = values.size();
+  if (numberOfValues < 3)
+  {
+    return 0;
+  }
+
+  // Sums of the values from d to the end, for every truncation d, from the
+  // last value backwards. The values are centered on the last one, so that
+  // the sums of squares do not lose the small differences of large values.
+  const double        reference = values.back();
+  const SizeValueType maximumTruncation = numberOfValues / 2;
+  double              sum = 0.0;
+  double              sumOfSquares = 0.0;
+  double              bestStandardError = 0.0;
+  SizeValueType       bestTruncation = 0;
+  double              bestMean = 0.0;
+  double              bestSumOfSquaredDeviations = 0.0;
+  for (SizeValueType ii = numberOfValues; ii-- > 0;)
+  {
+    const double value = values[ii] - reference;
+    sum += value;
+    sumOfSquares += value * value;
+    if (ii > maximumTruncation)
+    {
+      continue;
+    }
+    const auto   count = static_cast<double>(numberOfValues - ii);
+    const double sumOfSquaredDeviations = std::max(sumOfSquares - sum * sum / count, 0.0);
+    const double standardError = sumOfSquaredDeviations / (count * count);
+    // Ties go to the shortest truncation.
+    if (ii == maximumTruncation || standardError <= bestStandardError)
+    {
+      bestStandardError = standardError;
+      bestTruncation = ii;
+      bestMean = sum / count;
+      bestSumOfSquaredDeviations = sumOfSquaredDeviations;
+    }
+  }
+  if (bestTruncation == 0)
+  {
+    return 0;
+  }
+
+  double warmUpMean = 0.0;
+  for (SizeValueType ii = 0; ii < bestTruncation; ++ii)
+  {
+    warmUpMean += values[ii] - reference;
+  }
+  warmUpMean /= static_cast<double>(bestTruncation);
+  const double steadyStandardDeviation =
+    std::sqrt(bestSumOfSquaredDeviations / static_cast<double>(numberOfValues - bestTruncation - 1));
+  // A warm-up is slower than the steady state: a faster start is a level
+  // shift of the steady state, not one-time costs, and is kept.
+  if (warmUpMean - bestMean <= 2.0 * steadyStandardDeviation)
+  {
+    return 0;
+  }
+  return bestTruncation;
+}
+
+} // end namespace itk
@@ -0,0 +1,484 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkSystemInformation.h"
+#include "itkMacro.h"
+#include "itksys/SystemInformation.hxx"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+namespace itk
+{
+namespace
+{
+
+/** Returns the first line of a file, empty if it can not be read. */
+std::string
+ReadFirstLine(const std::string & fileName)
+{
+  std::ifstream file(fileName);
+  std::string   line;
+  std::getline(file, line);
+  return line;
+}
+
+/** Returns the value of the first "key : value" line of /proc/cpuinfo. */
+std::string
+ReadCPUInfo(const std::string & key)
+{
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string   line;
+  while (std::getline(cpuinfo, line))
+  {
+    const std::size_t colon = line.find(':');
+    if (colon == std::string::npos)
+    {
+      continue;
+    }
+    std::string name = line.substr(0, colon);
+    name.erase(name.find_last_not_of(" \t") + 1);
+    if (name == key)
+    {
+      const std::size_t begin = line.find_first_not_of(" \t", colon + 1);
+      return begin == std::string::npos ? std::string() : line.substr(begin);
+    }
+  }
+  return std::string();
+}
+
+/** Returns the selected value of a sysfs setting such as
+ * "always [madvise] never". */
+std::string
+ReadSelectedValue(const std::string & fileName)
+{
+  const std::string line = ReadFirstLine(fileName);
+  const std::size_t begin = line.find('[');
+  const std::size_t end = line.find(']', begin);
+  if (begin == std::string::npos || end == std::string::npos)
+  {
+    return line;
+  }
+  return line.substr(begin + 1, end - begin - 1);
+}
+
+/** Parses a cache size such as "32K" or "1M" to bytes. */
+SizeValueType
+ParseSize(const std::string & size)
+{
+  std::istringstream stream(size);
+  SizeValueType      value = 0;
+  char               unit = 0;
+  stream >> value >> unit;
+  switch (unit)
+  {
+    case 'K':
+      return value * 1024;
+    case 'M':
+      return value * 1024 * 1024;
+    case 'G':
+      return value * 1024 * 1024 * 1024;
+    default:
+      return value;
+  }
+}
+
+/** Returns a string with the characters that are special in JSON escaped. */
+std::string
+EscapeJSON(const std::string & value)
+{
+  std::string escaped;
+  for (const char c : value)
+  {
+    if (c == '"' || c == '\\')
+    {
+      escaped += '\\';
+    }
+    if (static_cast<unsigned char>(c) >= 0x20)
+    {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+/** Prints "name": value, quoting the strings, as the probes do. */
+template <typename T>
+void
+PrintJSONValue(std::ostream & os, const char * name, const T & value, unsigned int indent, bool comma = true)
+{
+  os << std::string(indent, ' ') << '"' << name << "\": " << value << (comma ? ",\n" : "\n");
+}
+
+void
+PrintJSONValue(std::ostream & os, const char * name, const std::string & value, unsigned int indent, bool comma = true)
+{
+  os << std::string(indent, ' ') << '"' << name << "\": \"" << EscapeJSON(value) << '"' << (comma ? ",\n" : "\n");
+}
+
+/** SIMD extensions of x86 and Arm, reported among the processor flags. */
+bool
+IsSIMDFlag(const std::string & flag)
+{
+  static const char * const prefixes[] = { "sse", "ssse", "avx", "fma", "f16c", "amx", "asimd", "sve", "neon" };
+  return std::any_of(std::begin(prefixes), std::end(prefixes), [&flag](const char * prefix) {
+    return flag.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+  });
+}
+
+} // namespace
+
+
+BenchmarkSystemInformation::BenchmarkSystemInformation()
+{
+  itksys::SystemInformation systeminfo;
+  systeminfo.RunCPUCheck();
+  systeminfo.RunMemoryCheck();
+  systeminfo.RunOSCheck();
+
+  this->m_HostName = systeminfo.GetHostname();
+  this->m_ProcessorName = systeminfo.GetExtendedProcessorName();
+  this->m_ProcessorCacheSize = systeminfo.GetProcessorCacheSize();
+  this->m_ProcessorClockFrequency = systeminfo.GetProcessorClockFrequency();
+  this->m_NumberOfPhysicalCPU = systeminfo.GetNumberOfPhysicalCPU();
+  this->m_NumberOfLogicalCPU = systeminfo.GetNumberOfLogicalCPU();
+
+  this->m_OSName = systeminfo.GetOSName();
+  this->m_OSRelease = systeminfo.GetOSRelease();
+  this->m_OSVersion = systeminfo.GetOSVersion();
+  this->m_OSPlatform = systeminfo.GetOSPlatform();
+
+  this->m_Is64Bits = systeminfo.Is64Bits();
+  std::ostringstream itkversion;
+  itkversion << ITK_VERSION_MAJOR << "." << ITK_VERSION_MINOR << "." << ITK_VERSION_PATCH;
+  this->m_ITKVersion = itkversion.str();
+
+  // Retrieve memory information in mebibytes.
+  this->m_TotalVirtualMemory = systeminfo.GetTotalVirtualMemory();
+  this->m_AvailableVirtualMemory = systeminfo.GetAvailableVirtualMemory();
+  this->m_TotalPhysicalMemory = systeminfo.GetTotalPhysicalMemory();
+  this->m_AvailablePhysicalMemory = systeminfo.GetAvailablePhysicalMemory();
+
+  // x86 lists "flags", Arm lists "Features".
+  std::string flags = ReadCPUInfo("flags");
+  if (flags.empty())
+  {
+    flags = ReadCPUInfo("Features");
+  }
+  std::istringstream flagStream(flags);
+  std::string        flag;
+  while (flagStream >> flag)
+  {
+    if (IsSIMDFlag(flag))
+    {
+      this->m_CPUFlags.push_back(flag);
+    }
+  }
+  std::sort(this->m_CPUFlags.begin(), this->m_CPUFlags.end());
+  this->m_Microcode = ReadCPUInfo("microcode");
+
+  const std::string cpu = "/sys/devices/system/cpu/";
+  this->m_ScalingDriver = ReadFirstLine(cpu + "cpu0/cpufreq/scaling_driver");
+  this->m_ScalingGovernor = ReadFirstLine(cpu + "cpu0/cpufreq/scaling_governor");
+  if (this->m_ScalingDriver.empty())
+  {
+    this->m_ScalingDriver = "Unknown";
+  }
+  if (this->m_ScalingGovernor.empty())
+  {
+    this->m_ScalingGovernor = "Unknown";
+  }
+  const std::string noTurbo = ReadFirstLine(cpu + "intel_pstate/no_turbo");
+  const std::string boost = ReadFirstLine(cpu + "cpufreq/boost");
+  if (!noTurbo.empty())
+  {
+    this->m_TurboBoost = noTurbo == "0" ? "Enabled" : "Disabled";
+  }
+  else if (!boost.empty())
+  {
+    this->m_TurboBoost = boost == "1" ? "Enabled" : "Disabled";
+  }
+  else
+  {
+    this->m_TurboBoost = "Unknown";
+  }
+  this->m_SMT = ReadFirstLine(cpu + "smt/control");
+  if (this->m_SMT.empty())
+  {
+    this->m_SMT = "Unknown";
+  }
+
+  for (unsigned int index = 0;; ++index)
+  {
+    const std::string cache = cpu + "cpu0/cache/index" + std::to_string(index) + '/';
+    const std::string level = ReadFirstLine(cache + "level");
+    if (level.empty())
+    {
+      break;
+    }
+    CacheLevel cacheLevel;
+    cacheLevel.m_Level = static_cast<unsigned int>(std::stoul(level));
+    cacheLevel.m_Type = ReadFirstLine(cache + "type");
+    cacheLevel.m_Size = ParseSize(ReadFirstLine(cache + "size"));
+    const std::string lineSize = ReadFirstLine(cache + "coherency_line_size");
+    cacheLevel.m_LineSize = lineSize.empty() ? 0 : static_cast<unsigned int>(std::stoul(lineSize));
+    cacheLevel.m_SharedCPUs = ReadFirstLine(cache + "shared_cpu_list");
+    this->m_Caches.push_back(cacheLevel);
+  }
+
+  for (const unsigned int id : ParseCPUList(ReadFirstLine(cpu + "online")))
+  {
+    const std::string topology = cpu + "cpu" + std::to_string(id) + "/topology/";
+    const std::string package = ReadFirstLine(topology + "physical_package_id");
+    const std::string core = ReadFirstLine(topology + "core_id");
+    CPUTopology       cpuTopology;
+    cpuTopology.m_CPU = id;
+    cpuTopology.m_Package = package.empty() ? 0 : static_cast<unsigned int>(std::stoul(package));
+    cpuTopology.m_Core = core.empty() ? id : static_cast<unsigned int>(std::stoul(core));
+    // The last level cache is the one with the highest level.
+    unsigned int lastLevel = 0;
+    for (unsigned int index = 0;; ++index)
+    {
+      const std::string cache = cpu + "cpu" + std::to_string(id) + "/cache/index" + std::to_string(index) + '/';
+      const std::string level = ReadFirstLine(cache + "level");
+      if (level.empty())
+      {
+        break;
+      }
+      const std::vector<unsigned int> sharedCPUs = ParseCPUList(ReadFirstLine(cache + "shared_cpu_list"));
+      if (std::stoul(level) >= lastLevel && !sharedCPUs.empty())
+      {
+        lastLevel = static_cast<unsigned int>(std::stoul(level));
+        cpuTopology.m_LastLevelCache = sharedCPUs.front();
+      }
+    }
+    this->m_CPUTopology.push_back(cpuTopology);
+  }
+
+  const std::string node = "/sys/devices/system/node/";
+  for (const unsigned int id : ParseCPUList(ReadFirstLine(node + "online")))
+  {
+    NUMANode numaNode;
+    numaNode.m_Id = id;
+    numaNode.m_CPUs = ReadFirstLine(node + "node" + std::to_string(id) + "/cpulist");
+    // "Node 0 MemTotal:       32768000 kB"
+    std::ifstream meminfo(node + "node" + std::to_string(id) + "/meminfo");
+    std::string   line;
+    while (std::getline(meminfo, line))
+    {
+      const std::size_t memTotal = line.find("MemTotal:");
+      if (memTotal != std::string::npos)
+      {
+        std::istringstream(line.substr(memTotal + 9)) >> numaNode.m_MemoryTotal;
+        break;
+      }
+    }
+    this->m_NUMANodes.push_back(numaNode);
+  }
+
+  this->m_KernelCommandLine = ReadFirstLine("/proc/cmdline");
+  std::istringstream options(this->m_KernelCommandLine);
+  std::string        option;
+  while (options >> option)
+  {
+    if (option.compare(0, 9, "isolcpus=") == 0)
+    {
+      this->m_IsolatedCPUs = option.substr(9);
+    }
+    else if (option.compare(0, 10, "nohz_full=") == 0)
+    {
+      this->m_NoHzFullCPUs = option.substr(10);
+    }
+  }
+
+  this->m_TransparentHugePages = ReadSelectedValue("/sys/kernel/mm/transparent_hugepage/enabled");
+  this->m_TransparentHugePagesDefrag = ReadSelectedValue("/sys/kernel/mm/transparent_hugepage/defrag");
+}
+
+
+const BenchmarkSystemInformation &
+BenchmarkSystemInformation::GetInstance()
+{
+  static const BenchmarkSystemInformation instance;
+  return instance;
+}
+
+
+bool
+BenchmarkSystemInformation::HasCPUFlag(const std::string & flag) const
+{
+  return std::binary_search(this->m_CPUFlags.begin(), this->m_CPUFlags.end(), flag);
+}
+
+
+std::string
+BenchmarkSystemInformation::GetCacheRegime(SizeValueType bytes) const
+{
+  if (this->m_Caches.empty())
+  {
+    return "Unknown";
+  }
+  const CacheLevel * regime = nullptr;
+  for (const auto & cache : this->m_Caches)
+  {
+    if (cache.m_Type != "Instruction" && cache.m_Size >= bytes && (regime == nullptr || cache.m_Size < regime->m_Size))
+    {
+      regime = &cache;
+    }
+  }
+  return regime != nullptr ? "L" + std::to_string(regime->m_Level) : "DRAM";
+}
+
+
+void
+BenchmarkSystemInformation::Print(std::ostream & os) const
+{
+  constexpr int tabwidth = 15;
+
+  os << "System:              " << this->m_HostName << std::endl;
+  os << "Processor:           " << this->m_ProcessorName << std::endl;
+  os << "    Cache:           " << this->m_ProcessorCacheSize << std::endl;
+  os << "    Clock:           " << this->m_ProcessorClockFrequency << std::endl;
+  os << "    Physical CPUs:   " << this->m_NumberOfPhysicalCPU << std::endl;
+  os << "    Logical CPUs:    " << this->m_NumberOfLogicalCPU << std::endl;
+  // Retrieve memory information in mebibytes.
+  os << "    Virtual Memory:  Total: " << std::left << std::setw(tabwidth) << this->m_TotalVirtualMemory
+     << " Available: " << this->m_AvailableVirtualMemory << std::endl;
+  os << "    Physical Memory: Total: " << std::left << std::setw(tabwidth) << this->m_TotalPhysicalMemory
+     << " Available: " << this->m_AvailablePhysicalMemory << std::endl;
+  os << "    SIMD:            ";
+  for (const auto & flag : this->m_CPUFlags)
+  {
+    os << flag << ' ';
+  }
+  os << std::endl;
+  os << "    Frequency:       driver: " << this->m_ScalingDriver << ", governor: " << this->m_ScalingGovernor
+     << ", turbo boost: " << this->m_TurboBoost << ", SMT: " << this->m_SMT << std::endl;
+  os << "    NUMA Nodes:      " << this->m_NUMANodes.size() << std::endl;
+
+  os << "OSName:              " << this->m_OSName << std::endl;
+  os << "    Release:         " << this->m_OSRelease << std::endl;
+  os << "    Version:         " << this->m_OSVersion << std::endl;
+  os << "    Platform:        " << this->m_OSPlatform << std::endl;
+
+  os << "    Operating System is " << (this->m_Is64Bits ? "64 bit" : "32 bit") << std::endl;
+  if (!this->m_IsolatedCPUs.empty() || !this->m_NoHzFullCPUs.empty())
+  {
+    os << "    Isolated CPUs:   " << this->m_IsolatedCPUs << ", nohz_full: " << this->m_NoHzFullCPUs << std::endl;
+  }
+  os << "    Transparent Huge Pages: " << this->m_TransparentHugePages << std::endl;
+
+  os << "ITK Version: " << this->m_ITKVersion << std::endl;
+}
+
+
+void
+BenchmarkSystemInformation::PrintJSON(std::ostream & os) const
+{
+  os << "{\n";
+  PrintJSONValue(os, "System", this->m_HostName, 4);
+
+  os << "    \"Processor\" :{\n";
+  PrintJSONValue(os, "Name", this->m_ProcessorName, 6);
+  PrintJSONValue(os, "Cache", this->m_ProcessorCacheSize, 6);
+  PrintJSONValue(os, "Clock", this->m_ProcessorClockFrequency, 6);
+  PrintJSONValue(os, "Physical CPUs", this->m_NumberOfPhysicalCPU, 6);
+  PrintJSONValue(os, "Logical CPUs", this->m_NumberOfLogicalCPU, 6);
+  PrintJSONValue(os, "Virtual Memory Total", this->m_TotalVirtualMemory, 6);
+  PrintJSONValue(os, "Virtual Memory Available", this->m_AvailableVirtualMemory, 6);
+  PrintJSONValue(os, "Physical Memory Total", this->m_TotalPhysicalMemory, 6);
+  PrintJSONValue(os, "Physical Memory Available", this->m_AvailablePhysicalMemory, 6);
+  os << "      \"Flags\": [";
+  for (size_t ii = 0; ii < this->m_CPUFlags.size(); ++ii)
+  {
+    os << (ii > 0 ? ", \"" : "\"") << this->m_CPUFlags[ii] << '"';
+  }
+  os << "],\n";
+  PrintJSONValue(os, "Microcode", this->m_Microcode, 6);
+  PrintJSONValue(os, "ScalingDriver", this->m_ScalingDriver, 6);
+  PrintJSONValue(os, "ScalingGovernor", this->m_ScalingGovernor, 6);
+  PrintJSONValue(os, "TurboBoost", this->m_TurboBoost, 6);
+  PrintJSONValue(os, "SMT", this->m_SMT, 6);
+  os << "      \"Caches\": [";
+  for (size_t ii = 0; ii < this->m_Caches.size(); ++ii)
+  {
+    const CacheLevel & cache = this->m_Caches[ii];
+    os << (ii > 0 ? ",\n" : "\n") << "        { \"Level\": " << cache.m_Level << ", \"Type\": \"" << cache.m_Type
+       << "\", \"Size\": " << cache.m_Size << ", \"LineSize\": " << cache.m_LineSize << ", \"SharedCPUs\": \""
+       << cache.m_SharedCPUs << "\" }";
+  }
+  os << (this->m_Caches.empty() ? "],\n" : "\n      ],\n");
+  os << "      \"NUMANodes\": [";
+  for (size_t ii = 0; ii < this->m_NUMANodes.size(); ++ii)
+  {
+    const NUMANode & node = this->m_NUMANodes[ii];
+    os << (ii > 0 ? ",\n" : "\n") << "        { \"Id\": " << node.m_Id << ", \"CPUs\": \"" << node.m_CPUs
+       << "\", \"MemoryTotal\": " << node.m_MemoryTotal << " }";
+  }
+  os << (this->m_NUMANodes.empty() ? "]\n" : "\n      ]\n");
+  os << "    },\n";
+
+  os << "    \"OperatingSystem\" :{\n";
+  PrintJSONValue(os, "Name", this->m_OSName, 6);
+  PrintJSONValue(os, "Release", this->m_OSRelease, 6);
+  PrintJSONValue(os, "Version", this->m_OSVersion, 6);
+  PrintJSONValue(os, "Platform", this->m_OSPlatform, 6);
+  PrintJSONValue(os, "Bitness", std::string(this->m_Is64Bits ? "64 bit" : "32 bit"), 6);
+  PrintJSONValue(os, "KernelCommandLine", this->m_KernelCommandLine, 6);
+  PrintJSONValue(os, "IsolatedCPUs", this->m_IsolatedCPUs, 6);
+  PrintJSONValue(os, "NoHzFullCPUs", this->m_NoHzFullCPUs, 6);
+  PrintJSONValue(os, "TransparentHugePages", this->m_TransparentHugePages, 6);
+  PrintJSONValue(os, "TransparentHugePagesDefrag", this->m_TransparentHugePagesDefrag, 6, false);
+  os << "    },\n";
+
+  PrintJSONValue(os, "ITKVersion", this->m_ITKVersion, 4, false);
+  os << "  }";
+}
+
+
+std::vector<unsigned int>
+BenchmarkSystemInformation::ParseCPUList(const std::string & cpuList)
+{
+  std::vector<unsigned int> cpus;
+  std::istringstream        ranges(cpuList);
+  std::string               range;
+  while (std::getline(ranges, range, ','))
+  {
+    const std::size_t dash = range.find('-');
+    try
+    {
+      const auto first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+      const auto last =
+        dash == std::string::npos ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+      for (unsigned int id = first; id <= last; ++id)
+      {
+        cpus.push_back(id);
+      }
+    }
+    catch (const std::exception &)
+    {
+      // Ignore the malformed ranges, and the empty list.
+    }
+  }
+  return cpus;
+}
+
+} // end namespace itk
@@ -0,0 +1,242 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkThreadPlacement.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace itk
+{
+namespace
+{
+
+using ThreadPlacementEnum = BenchmarkThreadPlacement::ThreadPlacementEnum;
+
+std::string
+ToLowerAlphanumeric(const std::string & value)
+{
+  std::string result;
+  for (const unsigned char c : value)
+  {
+    if (std::isalnum(c))
+    {
+      result.push_back(static_cast<char>(std::tolower(c)));
+    }
+  }
+  return result;
+}
+
+/** Position of a key in the sorted set of the keys. */
+template <typename TKey>
+std::map<TKey, unsigned int>
+GetRanks(const std::set<TKey> & keys)
+{
+  std::map<TKey, unsigned int> ranks;
+  for (const TKey & key : keys)
+  {
+    const auto rank = static_cast<unsigned int>(ranks.size());
+    ranks[key] = rank;
+  }
+  return ranks;
+}
+
+} // namespace
+
+
+std::vector<unsigned int>
+BenchmarkThreadPlacement::GetCPUOrder(ThreadPlacementEnum policy, const std::vector<unsigned int> & cpus)
+{
+  return GetCPUOrder(policy, cpus, BenchmarkSystemInformation::GetInstance().GetCPUTopology());
+}
+
+
+std::vector<unsigned int>
+BenchmarkThreadPlacement::GetCPUOrder(ThreadPlacementEnum               policy,
+                                      const std::vector<unsigned int> & cpus,
+                                      const std::vector<CPUTopology> &  topology)
+{
+  if (policy == ThreadPlacementEnum::None)
+  {
+    return cpus;
+  }
+
+  const std::set<unsigned int> requested(cpus.begin(), cpus.end());
+  std::vector<CPUTopology>     placed;
+  for (const CPUTopology & cpu : topology)
+  {
+    if (requested.count(cpu.m_CPU) > 0)
+    {
+      placed.push_back(cpu);
+    }
+  }
+  std::sort(placed.begin(), placed.end(), [](const CPUTopology & a, const CPUTopology & b) {
+    return a.m_CPU < b.m_CPU;
+  });
+
+  // A core is identified by its package and its id in the package. The
+  // cores are first ordered compactly: by package, by last level cache,
+  // then by their first CPU.
+  using CoreType = std::pair<unsigned int, unsigned int>;
+  using CompactCoreType = std::array<unsigned int, 3>;
+  std::map<CoreType, unsigned int> firstCPUOfCore;
+  for (const CPUTopology & cpu : placed)
+  {
+    firstCPUOfCore.emplace(CoreType(cpu.m_Package, cpu.m_Core), cpu.m_CPU);
+  }
+  std::set<CompactCoreType> compactCores;
+  std::set<CoreType>        caches;
+  for (const CPUTopology & cpu : placed)
+  {
+    compactCores.insert({ cpu.m_Package, cpu.m_LastLevelCache, firstCPUOfCore[CoreType(cpu.m_Package, cpu.m_Core)] });
+    caches.insert(CoreType(cpu.m_Package, cpu.m_LastLevelCache));
+  }
+  const std::map<CompactCoreType, unsigned int> coreRanks = GetRanks(compactCores);
+
+  // Position of each core in its package and in its cache, and of each cache
+  // in an order alternating between the packages.
+  std::map<CompactCoreType, unsigned int> coreInPackage;
+  std::map<CompactCoreType, unsigned int> coreInCache;
+  std::map<unsigned int, unsigned int>    coresInPackage;
+  std::map<CoreType, unsigned int>        coresInCache;
+  for (const CompactCoreType & core : compactCores)
+  {
+    coreInPackage[core] = coresInPackage[core[0]]++;
+    coreInCache[core] = coresInCache[CoreType(core[0], core[1])]++;
+  }
+  std::map<unsigned int, unsigned int> cachesInPackage;
+  std::set<CompactCoreType>            scatteredCaches;
+  for (const CoreType & cache : caches)
+  {
+    scatteredCaches.insert({ cachesInPackage[cache.first]++, cache.first, cache.second });
+  }
+  std::map<CoreType, unsigned int> cacheRanks;
+  for (const auto & cache : GetRanks(scatteredCaches))
+  {
+    cacheRanks[CoreType(cache.first[1], cache.first[2])] = cache.second;
+  }
+
+  // Sort the CPUs by the hardware thread in the core and by the position of
+  // the core for the policy.
+  using KeyType = std::array<unsigned int, 3>;
+  std::map<CoreType, unsigned int>              threadsInCore;
+  std::vector<std::pair<KeyType, unsigned int>> keys;
+  for (const CPUTopology & cpu : placed)
+  {
+    const CoreType        coreId(cpu.m_Package, cpu.m_Core);
+    const CompactCoreType core{ cpu.m_Package, cpu.m_LastLevelCache, firstCPUOfCore[coreId] };
+    const unsigned int    thread = threadsInCore[coreId]++;
+    KeyType               key{};
+    switch (policy)
+    {
+      case ThreadPlacementEnum::ScatterCores:
+        key = { thread, coreInPackage[core], cpu.m_Package };
+        break;
+      case ThreadPlacementEnum::ScatterCaches:
+        key = { thread, coreInCache[core], cacheRanks[CoreType(cpu.m_Package, cpu.m_LastLevelCache)] };
+        break;
+      case ThreadPlacementEnum::SMTSiblings:
+        key = { coreRanks.at(core), thread, 0 };
+        break;
+      case ThreadPlacementEnum::Compact:
+      default:
+        key = { thread, coreRanks.at(core), 0 };
+        break;
+    }
+    keys.emplace_back(key, cpu.m_CPU);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<unsigned int> order;
+  for (const auto & key : keys)
+  {
+    order.push_back(key.second);
+  }
+  // The CPUs of unknown topology come last, as given.
+  for (const unsigned int cpu : cpus)
+  {
+    if (std::find(order.begin(), order.end(), cpu) == order.end())
+    {
+      order.push_back(cpu);
+    }
+  }
+  return order;
+}
+
+
+const char *
+BenchmarkThreadPlacement::ToString(ThreadPlacementEnum policy)
+{
+  switch (policy)
+  {
+    case ThreadPlacementEnum::None:
+      return "None";
+    case ThreadPlacementEnum::Compact:
+      return "Compact";
+    case ThreadPlacementEnum::ScatterCores:
+      return "ScatterCores";
+    case ThreadPlacementEnum::ScatterCaches:
+      return "ScatterCaches";
+    case ThreadPlacementEnum::SMTSiblings:
+      return "SMTSiblings";
+    default:
+      return "INVALID VALUE FOR itk::BenchmarkThreadPlacement::ThreadPlacementEnum";
+  }
+}
+
+
+bool
+BenchmarkThreadPlacement::FromString(const std::string & name, ThreadPlacementEnum & policy)
+{
+  const std::string simplifiedName = ToLowerAlphanumeric(name);
+  if (simplifiedName == "scatter")
+  {
+    policy = ThreadPlacementEnum::ScatterCores;
+    return true;
+  }
+  if (simplifiedName == "smt")
+  {
+    policy = ThreadPlacementEnum::SMTSiblings;
+    return true;
+  }
+  for (const auto candidate : { ThreadPlacementEnum::None,
+                                 ThreadPlacementEnum::Compact,
+                                 ThreadPlacementEnum::ScatterCores,
+                                 ThreadPlacementEnum::ScatterCaches,
+                                 ThreadPlacementEnum::SMTSiblings })
+  {
+    if (simplifiedName == ToLowerAlphanumeric(ToString(candidate)))
+    {
+      policy = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+std::ostream &
+operator<<(std::ostream & out, const BenchmarkThreadPlacement::ThreadPlacementEnum value)
+{
+  return out << BenchmarkThreadPlacement::ToString(value);
+}
+
+} // end namespace itk
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkThreadScaling.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+void
+BenchmarkThreadScaling::AddMeasurement(unsigned int threads, double seconds)
+{
+  this->m_Times[std::max(threads, 1u)] = seconds;
+}
+
+
+std::vector<unsigned int>
+BenchmarkThreadScaling::GetThreads() const
+{
+  std::vector<unsigned int> threads;
+  for (const auto & time : this->m_Times)
+  {
+    threads.push_back(time.first);
+  }
+  return threads;
+}
+
+
+double
+BenchmarkThreadScaling::GetTime(unsigned int threads) const
+{
+  const auto found = this->m_Times.find(threads);
+  return found != this->m_Times.end() ? found->second : 0.0;
+}
+
+
+unsigned int
+BenchmarkThreadScaling::GetReferenceThreads() const
+{
+  return this->m_Times.empty() ? 0 : this->m_Times.begin()->first;
+}
+
+
+double
+BenchmarkThreadScaling::GetSpeedup(unsigned int threads) const
+{
+  const double time = this->GetTime(threads);
+  if (this->m_Times.empty() || time <= 0.0)
+  {
+    return 0.0;
+  }
+  return this->m_Times.begin()->second / time;
+}
+
+
+double
+BenchmarkThreadScaling::GetEfficiency(unsigned int threads) const
+{
+  if (this->m_Times.empty())
+  {
+    return 0.0;
+  }
+  return this->GetSpeedup(threads) * this->GetReferenceThreads() / static_cast<double>(threads);
+}
+
+
+double
+BenchmarkThreadScaling::GetKarpFlattSerialFraction(unsigned int threads) const
+{
+  const double speedup = this->GetSpeedup(threads);
+  const double relativeThreads = static_cast<double>(threads) / std::max(this->GetReferenceThreads(), 1u);
+  if (speedup <= 0.0 || relativeThreads <= 1.0)
+  {
+    return 0.0;
+  }
+  return (1.0 / speedup - 1.0 / relativeThreads) / (1.0 - 1.0 / relativeThreads);
+}
+
+
+double
+BenchmarkThreadScaling::GetAmdahlSerialFraction() const
+{
+  // 1 / speedup - 1 / n = f (1 - 1 / n), fitted through the origin.
+  double products = 0.0;
+  double squares = 0.0;
+  for (const unsigned int threads : this->GetThreads())
+  {
+    const double speedup = this->GetSpeedup(threads);
+    const double reciprocal = static_cast<double>(this->GetReferenceThreads()) / threads;
+    if (speedup > 0.0)
+    {
+      products += (1.0 - reciprocal) * (1.0 / speedup - reciprocal);
+      squares += (1.0 - reciprocal) * (1.0 - reciprocal);
+    }
+  }
+  return squares > 0.0 ? std::clamp(products / squares, 0.0, 1.0) : 0.0;
+}
+
+
+void
+BenchmarkThreadScaling::PrintJSON(std::ostream & os) const
+{
+  const double serialFraction = this->GetAmdahlSerialFraction();
+  os << "{\n";
+  os << "    \"ReferenceThreads\": " << this->GetReferenceThreads() << ",\n";
+  os << "    \"Threads\": {";
+  bool first = true;
+  for (const unsigned int threads : this->GetThreads())
+  {
+    os << (first ? "\n" : ",\n");
+    first = false;
+    os << "      \"" << threads << "\": {\n";
+    os << "        \"Time\": " << this->GetTime(threads) << ",\n";
+    os << "        \"Speedup\": " << this->GetSpeedup(threads) << ",\n";
+    os << "        \"Efficiency\": " << this->GetEfficiency(threads) << ",\n";
+    os << "        \"KarpFlattSerialFraction\": " << this->GetKarpFlattSerialFraction(threads) << "\n";
+    os << "      }";
+  }
+  os << "\n    },\n";
+  os << "    \"AmdahlSerialFraction\": " << serialFraction << ",\n";
+  // JSON has no infinity: the unbounded speedup of a serial fraction of 0 is
+  // null.
+  os << "    \"AmdahlMaximumSpeedup\": ";
+  if (serialFraction > 0.0)
+  {
+    os << 1.0 / serialFraction << "\n";
+  }
+  else
+  {
+    os << "null\n";
+  }
+  os << "  }";
+}
+
+} // end namespace itk
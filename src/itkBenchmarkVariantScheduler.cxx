@@ -0,0 +1,152 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkBenchmarkVariantScheduler.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace itk
+{
+
+BenchmarkVariantScheduler::BenchmarkVariantScheduler(unsigned int numberOfVariants, uint32_t seed)
+  : m_Seed(seed)
+  , m_Generator(seed)
+  , m_Order(std::max(numberOfVariants, 1u))
+  , m_Samples(std::max(numberOfVariants, 1u))
+  , m_PositionSums(std::max(numberOfVariants, 1u), 0.0)
+{
+  std::iota(this->m_Order.begin(), this->m_Order.end(), 0u);
+}
+
+
+const BenchmarkVariantScheduler::OrderType &
+BenchmarkVariantScheduler::NextBlock()
+{
+  // Fisher-Yates, with the generator rather than std::shuffle, whose
+  // algorithm differs between the standard libraries.
+  for (size_t ii = this->m_Order.size() - 1; ii > 0; --ii)
+  {
+    std::swap(this->m_Order[ii], this->m_Order[this->m_Generator() % (ii + 1)]);
+  }
+  for (size_t position = 0; position < this->m_Order.size(); ++position)
+  {
+    this->m_PositionSums[this->m_Order[position]] += static_cast<double>(position);
+  }
+  ++this->m_NumberOfDrawnBlocks;
+  return this->m_Order;
+}
+
+
+void
+BenchmarkVariantScheduler::AddSample(unsigned int variant, double seconds)
+{
+  this->m_Samples[variant].push_back(seconds);
+}
+
+
+SizeValueType
+BenchmarkVariantScheduler::GetNumberOfBlocks() const
+{
+  SizeValueType blocks = this->m_Samples.front().size();
+  for (const auto & samples : this->m_Samples)
+  {
+    blocks = std::min<SizeValueType>(blocks, samples.size());
+  }
+  return blocks;
+}
+
+
+double
+BenchmarkVariantScheduler::GetMeanPosition(unsigned int variant) const
+{
+  if (this->m_NumberOfDrawnBlocks == 0)
+  {
+    return 0.0;
+  }
+  return this->m_PositionSums[variant] / static_cast<double>(this->m_NumberOfDrawnBlocks);
+}
+
+
+std::vector<double>
+BenchmarkVariantScheduler::GetPairedRatios(unsigned int variant, unsigned int reference) const
+{
+  const SizeValueType blocks = this->GetNumberOfBlocks();
+  std::vector<double> ratios;
+  ratios.reserve(blocks);
+  for (SizeValueType block = 0; block < blocks; ++block)
+  {
+    const double referenceTime = this->m_Samples[reference][block];
+    if (referenceTime > 0.0)
+    {
+      ratios.push_back(this->m_Samples[variant][block] / referenceTime);
+    }
+  }
+  return ratios;
+}
+
+
+BenchmarkRobustStatistics
+BenchmarkVariantScheduler::GetPairedRatioStatistics(unsigned int variant, unsigned int reference) const
+{
+  return BenchmarkRobustStatistics::Compute(this->GetPairedRatios(variant, reference));
+}
+
+
+SizeValueType
+BenchmarkVariantScheduler::GetNumberOfFasterBlocks(unsigned int variant, unsigned int reference) const
+{
+  const SizeValueType blocks = this->GetNumberOfBlocks();
+  SizeValueType       faster = 0;
+  for (SizeValueType block = 0; block < blocks; ++block)
+  {
+    if (this->m_Samples[variant][block] < this->m_Samples[reference][block])
+    {
+      ++faster;
+    }
+  }
+  return faster;
+}
+
+
+void
+BenchmarkVariantScheduler::PrintJSON(std::ostream &                   os,
+                                     const std::vector<std::string> & names,
+                                     unsigned int                     reference) const
+{
+  os << "{\n";
+  os << "    \"Seed\": " << this->m_Seed << ",\n";
+  os << "    \"Blocks\": " << this->GetNumberOfBlocks() << ",\n";
+  os << "    \"Reference\": \"" << names[reference] << "\",\n";
+  os << "    \"Variants\": {";
+  for (unsigned int variant = 0; variant < this->GetNumberOfVariants(); ++variant)
+  {
+    const BenchmarkRobustStatistics ratios = this->GetPairedRatioStatistics(variant, reference);
+    os << (variant == 0 ? "\n" : ",\n");
+    os << "      \"" << names[variant] << "\": {\n";
+    os << "        \"MeanPosition\": " << this->GetMeanPosition(variant) << ",\n";
+    os << "        \"MedianRatio\": " << ratios.GetMedian() << ",\n";
+    os << "        \"RatioConfidenceIntervalLower\": " << ratios.GetMedianConfidenceInterval().first << ",\n";
+    os << "        \"RatioConfidenceIntervalUpper\": " << ratios.GetMedianConfidenceInterval().second << ",\n";
+    os << "        \"FasterBlocks\": " << this->GetNumberOfFasterBlocks(variant, reference) << "\n";
+    os << "      }";
+  }
+  os << "\n    }\n";
+  os << "  }";
+}
+
+} // end namespace itk
@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCPUTimeProbe.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <ctime>
+#  include <sys/resource.h>
+#endif
+
+namespace itk
+{
+
+CPUTimeProbe ::CPUTimeProbe()
+  : LOCAL_ResourceProbe<TimeStampType, TimeStampType>("CPUTime", "s")
+{}
+
+
+CPUTimeProbe ::~CPUTimeProbe() = default;
+
+
+CPUTimeProbe::TimeStampType
+CPUTimeProbe ::GetInstantValue() const
+{
+  this->m_InstantWallTime =
+    std::chrono::duration<TimeStampType>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+#if defined(_WIN32)
+  FILETIME creationTime;
+  FILETIME exitTime;
+  FILETIME kernelTime;
+  FILETIME userTime;
+  GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+  // 100 nanosecond units.
+  const auto toSeconds = [](const FILETIME & time) {
+    return static_cast<TimeStampType>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) *
+           1e-7;
+  };
+  return toSeconds(kernelTime) + toSeconds(userTime);
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    this->m_InstantVoluntaryContextSwitches = static_cast<SizeValueType>(usage.ru_nvcsw);
+    this->m_InstantInvoluntaryContextSwitches = static_cast<SizeValueType>(usage.ru_nivcsw);
+  }
+
+  timespec cpuTime;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTime);
+  return static_cast<TimeStampType>(cpuTime.tv_sec) + static_cast<TimeStampType>(cpuTime.tv_nsec) * 1e-9;
+#endif
+}
+
+
+void
+CPUTimeProbe ::Start()
+{
+  this->m_MeasuredNumberOfThreads =
+    this->m_NumberOfThreads > 0 ? this->m_NumberOfThreads : MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+
+  LOCAL_ResourceProbe<TimeStampType, TimeStampType>::Start();
+  this->m_StartWallTime = this->m_InstantWallTime;
+  this->m_StartVoluntaryContextSwitches = this->m_InstantVoluntaryContextSwitches;
+  this->m_StartInvoluntaryContextSwitches = this->m_InstantInvoluntaryContextSwitches;
+}
+
+
+void
+CPUTimeProbe ::Stop()
+{
+  const CountType numberOfStops = this->GetNumberOfStops();
+  LOCAL_ResourceProbe<TimeStampType, TimeStampType>::Stop();
+  if (this->GetNumberOfStops() == numberOfStops)
+  {
+    return;
+  }
+
+  const TimeStampType wallTime = this->m_InstantWallTime - this->m_StartWallTime;
+  this->m_WallTimeValues.push_back(wallTime);
+  this->m_TotalWallTime += wallTime;
+  this->m_VoluntaryContextSwitches += this->m_InstantVoluntaryContextSwitches - this->m_StartVoluntaryContextSwitches;
+  this->m_InvoluntaryContextSwitches +=
+    this->m_InstantInvoluntaryContextSwitches - this->m_StartInvoluntaryContextSwitches;
+}
+
+
+void
+CPUTimeProbe ::Reset()
+{
+  LOCAL_ResourceProbe<TimeStampType, TimeStampType>::Reset();
+  this->m_WallTimeValues.clear();
+  this->m_TotalWallTime = 0.0;
+  this->m_VoluntaryContextSwitches = 0;
+  this->m_InvoluntaryContextSwitches = 0;
+}
+
+
+void
+CPUTimeProbe ::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  this->m_NumberOfThreads = numberOfThreads;
+}
+
+
+unsigned int
+CPUTimeProbe ::GetNumberOfThreads() const
+{
+  return this->m_NumberOfThreads > 0 ? this->m_NumberOfThreads : this->m_MeasuredNumberOfThreads;
+}
+
+
+double
+CPUTimeProbe ::GetCPUUtilization() const
+{
+  return this->m_TotalWallTime > 0.0 ? this->GetTotal() / this->m_TotalWallTime : 0.0;
+}
+
+
+double
+CPUTimeProbe ::GetParallelEfficiency() const
+{
+  return this->GetCPUUtilization() / static_cast<double>(std::max(this->GetNumberOfThreads(), 1u));
+}
+
+
+void
+CPUTimeProbe ::PrintJSONMetadata(std::ostream & os)
+{
+  this->PrintJSONvar(os, "NumberOfThreads", this->GetNumberOfThreads());
+  this->PrintJSONvar(os, "WallTime", this->m_TotalWallTime);
+  os << "    \"WallTimeValues\": [";
+  for (size_t ii = 0; ii < this->m_WallTimeValues.size(); ++ii)
+  {
+    os << (ii > 0 ? ", " : "") << this->m_WallTimeValues[ii];
+  }
+  os << "],\n";
+  this->PrintJSONvar(os, "CPUUtilization", this->GetCPUUtilization());
+  this->PrintJSONvar(os, "ParallelEfficiency", this->GetParallelEfficiency());
+  this->PrintJSONvar(os, "VoluntaryContextSwitches", this->m_VoluntaryContextSwitches);
+  this->PrintJSONvar(os, "InvoluntaryContextSwitches", this->m_InvoluntaryContextSwitches);
+}
+
+} // end namespace itk
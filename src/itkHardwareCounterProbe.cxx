@@ -0,0 +1,406 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHardwareCounterProbe.h"
+
+#include <mutex>
+#include <sstream>
+
+#if defined(__linux__)
+#  include <cerrno>
+#  include <cstring>
+#  include <dirent.h>
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <vector>
+#endif
+
+namespace itk
+{
+
+/** The counters of all the threads of the process, opened once. */
+class HardwareCounterProbe::CounterSet
+{
+public:
+  CounterSet()
+  {
+#if defined(__linux__)
+    // Count the existing threads, e.g. an already started ITK thread pool;
+    // the threads they create afterwards inherit the counters.
+    DIR * tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+    {
+      this->m_UnavailabilityReason = std::string("/proc/self/task: ") + std::strerror(errno);
+      return;
+    }
+    std::vector<pid_t> threadIds;
+    while (const dirent * task = readdir(tasks))
+    {
+      if (task->d_name[0] != '.')
+      {
+        threadIds.push_back(static_cast<pid_t>(std::stol(task->d_name)));
+      }
+    }
+    closedir(tasks);
+
+    for (const pid_t threadId : threadIds)
+    {
+      std::array<int, NumberOfCounters> descriptors;
+      descriptors.fill(-1);
+      for (unsigned int counter = 0; counter < NumberOfCounters; ++counter)
+      {
+        // The first counter leads the group, so that all are scheduled together.
+        descriptors[counter] = OpenCounter(static_cast<HardwareCounterEnum>(counter), threadId, descriptors[0]);
+        if (counter == 0 && descriptors[0] < 0)
+        {
+          break;
+        }
+      }
+      if (descriptors[0] < 0)
+      {
+        // The thread may have exited in the meantime.
+        if (errno == ESRCH)
+        {
+          continue;
+        }
+        this->m_UnavailabilityReason = std::string("perf_event_open: ") + std::strerror(errno);
+        this->Close();
+        return;
+      }
+      this->m_Descriptors.push_back(descriptors);
+    }
+
+    for (unsigned int counter = 0; counter < NumberOfCounters; ++counter)
+    {
+      this->m_IsAvailable[counter] = !this->m_Descriptors.empty() && this->m_Descriptors.front()[counter] >= 0;
+    }
+#else
+    this->m_UnavailabilityReason = "Hardware counters are only read on Linux.";
+#endif
+  }
+
+  ~CounterSet() { this->Close(); }
+
+  CounterSet(const CounterSet &) = delete;
+  CounterSet &
+  operator=(const CounterSet &) = delete;
+
+  /** Returns the counters shared by all the probes, opened on first use. */
+  static std::shared_ptr<CounterSet>
+  GetInstance()
+  {
+    static std::mutex                mutex;
+    static std::weak_ptr<CounterSet> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<CounterSet> counterSet = instance.lock();
+    if (!counterSet)
+    {
+      counterSet = std::make_shared<CounterSet>();
+      instance = counterSet;
+    }
+    return counterSet;
+  }
+
+  /** Sum of the counts of all the threads, scaled for multiplexing. */
+  void
+  Read(CounterArrayType & counts) const
+  {
+    counts.fill(0.0);
+#if defined(__linux__)
+    for (const auto & descriptors : this->m_Descriptors)
+    {
+      for (unsigned int counter = 0; counter < NumberOfCounters; ++counter)
+      {
+        if (descriptors[counter] < 0)
+        {
+          continue;
+        }
+        // value, time enabled, time running
+        uint64_t values[3];
+        if (read(descriptors[counter], values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)))
+        {
+          continue;
+        }
+        double count = static_cast<double>(values[0]);
+        if (values[2] > 0 && values[2] < values[1])
+        {
+          count *= static_cast<double>(values[1]) / static_cast<double>(values[2]);
+        }
+        counts[counter] += count;
+      }
+    }
+#endif
+  }
+
+  bool
+  IsAvailable(unsigned int counter) const
+  {
+    return this->m_IsAvailable[counter];
+  }
+
+  const std::string &
+  GetUnavailabilityReason() const
+  {
+    return this->m_UnavailabilityReason;
+  }
+
+private:
+#if defined(__linux__)
+  static int
+  OpenCounter(HardwareCounterEnum counter, pid_t threadId, int groupDescriptor)
+  {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    switch (counter)
+    {
+      case HardwareCounterEnum::Cycles:
+        attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case HardwareCounterEnum::Instructions:
+        attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case HardwareCounterEnum::LLCMisses:
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+      case HardwareCounterEnum::BranchMisses:
+        attributes.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case HardwareCounterEnum::DTLBMisses:
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    }
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, threadId, -1, groupDescriptor, 0));
+  }
+#endif
+
+  void
+  Close()
+  {
+#if defined(__linux__)
+    for (const auto & descriptors : this->m_Descriptors)
+    {
+      for (const int descriptor : descriptors)
+      {
+        if (descriptor >= 0)
+        {
+          close(descriptor);
+        }
+      }
+    }
+#endif
+    this->m_Descriptors.clear();
+    this->m_IsAvailable.fill(false);
+  }
+
+  std::vector<std::array<int, NumberOfCounters>> m_Descriptors;
+  std::array<bool, NumberOfCounters>             m_IsAvailable{};
+  std::string                                    m_UnavailabilityReason;
+};
+
+
+HardwareCounterProbe ::HardwareCounterProbe()
+  : LOCAL_ResourceProbe<CounterValueType, CounterValueType>("Cycles", "cycles")
+  , m_CounterSet(CounterSet::GetInstance())
+{}
+
+
+HardwareCounterProbe ::~HardwareCounterProbe() = default;
+
+
+HardwareCounterProbe::CounterValueType
+HardwareCounterProbe ::GetInstantValue() const
+{
+  this->m_CounterSet->Read(this->m_InstantCounts);
+  return this->m_InstantCounts[static_cast<unsigned int>(HardwareCounterEnum::Cycles)];
+}
+
+
+void
+HardwareCounterProbe ::Start()
+{
+  LOCAL_ResourceProbe<CounterValueType, CounterValueType>::Start();
+  this->m_StartCounts = this->m_InstantCounts;
+}
+
+
+void
+HardwareCounterProbe ::Stop()
+{
+  const CountType numberOfStops = this->GetNumberOfStops();
+  LOCAL_ResourceProbe<CounterValueType, CounterValueType>::Stop();
+  if (this->GetNumberOfStops() == numberOfStops)
+  {
+    return;
+  }
+  for (unsigned int counter = 0; counter < NumberOfCounters; ++counter)
+  {
+    const CounterValueType value = this->m_InstantCounts[counter] - this->m_StartCounts[counter];
+    this->m_CounterTotals[counter] += value;
+    this->m_CounterValues[counter].push_back(value);
+  }
+}
+
+
+void
+HardwareCounterProbe ::Reset()
+{
+  LOCAL_ResourceProbe<CounterValueType, CounterValueType>::Reset();
+  this->m_CounterTotals.fill(0.0);
+  for (auto & values : this->m_CounterValues)
+  {
+    values.clear();
+  }
+}
+
+
+bool
+HardwareCounterProbe ::IsAvailable() const
+{
+  return this->m_CounterSet->GetUnavailabilityReason().empty();
+}
+
+
+bool
+HardwareCounterProbe ::IsAvailable(HardwareCounterEnum counter) const
+{
+  return this->m_CounterSet->IsAvailable(static_cast<unsigned int>(counter));
+}
+
+
+std::string
+HardwareCounterProbe ::GetUnavailabilityReason() const
+{
+  return this->m_CounterSet->GetUnavailabilityReason();
+}
+
+
+const std::vector<HardwareCounterProbe::CounterValueType> &
+HardwareCounterProbe ::GetCounterValues(HardwareCounterEnum counter) const
+{
+  return this->m_CounterValues[static_cast<unsigned int>(counter)];
+}
+
+
+HardwareCounterProbe::CounterValueType
+HardwareCounterProbe ::GetCounterTotal(HardwareCounterEnum counter) const
+{
+  return this->m_CounterTotals[static_cast<unsigned int>(counter)];
+}
+
+
+double
+HardwareCounterProbe ::GetInstructionsPerCycle() const
+{
+  const CounterValueType cycles = this->GetCounterTotal(HardwareCounterEnum::Cycles);
+  return cycles > 0.0 ? this->GetCounterTotal(HardwareCounterEnum::Instructions) / cycles : 0.0;
+}
+
+
+double
+HardwareCounterProbe ::GetMissesPerKiloInstruction(HardwareCounterEnum counter) const
+{
+  const CounterValueType instructions = this->GetCounterTotal(HardwareCounterEnum::Instructions);
+  return instructions > 0.0 ? 1000.0 * this->GetCounterTotal(counter) / instructions : 0.0;
+}
+
+
+const char *
+HardwareCounterProbe ::ToString(HardwareCounterEnum counter)
+{
+  switch (counter)
+  {
+    case HardwareCounterEnum::Cycles:
+      return "Cycles";
+    case HardwareCounterEnum::Instructions:
+      return "Instructions";
+    case HardwareCounterEnum::LLCMisses:
+      return "LLCMisses";
+    case HardwareCounterEnum::BranchMisses:
+      return "BranchMisses";
+    case HardwareCounterEnum::DTLBMisses:
+      return "DTLBMisses";
+    default:
+      return "INVALID VALUE FOR itk::HardwareCounterProbe::HardwareCounterEnum";
+  }
+}
+
+
+void
+HardwareCounterProbe ::PrintJSONMetadata(std::ostream & os)
+{
+  os << "    \"HardwareCountersAvailable\": " << (this->IsAvailable() ? "true" : "false") << ",\n";
+  if (!this->IsAvailable())
+  {
+    this->PrintJSONvar(os, "HardwareCountersUnavailabilityReason", this->GetUnavailabilityReason());
+    return;
+  }
+
+  os << "    \"HardwareCounters\": {";
+  bool firstCounter = true;
+  for (unsigned int counter = 0; counter < NumberOfCounters; ++counter)
+  {
+    const auto hardwareCounter = static_cast<HardwareCounterEnum>(counter);
+    if (!this->IsAvailable(hardwareCounter))
+    {
+      continue;
+    }
+    os << (firstCounter ? "\n" : ",\n");
+    firstCounter = false;
+    os << "      \"" << ToString(hardwareCounter) << "\": { \"Total\": " << this->m_CounterTotals[counter]
+       << ", \"Values\": [";
+    const std::vector<CounterValueType> & values = this->m_CounterValues[counter];
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+      os << (ii > 0 ? ", " : "") << values[ii];
+    }
+    os << "] }";
+  }
+  os << "\n    },\n";
+
+  if (this->IsAvailable(HardwareCounterEnum::Instructions))
+  {
+    this->PrintJSONvar(os, "InstructionsPerCycle", this->GetInstructionsPerCycle());
+    for (const auto counter :
+         { HardwareCounterEnum::LLCMisses, HardwareCounterEnum::BranchMisses, HardwareCounterEnum::DTLBMisses })
+    {
+      if (this->IsAvailable(counter))
+      {
+        const std::string name = std::string(ToString(counter)) + "PerKiloInstruction";
+        this->PrintJSONvar(os, name.c_str(), this->GetMissesPerKiloInstruction(counter));
+      }
+    }
+  }
+}
+
+
+std::ostream &
+operator<<(std::ostream & out, const HardwareCounterProbe::HardwareCounterEnum value)
+{
+  return out << HardwareCounterProbe::ToString(value);
+}
+
+} // end namespace itk
@@ -0,0 +1,36 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHardwareCounterProbesCollector.h"
+
+namespace itk
+{
+
+HardwareCounterProbesCollector ::HardwareCounterProbesCollector() = default;
+
+
+HardwareCounterProbesCollector ::~HardwareCounterProbesCollector() = default;
+
+
+bool
+HardwareCounterProbesCollector ::IsAvailable() const
+{
+  // All the probes share the counters of the process.
+  return this->m_Probes.empty() ? HardwareCounterProbe().IsAvailable() : this->m_Probes.front().IsAvailable();
+}
+
+} // end namespace itk
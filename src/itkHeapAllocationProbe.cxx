@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHeapAllocationProbe.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace itk
+{
+
+HeapAllocationProbe ::HeapAllocationProbe()
+  : LOCAL_ResourceProbe<CountValueType, CountValueType>("HeapAllocations", "allocations")
+{}
+
+
+HeapAllocationProbe ::~HeapAllocationProbe()
+{
+  if (this->m_Tracking)
+  {
+    HeapAllocationTracker::StopTracking(this->m_TrackingCallSites);
+  }
+}
+
+
+HeapAllocationProbe::CountValueType
+HeapAllocationProbe ::GetInstantValue() const
+{
+  this->m_InstantCounters = HeapAllocationTracker::GetCounters();
+  return static_cast<CountValueType>(this->m_InstantCounters.m_Allocations);
+}
+
+
+void
+HeapAllocationProbe ::Start()
+{
+  if (!this->m_Tracking)
+  {
+    this->m_Tracking = true;
+    this->m_TrackingCallSites = this->m_RecordCallSites;
+    if (this->m_TrackingCallSites)
+    {
+      // Size the copies before the counting starts.
+      HeapAllocationTracker::GetCallSites(this->m_StopCallSites);
+      HeapAllocationTracker::GetCallSites(this->m_StartCallSites);
+    }
+    HeapAllocationTracker::StartTracking(this->m_TrackingCallSites);
+  }
+
+  LOCAL_ResourceProbe<CountValueType, CountValueType>::Start();
+  this->m_StartCounters = this->m_InstantCounters;
+}
+
+
+void
+HeapAllocationProbe ::Stop()
+{
+  const CountType numberOfStops = this->GetNumberOfStops();
+  LOCAL_ResourceProbe<CountValueType, CountValueType>::Stop();
+  if (this->GetNumberOfStops() == numberOfStops || !this->m_Tracking)
+  {
+    return;
+  }
+  if (this->m_TrackingCallSites)
+  {
+    HeapAllocationTracker::GetCallSites(this->m_StopCallSites);
+  }
+  HeapAllocationTracker::StopTracking(this->m_TrackingCallSites);
+  this->m_Tracking = false;
+
+  this->m_AllocatedBytesValues.push_back(this->m_InstantCounters.m_AllocatedBytes -
+                                         this->m_StartCounters.m_AllocatedBytes);
+  this->m_DeallocationsValues.push_back(this->m_InstantCounters.m_Deallocations -
+                                        this->m_StartCounters.m_Deallocations);
+
+  if (this->m_TrackingCallSites)
+  {
+    this->m_CallSites.resize(this->m_StopCallSites.size());
+    for (size_t ii = 0; ii < this->m_StopCallSites.size(); ++ii)
+    {
+      const CallSite & start = this->m_StartCallSites[ii];
+      const CallSite & stop = this->m_StopCallSites[ii];
+      this->m_CallSites[ii].m_Address = stop.m_Address;
+      this->m_CallSites[ii].m_Allocations += stop.m_Allocations - start.m_Allocations;
+      this->m_CallSites[ii].m_Bytes += stop.m_Bytes - start.m_Bytes;
+    }
+  }
+}
+
+
+void
+HeapAllocationProbe ::Reset()
+{
+  LOCAL_ResourceProbe<CountValueType, CountValueType>::Reset();
+  this->m_AllocatedBytesValues.clear();
+  this->m_DeallocationsValues.clear();
+  this->m_CallSites.clear();
+}
+
+
+std::vector<HeapAllocationProbe::CallSite>
+HeapAllocationProbe ::GetTopCallSites(size_t numberOfCallSites) const
+{
+  std::vector<CallSite> callSites;
+  std::copy_if(this->m_CallSites.begin(),
+               this->m_CallSites.end(),
+               std::back_inserter(callSites),
+               [](const CallSite & callSite) { return callSite.m_Allocations > 0; });
+  std::sort(callSites.begin(), callSites.end(), [](const CallSite & a, const CallSite & b) {
+    return a.m_Allocations > b.m_Allocations || (a.m_Allocations == b.m_Allocations && a.m_Bytes > b.m_Bytes);
+  });
+  if (callSites.size() > numberOfCallSites)
+  {
+    callSites.resize(numberOfCallSites);
+  }
+  return callSites;
+}
+
+
+void
+HeapAllocationProbe ::PrintJSONMetadata(std::ostream & os)
+{
+  const auto printValues = [&os](const char * name, const std::vector<SizeValueType> & values) {
+    os << "    \"" << name << "\": [";
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+      os << (ii > 0 ? ", " : "") << values[ii];
+    }
+    os << "],\n";
+  };
+
+  os << "    \"HeapAllocationTrackingAvailable\": " << (HeapAllocationTracker::IsAvailable() ? "true" : "false")
+     << ",\n";
+  SizeValueType allocatedBytes = 0;
+  for (const auto bytes : this->m_AllocatedBytesValues)
+  {
+    allocatedBytes += bytes;
+  }
+  SizeValueType deallocations = 0;
+  for (const auto count : this->m_DeallocationsValues)
+  {
+    deallocations += count;
+  }
+  this->PrintJSONvar(os, "AllocatedBytes", allocatedBytes);
+  printValues("AllocatedBytesValues", this->m_AllocatedBytesValues);
+  this->PrintJSONvar(os, "Deallocations", deallocations);
+  printValues("DeallocationsValues", this->m_DeallocationsValues);
+
+  if (this->m_RecordCallSites)
+  {
+    os << "    \"CallSites\": [";
+    bool firstCallSite = true;
+    for (const auto & callSite : this->GetTopCallSites())
+    {
+      os << (firstCallSite ? "\n" : ",\n");
+      firstCallSite = false;
+      // The symbol may contain characters that must be escaped in JSON.
+      std::string location = HeapAllocationTracker::GetCallSiteName(callSite.m_Address);
+      std::replace(location.begin(), location.end(), '"', '\'');
+      std::replace(location.begin(), location.end(), '\\', '/');
+      os << "      { \"Location\": \"" << location << "\", \"Allocations\": " << callSite.m_Allocations
+         << ", \"Bytes\": " << callSite.m_Bytes << " }";
+    }
+    os << (firstCallSite ? "],\n" : "\n    ],\n");
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,420 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkHeapAllocationTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#  include <cxxabi.h>
+#  include <execinfo.h>
+#endif
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#  include <malloc.h>
+#  define ITK_BENCHMARK_RETURN_ADDRESS() _ReturnAddress()
+#elif defined(__GNUC__)
+#  define ITK_BENCHMARK_RETURN_ADDRESS() __builtin_return_address(0)
+#else
+#  define ITK_BENCHMARK_RETURN_ADDRESS() nullptr
+#endif
+
+namespace itk
+{
+namespace
+{
+
+// The state is zero initialized before any dynamic initialization, so that
+// it can be used by the allocations of static constructors.
+constexpr size_t CallSiteTableSize = 4096;
+constexpr size_t CallSiteMaximumProbes = 32;
+
+struct CallSiteEntry
+{
+  std::atomic<const void *>  m_Address;
+  std::atomic<SizeValueType> m_Allocations;
+  std::atomic<SizeValueType> m_Bytes;
+};
+
+std::atomic<unsigned int>  activeTrackings;
+std::atomic<unsigned int>  activeCallSiteTrackings;
+std::atomic<SizeValueType> allocations;
+std::atomic<SizeValueType> deallocations;
+std::atomic<SizeValueType> allocatedBytes;
+std::atomic<SizeValueType> droppedCallSites;
+CallSiteEntry              callSiteTable[CallSiteTableSize];
+
+#if defined(ITK_PERFORMANCE_BENCHMARKING_TRACK_HEAP_ALLOCATIONS)
+void
+RecordCallSite(const void * address, size_t size)
+{
+  // Open addressing with linear probing; an entry keeps its address once set.
+  const auto hash = static_cast<size_t>((reinterpret_cast<uintptr_t>(address) >> 2) * 0x9E3779B97F4A7C15ull);
+  for (size_t ii = 0; ii < CallSiteMaximumProbes; ++ii)
+  {
+    CallSiteEntry & entry = callSiteTable[(hash + ii) % CallSiteTableSize];
+    const void *    current = entry.m_Address.load(std::memory_order_relaxed);
+    if (current == nullptr &&
+        (entry.m_Address.compare_exchange_strong(current, address, std::memory_order_relaxed) || current == address))
+    {
+      current = address;
+    }
+    if (current == address)
+    {
+      entry.m_Allocations.fetch_add(1, std::memory_order_relaxed);
+      entry.m_Bytes.fetch_add(size, std::memory_order_relaxed);
+      return;
+    }
+  }
+  droppedCallSites.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void
+RecordAllocation(size_t size, const void * caller)
+{
+  if (activeTrackings.load(std::memory_order_relaxed) == 0)
+  {
+    return;
+  }
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  if (activeCallSiteTrackings.load(std::memory_order_relaxed) > 0)
+  {
+    RecordCallSite(caller, size);
+  }
+}
+
+inline void
+RecordDeallocation(void * pointer)
+{
+  if (pointer != nullptr && activeTrackings.load(std::memory_order_relaxed) > 0)
+  {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void *
+Allocate(size_t size, const void * caller)
+{
+  RecordAllocation(size, caller);
+  // operator new(0) must return a unique pointer.
+  return std::malloc(size > 0 ? size : 1);
+}
+
+void *
+AllocateAligned(size_t size, size_t alignment, const void * caller)
+{
+  RecordAllocation(size, caller);
+  if (size == 0)
+  {
+    size = 1;
+  }
+#  if defined(_MSC_VER)
+  return _aligned_malloc(size, alignment);
+#  else
+  void * pointer = nullptr;
+  return posix_memalign(&pointer, std::max(alignment, sizeof(void *)), size) == 0 ? pointer : nullptr;
+#  endif
+}
+
+void
+Deallocate(void * pointer)
+{
+  RecordDeallocation(pointer);
+  std::free(pointer);
+}
+
+void
+DeallocateAligned(void * pointer)
+{
+  RecordDeallocation(pointer);
+#  if defined(_MSC_VER)
+  _aligned_free(pointer);
+#  else
+  std::free(pointer);
+#  endif
+}
+
+void *
+AllocateOrThrow(size_t size, const void * caller)
+{
+  // Follow the standard operator new: call the new handler until the
+  // allocation succeeds, or throw when there is none.
+  for (;;)
+  {
+    if (void * pointer = Allocate(size, caller))
+    {
+      return pointer;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void *
+AllocateAlignedOrThrow(size_t size, size_t alignment, const void * caller)
+{
+  for (;;)
+  {
+    if (void * pointer = AllocateAligned(size, alignment, caller))
+    {
+      return pointer;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+#endif
+
+} // namespace
+
+
+bool
+HeapAllocationTracker::IsAvailable()
+{
+#if defined(ITK_PERFORMANCE_BENCHMARKING_TRACK_HEAP_ALLOCATIONS)
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+void
+HeapAllocationTracker::StartTracking(bool recordCallSites)
+{
+  if (recordCallSites)
+  {
+    activeCallSiteTrackings.fetch_add(1, std::memory_order_relaxed);
+  }
+  activeTrackings.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void
+HeapAllocationTracker::StopTracking(bool recordCallSites)
+{
+  activeTrackings.fetch_sub(1, std::memory_order_relaxed);
+  if (recordCallSites)
+  {
+    activeCallSiteTrackings.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+
+HeapAllocationTracker::Counters
+HeapAllocationTracker::GetCounters()
+{
+  Counters counters;
+  counters.m_Allocations = allocations.load(std::memory_order_relaxed);
+  counters.m_Deallocations = deallocations.load(std::memory_order_relaxed);
+  counters.m_AllocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+  return counters;
+}
+
+
+void
+HeapAllocationTracker::GetCallSites(std::vector<CallSite> & callSites)
+{
+  callSites.resize(CallSiteTableSize);
+  for (size_t ii = 0; ii < CallSiteTableSize; ++ii)
+  {
+    callSites[ii].m_Address = callSiteTable[ii].m_Address.load(std::memory_order_relaxed);
+    callSites[ii].m_Allocations = callSiteTable[ii].m_Allocations.load(std::memory_order_relaxed);
+    callSites[ii].m_Bytes = callSiteTable[ii].m_Bytes.load(std::memory_order_relaxed);
+  }
+}
+
+
+SizeValueType
+HeapAllocationTracker::GetNumberOfDroppedCallSites()
+{
+  return droppedCallSites.load(std::memory_order_relaxed);
+}
+
+
+std::string
+HeapAllocationTracker::GetCallSiteName(const void * address)
+{
+  std::ostringstream name;
+#if defined(__linux__) || defined(__APPLE__)
+  // "module(mangled+offset) [address]" on Linux.
+  void *  addresses[] = { const_cast<void *>(address) };
+  char ** symbols = backtrace_symbols(addresses, 1);
+  if (symbols != nullptr)
+  {
+    std::string       symbol(symbols[0]);
+    const std::size_t begin = symbol.find('(');
+    const std::size_t end = symbol.find('+', begin);
+    std::free(symbols);
+    if (begin != std::string::npos && end != std::string::npos && end > begin + 1)
+    {
+      const std::string mangled = symbol.substr(begin + 1, end - begin - 1);
+      int               status = 0;
+      char *            demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+      if (status == 0 && demangled != nullptr)
+      {
+        symbol.replace(begin + 1, end - begin - 1, demangled);
+      }
+      std::free(demangled);
+    }
+    return symbol;
+  }
+#endif
+  name << address;
+  return name.str();
+}
+
+} // end namespace itk
+
+#if defined(ITK_PERFORMANCE_BENCHMARKING_TRACK_HEAP_ALLOCATIONS)
+// Replacements of the global allocation functions, [new.delete].
+
+void *
+operator new(std::size_t size)
+{
+  return itk::AllocateOrThrow(size, ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new[](std::size_t size)
+{
+  return itk::AllocateOrThrow(size, ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  return itk::Allocate(size, ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return itk::Allocate(size, ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new(std::size_t size, std::align_val_t alignment)
+{
+  return itk::AllocateAlignedOrThrow(size, static_cast<std::size_t>(alignment), ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return itk::AllocateAlignedOrThrow(size, static_cast<std::size_t>(alignment), ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return itk::AllocateAligned(size, static_cast<std::size_t>(alignment), ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void *
+operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+  return itk::AllocateAligned(size, static_cast<std::size_t>(alignment), ITK_BENCHMARK_RETURN_ADDRESS());
+}
+
+void
+operator delete(void * pointer) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete[](void * pointer) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete(void * pointer, std::size_t) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete[](void * pointer, std::size_t) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete(void * pointer, const std::nothrow_t &) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete[](void * pointer, const std::nothrow_t &) noexcept
+{
+  itk::Deallocate(pointer);
+}
+
+void
+operator delete(void * pointer, std::align_val_t) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+
+void
+operator delete[](void * pointer, std::align_val_t) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+
+void
+operator delete(void * pointer, std::size_t, std::align_val_t) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+
+void
+operator delete[](void * pointer, std::size_t, std::align_val_t) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+
+void
+operator delete(void * pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+
+void
+operator delete[](void * pointer, std::align_val_t, const std::nothrow_t &) noexcept
+{
+  itk::DeallocateAligned(pointer);
+}
+#endif
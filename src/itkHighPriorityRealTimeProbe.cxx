@@ -16,6 +16,7 @@
  *
  *=========================================================================*/
 #include "itkHighPriorityRealTimeProbe.h"
+#include "itkBenchmarkSystemInformation.h"
 #include <numeric>
 #include <algorithm>
 #include <cmath>
@@ -28,9 +29,9 @@ namespace itk
 
 HighPriorityRealTimeProbe ::HighPriorityRealTimeProbe()
   : LOCAL_ResourceProbe<TimeStampType, TimeStampType>("Time", "s")
-{
-  this->m_HighPriorityRealTimeClock = HighPriorityRealTimeClock::New();
-}
+  , m_HighPriorityRealTimeClock(HighPriorityRealTimeClock::New())
+  , m_ClockSource(BenchmarkClockSource::ClockSourceEnum::RealTimeClock, m_HighPriorityRealTimeClock.GetPointer())
+{}
 
 
 HighPriorityRealTimeProbe ::~HighPriorityRealTimeProbe() = default;
@@ -40,7 +41,42 @@ HighPriorityRealTimeProbe::TimeStampType
 HighPriorityRealTimeProbe ::GetInstantValue() const
 {
   // Get the current time.
-  return m_HighPriorityRealTimeClock->GetTimeInSeconds();
+  return m_ClockSource.GetTimeInSeconds();
+}
+
+
+void
+HighPriorityRealTimeProbe ::SetClockSource(BenchmarkClockSource::ClockSourceEnum clockSource)
+{
+  this->m_ClockSource = BenchmarkClockSource(clockSource, this->m_HighPriorityRealTimeClock.GetPointer());
+}
+
+
+void
+HighPriorityRealTimeProbe ::SetWorkload(SizeValueType voxels, SizeValueType bytes)
+{
+  this->m_WorkloadVoxels = voxels;
+  this->m_WorkloadBytes = bytes;
+}
+
+
+void
+HighPriorityRealTimeProbe ::PrintJSONMetadata(std::ostream & os)
+{
+  this->PrintJSONvar(os, "ClockSource", BenchmarkClockSource::ToString(this->m_ClockSource.GetClockSource()));
+  this->PrintJSONvar(os, "ClockResolution", this->m_ClockSource.GetResolution());
+  if (this->m_WorkloadVoxels == 0 && this->m_WorkloadBytes == 0)
+  {
+    return;
+  }
+  // The throughput of the median, which a preemption does not skew.
+  const double median = this->GetRobustStatistics().GetMedian();
+  this->PrintJSONvar(os, "WorkloadVoxels", this->m_WorkloadVoxels);
+  this->PrintJSONvar(os, "WorkloadBytes", this->m_WorkloadBytes);
+  this->PrintJSONvar(os, "VoxelsPerSecond", median > 0.0 ? this->m_WorkloadVoxels / median : 0.0);
+  this->PrintJSONvar(os, "BytesPerSecond", median > 0.0 ? this->m_WorkloadBytes / median : 0.0);
+  this->PrintJSONvar(
+    os, "CacheRegime", BenchmarkSystemInformation::GetInstance().GetCacheRegime(this->m_WorkloadBytes));
 }
 
 } // end namespace itk
@@ -16,13 +16,259 @@
  *
  *=========================================================================*/
 #include "itkHighPriorityRealTimeProbesCollector.h"
+#include <itksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cctype>
 
 namespace itk
 {
+namespace
+{
+
+/** Returns the upper case value of an environment variable, empty if it is
+ * not set or is set to an off value. */
+std::string
+GetEnabledEnvironmentValue(const char * name)
+{
+  const char * environmentValue = itksys::SystemTools::GetEnv(name);
+  if (environmentValue == nullptr)
+  {
+    return std::string();
+  }
+  std::string value(environmentValue);
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+    return static_cast<char>(std::toupper(c));
+  });
+  if (value == "0" || value == "OFF" || value == "FALSE" || value == "NO")
+  {
+    value.clear();
+  }
+  return value;
+}
 
-HighPriorityRealTimeProbesCollector ::HighPriorityRealTimeProbesCollector() = default;
+/** Start the probe of a companion collector that has the name of a time
+ * probe, creating it on first use. */
+template <typename TCollector, typename THandle>
+void
+StartCompanionProbe(TCollector &          companion,
+                    std::vector<THandle> & companionHandles,
+                    THandle                handle,
+                    size_t                 numberOfProbes,
+                    const std::string &    name)
+{
+  constexpr THandle noHandle = TCollector::NoParentHandle;
+  if (handle >= companionHandles.size())
+  {
+    companionHandles.resize(numberOfProbes, noHandle);
+  }
+  if (companionHandles[handle] == noHandle)
+  {
+    companionHandles[handle] = companion.GetProbeHandle(name.c_str());
+  }
+  companion.Start(companionHandles[handle]);
+}
+
+template <typename TCollector, typename THandle>
+void
+StopCompanionProbe(TCollector & companion, const std::vector<THandle> & companionHandles, THandle handle)
+{
+  if (handle < companionHandles.size() && companionHandles[handle] != TCollector::NoParentHandle)
+  {
+    companion.Stop(companionHandles[handle]);
+  }
+}
+
+/** Print the "key": [ ... ] array of the probes of a companion collector,
+ * in the order of the time probes. */
+template <typename TCollector, typename THandle, typename TProbes>
+void
+PrintJSONCompanionProbes(std::ostream &               os,
+                         const char *                 key,
+                         TCollector &                 companion,
+                         const std::vector<THandle> & companionHandles,
+                         const TProbes &              probes)
+{
+  if (companionHandles.empty())
+  {
+    return;
+  }
+  os << "  \"" << key << "\": [\n";
+  bool firstProbe = true;
+  for (size_t handle = 0; handle < companionHandles.size(); ++handle)
+  {
+    if (companionHandles[handle] == TCollector::NoParentHandle)
+    {
+      continue;
+    }
+    if (!firstProbe)
+    {
+      os << ",\n";
+    }
+    firstProbe = false;
+    companion.JSONReport(probes[handle].GetNameOfProbe().c_str(), os);
+  }
+  os << "\n  ],\n";
+}
+
+} // namespace
+
+
+HighPriorityRealTimeProbesCollector ::HighPriorityRealTimeProbesCollector()
+{
+  this->m_MemoryProbesEnabled = !GetEnabledEnvironmentValue("ITKPERFORMANCEBENCHMARK_MEMORY_PROBE").empty();
+  const std::string allocationProbe = GetEnabledEnvironmentValue("ITKPERFORMANCEBENCHMARK_ALLOCATION_PROBE");
+  this->m_AllocationProbesEnabled = !allocationProbe.empty();
+  this->m_AllocationProbes.SetRecordCallSites(allocationProbe == "CALLSITES");
+}
 
 
 HighPriorityRealTimeProbesCollector ::~HighPriorityRealTimeProbesCollector() = default;
 
+
+void
+HighPriorityRealTimeProbesCollector ::SetClockSource(BenchmarkClockSource::ClockSourceEnum clockSource)
+{
+  this->m_ClockSource = clockSource;
+  for (auto & probe : this->m_Probes)
+  {
+    probe.SetClockSource(clockSource);
+  }
+  // The overhead depends on the clock read.
+  this->CalibrateOverhead();
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::SetMemoryProbesEnabled(bool enabled)
+{
+  this->m_MemoryProbesEnabled = enabled;
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::SetAllocationProbesEnabled(bool enabled)
+{
+  this->m_AllocationProbesEnabled = enabled;
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::SetRecordAllocationCallSites(bool recordCallSites)
+{
+  this->m_AllocationProbes.SetRecordCallSites(recordCallSites);
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::Start(ProbeHandleType handle)
+{
+  // Reading the memory is slow, and allocates, keep it out of the other
+  // measurements.
+  if (this->m_MemoryProbesEnabled)
+  {
+    StartCompanionProbe(this->m_MemoryProbes,
+                        this->m_MemoryProbeHandles,
+                        handle,
+                        this->m_Probes.size(),
+                        this->m_Probes[handle].GetNameOfProbe());
+  }
+  if (this->m_AllocationProbesEnabled)
+  {
+    StartCompanionProbe(this->m_AllocationProbes,
+                        this->m_AllocationProbeHandles,
+                        handle,
+                        this->m_Probes.size(),
+                        this->m_Probes[handle].GetNameOfProbe());
+  }
+  Superclass::Start(handle);
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::Stop(ProbeHandleType handle)
+{
+  Superclass::Stop(handle);
+  StopCompanionProbe(this->m_AllocationProbes, this->m_AllocationProbeHandles, handle);
+  StopCompanionProbe(this->m_MemoryProbes, this->m_MemoryProbeHandles, handle);
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::Report(std::ostream & os,
+                                             bool           printSystemInfo,
+                                             bool           printReportHead,
+                                             bool           useTabs)
+{
+  Superclass::Report(os, printSystemInfo, printReportHead, useTabs);
+  if (!this->m_MemoryProbeHandles.empty())
+  {
+    os << std::endl;
+    this->m_MemoryProbes.Report(os, false, printReportHead, useTabs);
+  }
+  if (!this->m_AllocationProbeHandles.empty())
+  {
+    os << std::endl;
+    this->m_AllocationProbes.Report(os, false, printReportHead, useTabs);
+  }
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::ExpandedReport(std::ostream & os,
+                                                     bool           printSystemInfo,
+                                                     bool           printReportHead,
+                                                     bool           useTabs)
+{
+  Superclass::ExpandedReport(os, printSystemInfo, printReportHead, useTabs);
+  if (!this->m_MemoryProbeHandles.empty())
+  {
+    os << std::endl;
+    this->m_MemoryProbes.ExpandedReport(os, false, printReportHead, useTabs);
+  }
+  if (!this->m_AllocationProbeHandles.empty())
+  {
+    os << std::endl;
+    this->m_AllocationProbes.ExpandedReport(os, false, printReportHead, useTabs);
+  }
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::SetWorkload(const char * id, SizeValueType voxels, SizeValueType bytes)
+{
+  this->m_Probes[this->GetProbeHandle(id)].SetWorkload(voxels, bytes);
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::Clear()
+{
+  Superclass::Clear();
+  this->m_MemoryProbes.Clear();
+  this->m_MemoryProbeHandles.clear();
+  this->m_AllocationProbes.Clear();
+  this->m_AllocationProbeHandles.clear();
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::PrintJSONCollectorInformation(std::ostream & os)
+{
+  Superclass::PrintJSONCollectorInformation(os);
+  os << "  \"ExecutionContext\": ";
+  BenchmarkExecutionContext::PrintJSON(os);
+  os << ",\n";
+  PrintJSONCompanionProbes(os, "MemoryProbes", this->m_MemoryProbes, this->m_MemoryProbeHandles, this->m_Probes);
+  PrintJSONCompanionProbes(
+    os, "AllocationProbes", this->m_AllocationProbes, this->m_AllocationProbeHandles, this->m_Probes);
+}
+
+
+void
+HighPriorityRealTimeProbesCollector ::InitializeProbe(HighPriorityRealTimeProbe & probe)
+{
+  probe.SetClockSource(this->m_ClockSource);
+}
+
 } // end namespace itk
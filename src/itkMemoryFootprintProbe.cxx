@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMemoryFootprintProbe.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#  include <sys/resource.h>
+#  include <unistd.h>
+#endif
+
+namespace itk
+{
+
+MemoryFootprintProbe ::MemoryFootprintProbe()
+  : LOCAL_ResourceProbe<MemoryLoadType, MemoryLoadType>("ResidentSetSize", "kB")
+{}
+
+
+MemoryFootprintProbe ::~MemoryFootprintProbe() = default;
+
+
+MemoryFootprintProbe::MemoryLoadType
+MemoryFootprintProbe ::GetInstantValue() const
+{
+#if defined(__linux__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    this->m_InstantMinorPageFaults = static_cast<SizeValueType>(usage.ru_minflt);
+    this->m_InstantMajorPageFaults = static_cast<SizeValueType>(usage.ru_majflt);
+  }
+
+  // The second field is the number of resident pages.
+  std::ifstream statm("/proc/self/statm");
+  SizeValueType size = 0;
+  SizeValueType resident = 0;
+  if (statm >> size >> resident)
+  {
+    static const auto pageSize = static_cast<MemoryLoadType>(sysconf(_SC_PAGESIZE));
+    this->m_InstantResidentSetSize = static_cast<MemoryLoadType>(resident) * pageSize / 1024.0;
+    return this->m_InstantResidentSetSize;
+  }
+#endif
+  this->m_InstantResidentSetSize = static_cast<MemoryLoadType>(this->m_MemoryObserver.GetMemoryUsage());
+  return this->m_InstantResidentSetSize;
+}
+
+
+void
+MemoryFootprintProbe ::Start()
+{
+#if defined(__linux__)
+  // Writing 5 resets the high-water mark of the RSS, since Linux 4.0.
+  {
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << '5' << std::flush;
+    this->m_PeakResetAvailable = clearRefs.good();
+  }
+#endif
+
+  LOCAL_ResourceProbe<MemoryLoadType, MemoryLoadType>::Start();
+  this->m_StartResidentSetSize = this->m_InstantResidentSetSize;
+  this->m_StartMinorPageFaults = this->m_InstantMinorPageFaults;
+  this->m_StartMajorPageFaults = this->m_InstantMajorPageFaults;
+}
+
+
+void
+MemoryFootprintProbe ::Stop()
+{
+  const CountType numberOfStops = this->GetNumberOfStops();
+  LOCAL_ResourceProbe<MemoryLoadType, MemoryLoadType>::Stop();
+  if (this->GetNumberOfStops() == numberOfStops)
+  {
+    return;
+  }
+
+#if defined(__linux__)
+  const MemoryLoadType peak = this->ReadPeak();
+  this->m_PeakValues.push_back(peak);
+  this->m_PeakIncrease = std::max(this->m_PeakIncrease, peak - this->m_StartResidentSetSize);
+  this->m_MinorPageFaultValues.push_back(this->m_InstantMinorPageFaults - this->m_StartMinorPageFaults);
+  this->m_MajorPageFaultValues.push_back(this->m_InstantMajorPageFaults - this->m_StartMajorPageFaults);
+#endif
+}
+
+
+void
+MemoryFootprintProbe ::Reset()
+{
+  LOCAL_ResourceProbe<MemoryLoadType, MemoryLoadType>::Reset();
+  this->m_PeakValues.clear();
+  this->m_PeakIncrease = 0.0;
+  this->m_MinorPageFaultValues.clear();
+  this->m_MajorPageFaultValues.clear();
+}
+
+
+MemoryFootprintProbe::MemoryLoadType
+MemoryFootprintProbe ::GetPeak() const
+{
+  if (this->m_PeakValues.empty())
+  {
+    return 0.0;
+  }
+  return *std::max_element(this->m_PeakValues.begin(), this->m_PeakValues.end());
+}
+
+
+MemoryFootprintProbe::MemoryLoadType
+MemoryFootprintProbe ::ReadPeak() const
+{
+  std::ifstream status("/proc/self/status");
+  std::string   line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, 6, "VmHWM:") == 0)
+    {
+      std::istringstream value(line.substr(6));
+      MemoryLoadType     peak = 0.0;
+      value >> peak;
+      return peak;
+    }
+  }
+  return 0.0;
+}
+
+
+void
+MemoryFootprintProbe ::PrintJSONMetadata(std::ostream & os)
+{
+  const auto printValues = [&os](const char * name, const auto & values) {
+    os << "    \"" << name << "\": [";
+    for (size_t ii = 0; ii < values.size(); ++ii)
+    {
+      os << (ii > 0 ? ", " : "") << values[ii];
+    }
+    os << "],\n";
+  };
+
+  os << "    \"PeakResetAvailable\": " << (this->m_PeakResetAvailable ? "true" : "false") << ",\n";
+  this->PrintJSONvar(os, "PeakResidentSetSize", this->GetPeak());
+  this->PrintJSONvar(os, "PeakResidentSetSizeIncrease", this->m_PeakIncrease);
+  printValues("PeakResidentSetSizeValues", this->m_PeakValues);
+  SizeValueType minorPageFaults = 0;
+  for (const auto faults : this->m_MinorPageFaultValues)
+  {
+    minorPageFaults += faults;
+  }
+  SizeValueType majorPageFaults = 0;
+  for (const auto faults : this->m_MajorPageFaultValues)
+  {
+    majorPageFaults += faults;
+  }
+  this->PrintJSONvar(os, "MinorPageFaults", minorPageFaults);
+  this->PrintJSONvar(os, "MajorPageFaults", majorPageFaults);
+  printValues("MinorPageFaultsValues", this->m_MinorPageFaultValues);
+  printValues("MajorPageFaultsValues", this->m_MajorPageFaultValues);
+}
+
+} // end namespace itk
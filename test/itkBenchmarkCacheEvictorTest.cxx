@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "itkBenchmarkCacheEvictor.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include <itksys/SystemTools.hxx>
+
+int
+itkBenchmarkCacheEvictorTest(int, char *[])
+{
+  itk::BenchmarkCacheEvictor evictor(1 << 20);
+  if (evictor.GetBufferSize() != (1 << 20) || itk::BenchmarkCacheEvictor().GetBufferSize() < (32 << 20))
+  {
+    std::cerr << "Unexpected buffer size " << evictor.GetBufferSize() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Flush available: " << itk::BenchmarkCacheEvictor::IsFlushAvailable() << std::endl;
+  std::cout << "Page out available: " << itk::BenchmarkCacheEvictor::IsPageOutAvailable() << std::endl;
+
+  // Evicting a range from the caches, or its pages from memory, keeps its content.
+  std::vector<int> input(100000);
+  std::iota(input.begin(), input.end(), 0);
+  evictor.Evict({ { input.data(), input.size() * sizeof(int) }, { nullptr, 0 } });
+  evictor.SetPageOut(true);
+  evictor.Evict({ { input.data(), input.size() * sizeof(int) } });
+  for (size_t ii = 0; ii < input.size(); ++ii)
+  {
+    if (input[ii] != static_cast<int>(ii))
+    {
+      std::cerr << "Evict() changed the input at " << ii << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Both modes run in turn, under their own probe.
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_CACHE_MODE=Both");
+  itk::HighPriorityRealTimeProbesCollector collector;
+  int                                      prepared = 0;
+  int                                      runs = 0;
+  double                                   sum = 0.0;
+  TimeIterations(
+    collector,
+    "Sum",
+    3,
+    [&]() { ++prepared; },
+    [&]() {
+      ++runs;
+      sum += std::accumulate(input.begin(), input.end(), 0.0);
+    },
+    { { input.data(), input.size() * sizeof(int) } });
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_CACHE_MODE=Cold");
+  itk::HighPriorityRealTimeProbesCollector coldCollector;
+  TimeIterations(coldCollector, "Sum", 2, []() {}, [&]() { ++runs; });
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_CACHE_MODE");
+  if (prepared != 6 || runs != 8 || collector.GetProbe("Sum").GetNumberOfStarts() != 3 ||
+      collector.GetProbe("Sum (cold)").GetNumberOfStarts() != 3 ||
+      coldCollector.GetProbe("Sum (cold)").GetNumberOfStarts() != 2)
+  {
+    std::cerr << "Unexpected iterations: " << prepared << " prepared, " << runs << " runs" << std::endl;
+    return EXIT_FAILURE;
+  }
+  collector.Report(std::cout);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
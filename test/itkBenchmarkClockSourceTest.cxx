@@ -0,0 +1,115 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+#include "itkBenchmarkClockSource.h"
+#include "itkHighPriorityRealTimeProbesCollector.h"
+
+int
+itkBenchmarkClockSourceTest(int, char *[])
+{
+  using ClockSourceEnum = itk::BenchmarkClockSource::ClockSourceEnum;
+
+  itk::RealTimeClock::Pointer realTimeClock = itk::RealTimeClock::New();
+
+  std::cout << "Invariant TSC frequency: " << itk::BenchmarkClockSource::GetInvariantTSCFrequency() << " Hz"
+            << std::endl;
+
+  for (const auto requested : { ClockSourceEnum::RealTimeClock,
+                                ClockSourceEnum::Monotonic,
+                                ClockSourceEnum::MonotonicRaw,
+                                ClockSourceEnum::InvariantTSC })
+  {
+    const itk::BenchmarkClockSource clockSource(requested, realTimeClock.GetPointer());
+    std::cout << requested << " reads " << clockSource.GetClockSource() << " with a resolution of "
+              << clockSource.GetResolution() << " s" << std::endl;
+
+    if (itk::BenchmarkClockSource::IsAvailable(requested) != (clockSource.GetClockSource() == requested) ||
+        clockSource.GetRequestedClockSource() != requested)
+    {
+      std::cerr << "Unexpected fallback from " << requested << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (!(clockSource.GetResolution() > 0.0))
+    {
+      std::cerr << "Invalid resolution of " << clockSource.GetClockSource() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The monotonic clocks never go back.
+    if (clockSource.GetClockSource() != ClockSourceEnum::RealTimeClock)
+    {
+      itk::BenchmarkClockSource::TimeStampType previous = clockSource.GetTimeInSeconds();
+      for (unsigned int ii = 0; ii < 100000; ++ii)
+      {
+        const itk::BenchmarkClockSource::TimeStampType now = clockSource.GetTimeInSeconds();
+        if (now < previous)
+        {
+          std::cerr << clockSource.GetClockSource() << " is not monotonic" << std::endl;
+          return EXIT_FAILURE;
+        }
+        previous = now;
+      }
+    }
+
+    ClockSourceEnum parsed;
+    if (!itk::BenchmarkClockSource::FromString(itk::BenchmarkClockSource::ToString(requested), parsed) ||
+        parsed != requested)
+    {
+      std::cerr << "FromString() does not parse " << requested << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  ClockSourceEnum parsed;
+  if (!itk::BenchmarkClockSource::FromString("tsc", parsed) || parsed != ClockSourceEnum::InvariantTSC ||
+      itk::BenchmarkClockSource::FromString("sundial", parsed))
+  {
+    std::cerr << "FromString() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The clock source of a collector applies to its existing and new probes.
+  itk::HighPriorityRealTimeProbesCollector collector;
+  collector.Start("Before");
+  collector.Stop("Before");
+  collector.SetClockSource(ClockSourceEnum::Monotonic);
+  collector.Start("After");
+  collector.Stop("After");
+  if (collector.GetClockSource() != ClockSourceEnum::Monotonic ||
+      collector.GetProbe("Before").GetClockSource() != ClockSourceEnum::Monotonic ||
+      collector.GetProbe("After").GetClockSource() != ClockSourceEnum::Monotonic)
+  {
+    std::cerr << "The collector clock source is not applied to its probes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream report;
+  collector.JSONReport(report);
+  std::cout << report.str();
+  if (report.str().find("\"ClockSource\": \"Monotonic\"") == std::string::npos ||
+      report.str().find("\"ClockResolution\"") == std::string::npos)
+  {
+    std::cerr << "The clock source is missing from the JSON report" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+#include "itkBenchmarkExecutionContext.h"
+#include "itkHighPriorityRealTimeProbesCollector.h"
+
+#if defined(__linux__)
+#  include <future>
+#  include <sched.h>
+#  include <thread>
+#endif
+
+int
+itkBenchmarkExecutionContextTest(int, char *[])
+{
+  using ContextType = itk::BenchmarkExecutionContext;
+
+  for (const auto policy : { ContextType::SchedulingPolicyEnum::None,
+                             ContextType::SchedulingPolicyEnum::Nice,
+                             ContextType::SchedulingPolicyEnum::FIFO,
+                             ContextType::SchedulingPolicyEnum::RoundRobin })
+  {
+    ContextType::SchedulingPolicyEnum parsed;
+    if (!ContextType::FromString(ContextType::ToString(policy), parsed) || parsed != policy)
+    {
+      std::cerr << "Policy " << policy << " is not parsed back" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  ContextType::SchedulingPolicyEnum parsed;
+  if (!ContextType::FromString("rr", parsed) || parsed != ContextType::SchedulingPolicyEnum::RoundRobin ||
+      ContextType::FromString("batch", parsed))
+  {
+    std::cerr << "Unexpected policy names" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ContextType::Settings settings;
+  settings.m_SchedulingPolicy = ContextType::SchedulingPolicyEnum::FIFO;
+  settings.m_DisableTransparentHugePages = true;
+#if defined(__linux__)
+  cpu_set_t originalAffinity;
+  CPU_ZERO(&originalAffinity);
+  sched_getaffinity(0, sizeof(cpu_set_t), &originalAffinity);
+  for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &originalAffinity))
+    {
+      settings.m_CPUAffinity.push_back(cpu);
+      break;
+    }
+  }
+#endif
+  ContextType::SetSettings(settings);
+
+  if (ContextType::IsActive())
+  {
+    std::cerr << "The context is active before it is acquired" << std::endl;
+    return EXIT_FAILURE;
+  }
+  {
+    // A collector holds the context before its first probe is created.
+    const itk::HighPriorityRealTimeProbesCollector collector;
+    if (!ContextType::IsActive())
+    {
+      std::cerr << "The collector does not hold the context" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  {
+    const ContextType::Guard outer;
+    {
+      // The clocks of the probes hold the context too.
+      itk::HighPriorityRealTimeProbesCollector collector;
+      collector.Start("Nested");
+      collector.Stop("Nested");
+      std::ostringstream json;
+      collector.JSONReport(json, false);
+      std::cout << json.str();
+      if (json.str().find("\"ExecutionContext\"") == std::string::npos)
+      {
+        std::cerr << "The execution context is not reported" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (!ContextType::IsActive())
+    {
+      std::cerr << "Releasing a nested context deactivated it" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const ContextType::AppliedSettings applied = ContextType::GetAppliedSettings();
+    std::cout << "Applied scheduling policy: " << applied.m_SchedulingPolicy << ", priority " << applied.m_Priority
+              << std::endl;
+    for (const auto & message : applied.m_Messages)
+    {
+      std::cout << "  " << message << std::endl;
+    }
+    // Whatever was not applied must be explained.
+    if (applied.m_SchedulingPolicy != settings.m_SchedulingPolicy && applied.m_Messages.empty())
+    {
+      std::cerr << "The scheduling policy fell back silently" << std::endl;
+      return EXIT_FAILURE;
+    }
+#if defined(__linux__)
+    cpu_set_t affinity;
+    sched_getaffinity(0, sizeof(cpu_set_t), &affinity);
+    if (!applied.m_CPUAffinity.empty() &&
+        (CPU_COUNT(&affinity) != 1 || !CPU_ISSET(settings.m_CPUAffinity[0], &affinity)))
+    {
+      std::cerr << "The CPU affinity is not applied" << std::endl;
+      return EXIT_FAILURE;
+    }
+#endif
+  }
+  if (ContextType::IsActive())
+  {
+    std::cerr << "The context is still active after it is released" << std::endl;
+    return EXIT_FAILURE;
+  }
+#if defined(__linux__)
+  cpu_set_t restoredAffinity;
+  sched_getaffinity(0, sizeof(cpu_set_t), &restoredAffinity);
+  if (!CPU_EQUAL(&restoredAffinity, &originalAffinity))
+  {
+    std::cerr << "The CPU affinity is not restored" << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
+
+  // Placing the threads lets the calling thread run on all the CPUs of the
+  // policy, and pins each other thread to one of them, including the threads
+  // created after the context was acquired once it is applied again.
+  settings = ContextType::Settings();
+  settings.m_SchedulingPolicy = ContextType::SchedulingPolicyEnum::None;
+  settings.m_ThreadPlacement = ContextType::ThreadPlacementEnum::Compact;
+  ContextType::SetSettings(settings);
+  {
+    const ContextType::Guard guard;
+#if defined(__linux__)
+    std::promise<void>      placed;
+    std::promise<cpu_set_t> placedAffinity;
+    std::thread             worker([&placed, &placedAffinity]() {
+      placed.get_future().wait();
+      cpu_set_t workerAffinity;
+      sched_getaffinity(0, sizeof(cpu_set_t), &workerAffinity);
+      placedAffinity.set_value(workerAffinity);
+    });
+    ContextType::Reapply();
+    placed.set_value();
+    const cpu_set_t workerAffinity = placedAffinity.get_future().get();
+    worker.join();
+#endif
+    const ContextType::AppliedSettings applied = ContextType::GetAppliedSettings();
+    std::cout << "Thread placement: " << applied.m_ThreadPlacement << ", " << applied.m_ThreadCPUs.size()
+              << " threads placed" << std::endl;
+#if defined(__linux__)
+    cpu_set_t affinity;
+    sched_getaffinity(0, sizeof(cpu_set_t), &affinity);
+    bool placedOnAffinity = !applied.m_ThreadCPUs.empty();
+    for (const unsigned int cpu : applied.m_ThreadCPUs)
+    {
+      placedOnAffinity = placedOnAffinity && CPU_ISSET(cpu, &affinity);
+    }
+    cpu_set_t workerOnAffinity;
+    CPU_AND(&workerOnAffinity, &workerAffinity, &affinity);
+    if (!placedOnAffinity || CPU_COUNT(&workerAffinity) != 1 || !CPU_EQUAL(&workerOnAffinity, &workerAffinity))
+    {
+      std::cerr << "The threads are not placed" << std::endl;
+      return EXIT_FAILURE;
+    }
+#endif
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
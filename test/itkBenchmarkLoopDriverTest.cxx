@@ -0,0 +1,147 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+#include "itkBenchmarkLoopDriver.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include <itksys/SystemTools.hxx>
+
+namespace
+{
+itk::BenchmarkLoopDriver::StoppingReasonEnum
+RunLoop(itk::BenchmarkLoopDriver & driver, double firstSample, double secondSample)
+{
+  while (driver.Continue())
+  {
+    driver.AddSample(driver.GetIterations() % 2 == 0 ? firstSample : secondSample);
+  }
+  return driver.GetStoppingReason();
+}
+} // namespace
+
+int
+itkBenchmarkLoopDriverTest(int, char *[])
+{
+  using StoppingReasonEnum = itk::BenchmarkLoopDriver::StoppingReasonEnum;
+
+  // Without a target or a budget, the maximum number of iterations runs.
+  itk::BenchmarkLoopDriver fixed(3, 3);
+  if (RunLoop(fixed, 1.0, 2.0) != StoppingReasonEnum::MaximumIterations || fixed.GetIterations() != 3)
+  {
+    std::cerr << "Unexpected fixed loop: " << fixed.GetIterations() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The bounds are at least one iteration.
+  itk::BenchmarkLoopDriver empty(0, 0);
+  if (RunLoop(empty, 1.0, 1.0) != StoppingReasonEnum::MaximumIterations || empty.GetIterations() != 1)
+  {
+    std::cerr << "Unexpected empty loop: " << empty.GetIterations() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The half-width of a single sample is unknown.
+  std::ostringstream emptyJSON;
+  empty.PrintJSON(emptyJSON);
+  jsonxx::Object emptyObject;
+  if (!emptyObject.parse(emptyJSON.str()) || !emptyObject.has<jsonxx::Null>("RelativeHalfWidth"))
+  {
+    std::cerr << "Unexpected empty loop JSON: " << emptyJSON.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Identical timings reach any target as soon as the minimum ran.
+  itk::BenchmarkLoopDriver stable(5, 1000, 0.0, 0.01);
+  if (RunLoop(stable, 1.0, 1.0) != StoppingReasonEnum::ConfidenceTarget || stable.GetIterations() != 5)
+  {
+    std::cerr << "Unexpected stable loop: " << stable.GetIterations() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Timings alternating between 1 and 2 have a relative half-width of about
+  // 2 * 0.5 / sqrt(n) / 1.5, below 5% after about 180 iterations.
+  itk::BenchmarkLoopDriver noisy(2, 1000, 0.0, 0.05);
+  if (RunLoop(noisy, 1.0, 2.0) != StoppingReasonEnum::ConfidenceTarget || noisy.GetIterations() < 150 ||
+      noisy.GetIterations() > 200 || noisy.GetRelativeHalfWidth() > 0.05)
+  {
+    std::cerr << "Unexpected noisy loop: " << noisy.GetIterations() << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::BenchmarkLoopDriver capped(2, 20, 0.0, 0.05);
+  if (RunLoop(capped, 1.0, 2.0) != StoppingReasonEnum::MaximumIterations || capped.GetIterations() != 20)
+  {
+    std::cerr << "Unexpected capped loop: " << capped.GetIterations() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Iterations of about 5 ms do not fit many times in a budget of 50 ms.
+  itk::BenchmarkLoopDriver budgeted(1, 1000, 0.05);
+  while (budgeted.Continue())
+  {
+    itksys::SystemTools::Delay(5);
+    budgeted.AddSample(0.005);
+  }
+  if (budgeted.GetStoppingReason() != StoppingReasonEnum::TimeBudget || budgeted.GetIterations() > 10 ||
+      budgeted.GetElapsedTime() > 0.1)
+  {
+    std::cerr << "Unexpected budgeted loop: " << budgeted.GetIterations() << " iterations in "
+              << budgeted.GetElapsedTime() << " s" << std::endl;
+    return EXIT_FAILURE;
+  }
+  budgeted.PrintJSON(std::cout);
+  std::cout << std::endl;
+
+  // Iterations of about 5 ms run until the minimum time of 30 ms elapsed,
+  // and then stop without a target.
+  itk::BenchmarkLoopDriver timed(1, 1000, 0.0, 0.0, 0.03);
+  while (timed.Continue())
+  {
+    itksys::SystemTools::Delay(5);
+    timed.AddSample(0.005);
+  }
+  if (timed.GetStoppingReason() != StoppingReasonEnum::MinimumTime || timed.GetIterations() > 10 ||
+      timed.GetElapsedTime() < 0.03)
+  {
+    std::cerr << "Unexpected timed loop: " << timed.GetIterations() << " iterations in " << timed.GetElapsedTime()
+              << " s" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The benchmark loops are configured by the environment, and reported.
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS=4");
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS=6");
+  itk::HighPriorityRealTimeProbesCollector collector;
+  int                                      runs = 0;
+  TimeIterations(collector, "Loop", 2, []() {}, [&runs]() { ++runs; });
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS");
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS");
+  jsonxx::Object decorated;
+  decorated.parse(DecorateWithBuildInformation("{}"));
+  if (runs != 6 || !decorated.has<jsonxx::Object>("IterationControl") ||
+      !decorated.get<jsonxx::Object>("IterationControl").has<jsonxx::Object>("Loop") ||
+      decorated.get<jsonxx::Object>("IterationControl").get<jsonxx::Object>("Loop").get<jsonxx::String>(
+        "StoppingReason") != "MaximumIterations")
+  {
+    std::cerr << "The iteration control is not applied or not reported: " << runs << " runs" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
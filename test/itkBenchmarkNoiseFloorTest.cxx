@@ -0,0 +1,83 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "itkBenchmarkNoiseFloor.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include <itksys/SystemTools.hxx>
+
+int
+itkBenchmarkNoiseFloorTest(int, char *[])
+{
+  const itk::BenchmarkNoiseFloor noiseFloor = itk::BenchmarkNoiseFloor::Measure(0.05);
+
+  std::ostringstream json;
+  noiseFloor.PrintJSON(json, 0.02);
+  std::cout << json.str() << std::endl;
+  jsonxx::Object noiseFloorObject;
+  if (!noiseFloorObject.parse(json.str()) || !noiseFloorObject.has<jsonxx::Number>("NoiseFloor") ||
+      !noiseFloorObject.has<jsonxx::Boolean>("Quiet") || !noiseFloorObject.has<jsonxx::Array>("Issues"))
+  {
+    std::cerr << "Invalid JSON" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double largestNoise =
+    std::max({ noiseFloor.GetTimerJitter(), noiseFloor.GetInterruptedFraction(), noiseFloor.GetCPUFrequencySpread() });
+  if (noiseFloor.GetNoiseFloor() < 0.0 || noiseFloor.GetInterruptedFraction() > 1.0 ||
+      noiseFloor.GetNoiseFloor() != largestNoise)
+  {
+    std::cerr << "Unexpected noise floor " << noiseFloor.GetNoiseFloor() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // No machine is quiet enough for a negative noise floor.
+  if (noiseFloor.GetIssues(-1.0).empty())
+  {
+    std::cerr << "A negative maximum noise floor is not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_NOISE_THRESHOLD=-1");
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_PREFLIGHT=Refuse");
+  const bool refused = !RunBenchmarkPreflight();
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_PREFLIGHT=Off");
+  const bool skipped = RunBenchmarkPreflight();
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_PREFLIGHT");
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_NOISE_THRESHOLD");
+  if (!refused || !skipped)
+  {
+    std::cerr << "The pre-flight modes are not applied" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The last measurement is added to the reports.
+  jsonxx::Object decorated;
+  decorated.parse(DecorateWithBuildInformation("{}"));
+  if (!decorated.has<jsonxx::Object>("NoiseFloor") ||
+      decorated.get<jsonxx::Object>("NoiseFloor").get<jsonxx::String>("PreflightMode") != "Refuse")
+  {
+    std::cerr << "The noise floor is not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
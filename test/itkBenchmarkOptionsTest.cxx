@@ -0,0 +1,180 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "PerformanceBenchmarkingUtilities.h"
+#include "itkBenchmarkExecutionContext.h"
+#include <itksys/SystemTools.hxx>
+
+namespace
+{
+// Parses a command line given as strings.
+bool
+Parse(std::vector<std::string> arguments, const std::vector<std::string> & positionalNames, BenchmarkOptions & options)
+{
+  std::vector<char *> argv;
+  for (auto & argument : arguments)
+  {
+    argv.push_back(&argument[0]);
+  }
+  argv.push_back(nullptr);
+  return ParseBenchmarkOptions(static_cast<int>(arguments.size()), argv.data(), positionalNames, options);
+}
+} // namespace
+
+int
+itkBenchmarkOptionsTest(int, char *[])
+{
+  const std::vector<std::string> names{ "timingsFile", "iterations", "threads", "inputImageFile", "outputImageFile" };
+
+  // The legacy positional form.
+  BenchmarkOptions legacy;
+  if (!Parse({ "Benchmark", "__DATESTAMP__Benchmark.json", "7", "-1", "in.mha", "out.mha" }, names, legacy) ||
+      legacy.m_Iterations != 7 || legacy.m_Threads != -1 || legacy.m_Arguments["inputImageFile"] != "in.mha" ||
+      legacy.m_Arguments["outputImageFile"] != "out.mha" ||
+      legacy.m_TimingsFileName.find("__DATESTAMP__") != std::string::npos ||
+      legacy.m_TimingsFileName.find("Benchmark.json") == std::string::npos)
+  {
+    std::cerr << "The legacy positional form is not parsed: " << legacy.m_TimingsFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The slots given as options are skipped.
+  BenchmarkOptions options;
+  if (!Parse({ "Benchmark",
+               "--iterations",
+               "5",
+               "--threads",
+               "2",
+               "--min-time",
+               "0.5",
+               "--warmup",
+               "3",
+               "--clock",
+               "Monotonic",
+               "--format",
+               "text",
+               "--size",
+               "64x32",
+               "Benchmark.json",
+               "in.mha",
+               "out.mha" },
+             names,
+             options) ||
+      options.m_Iterations != 5 || options.m_Threads != 2 || options.m_MinimumTime != 0.5 ||
+      options.m_WarmUpIterations != 3 || options.m_ClockSource != BenchmarkOptions::ClockSourceEnum::Monotonic ||
+      options.m_Format != BenchmarkOptions::FormatEnum::Text || options.m_Size != std::vector<unsigned int>{ 64, 32 } ||
+      options.m_TimingsFileName != "Benchmark.json" || options.m_Arguments["outputImageFile"] != "out.mha")
+  {
+    std::cerr << "The options are not parsed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // They apply to the benchmark loops.
+  if (GetBenchmarkOptions().m_MinimumTime != 0.5 || CreateBenchmarkLoopDriver(1).GetMinimumTime() != 0.5)
+  {
+    std::cerr << "The minimum time is not applied" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The optional slots keep their defaults.
+  BenchmarkOptions optional;
+  optional.m_Iterations = 500;
+  if (!Parse({ "Benchmark", "Benchmark.json" }, { "timingsFile", "[iterations]", "[threads]" }, optional) ||
+      optional.m_Iterations != 500 || optional.m_Threads != -1)
+  {
+    std::cerr << "The optional slots are not parsed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The remaining arguments are kept.
+  BenchmarkOptions remaining;
+  if (!Parse({ "Benchmark", "--threads", "4", "-tf", "Benchmark.json" }, { "..." }, remaining) ||
+      remaining.m_Threads != 4 || remaining.m_RemainingArguments != std::vector<std::string>{ "-tf", "Benchmark.json" })
+  {
+    std::cerr << "The remaining arguments are not kept" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Invalid command lines.
+  const std::vector<std::vector<std::string>> invalidArguments{
+    { "Benchmark", "Benchmark.json", "7", "-1", "in.mha" },
+    { "Benchmark", "Benchmark.json", "7", "-1", "in.mha", "out.mha", "extra" },
+    { "Benchmark", "Benchmark.json", "0", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "Benchmark.json", "seven", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "--clock", "Sundial", "Benchmark.json", "7", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "--format", "XML", "Benchmark.json", "7", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "--size", "64x0", "Benchmark.json", "7", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "--pin", "Everywhere", "Benchmark.json", "7", "-1", "in.mha", "out.mha" },
+    { "Benchmark", "--min-time", "-1", "Benchmark.json", "7", "-1", "in.mha", "out.mha" }
+  };
+  for (const auto & arguments : invalidArguments)
+  {
+    BenchmarkOptions invalid;
+    if (Parse(arguments, names, invalid))
+    {
+      std::cerr << "An invalid command line is accepted: " << arguments[1] << " " << arguments[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The last valid options remain.
+  if (GetBenchmarkOptions().m_Threads != 4)
+  {
+    std::cerr << "The options of an invalid command line are applied" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The placement of a benchmark does not leak into the next one of the
+  // process.
+  using ExecutionContext = itk::BenchmarkExecutionContext;
+  const auto       defaultPlacement = ExecutionContext::GetEnvironmentSettings().m_ThreadPlacement;
+  BenchmarkOptions pinned;
+  BenchmarkOptions unpinned;
+  const bool       pinnedValid =
+    Parse({ "Benchmark", "--pin", "Compact", "Benchmark.json" }, { "timingsFile" }, pinned);
+  const auto       pinnedPlacement = ExecutionContext::GetSettings().m_ThreadPlacement;
+  const bool       unpinnedValid = Parse({ "Benchmark", "Benchmark.json" }, { "timingsFile" }, unpinned);
+  if (!pinnedValid || pinnedPlacement != ExecutionContext::ThreadPlacementEnum::Compact || !unpinnedValid ||
+      ExecutionContext::GetSettings().m_ThreadPlacement != defaultPlacement)
+  {
+    std::cerr << "The thread placement of a previous command line is kept" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The size of a size sweep overrides the option, and is validated.
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_SIZE=32x16x8");
+  BenchmarkOptions swept;
+  itk::Size<3>     sweptSize;
+  const bool       sweptValid = Parse({ "Benchmark", "--size", "64", "Benchmark.json" }, { "timingsFile" }, swept) &&
+                          GetBenchmarkImageSize(swept, sweptSize);
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_SIZE=0");
+  BenchmarkOptions invalidSweep;
+  const bool       invalidSweepValid = Parse({ "Benchmark", "Benchmark.json" }, { "timingsFile" }, invalidSweep);
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_SIZE");
+  if (!sweptValid || sweptSize[0] != 32 || sweptSize[1] != 16 || sweptSize[2] != 8 || invalidSweepValid)
+  {
+    std::cerr << "The size of the sweep is not applied" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
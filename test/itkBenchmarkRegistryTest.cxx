@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <stdexcept>
+#include "itkBenchmarkRegistry.h"
+#include "PerformanceBenchmarkingUtilities.h"
+
+namespace
+{
+// A fixture that counts how many times it is set up.
+struct CountingFixture
+{
+  CountingFixture() { ++Constructions; }
+
+  static int Constructions;
+  int        Runs{ 0 };
+};
+int CountingFixture::Constructions = 0;
+} // namespace
+
+ITK_PERF_BENCHMARK(RegistryTestSum, CountingFixture, "2", "3")
+{
+  ++fixture.Runs;
+  MultiThreaderName::SetGlobalDefaultNumberOfThreads(1);
+  if (argc != 3 || std::string(argv[0]) != "RegistryTestSum" || argv[argc] != nullptr)
+  {
+    return EXIT_FAILURE;
+  }
+  return std::stoi(argv[1]) + std::stoi(argv[2]) == 5 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+ITK_PERF_BENCHMARK(RegistryTestThrow, CountingFixture, "")
+{
+  ++fixture.Runs;
+  throw std::runtime_error("expected failure");
+}
+
+int
+itkBenchmarkRegistryTest(int, char *[])
+{
+  itk::BenchmarkRegistry & registry = itk::BenchmarkRegistry::GetInstance();
+
+  // The benchmarks register themselves, and are selected by name.
+  const itk::BenchmarkRegistry::BenchmarkEntry * sum = registry.Find("RegistryTestSum");
+  const itk::BenchmarkRegistry::BenchmarkEntry * thrower = registry.Find("RegistryTestThrow");
+  if (sum == nullptr || thrower == nullptr || registry.Find("RegistryTestMissing") != nullptr ||
+      sum->DefaultArguments != itk::BenchmarkRegistry::ArgumentsType{ "2", "3" })
+  {
+    std::cerr << "The benchmarks are not registered" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const auto selected = registry.Select("^RegistryTest(Sum|Throw)$");
+  if (selected.size() != 2 || selected[0] != sum || selected[1] != thrower ||
+      registry.Select("RegistryTestS").size() != 1 || registry.Select("").size() < 2)
+  {
+    std::cerr << "Unexpected selection of " << selected.size() << " benchmarks" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A benchmark gets argv as main() does, and does not change the threads of
+  // the next one.
+  const auto threads = MultiThreaderName::GetGlobalDefaultNumberOfThreads();
+  if (registry.Run(*sum, sum->DefaultArguments) != EXIT_SUCCESS ||
+      registry.Run(*sum, { "2", "4" }) != EXIT_FAILURE ||
+      MultiThreaderName::GetGlobalDefaultNumberOfThreads() != threads)
+  {
+    std::cerr << "Unexpected run of the benchmark" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // An exception fails the benchmark, not the runner.
+  if (registry.Run(*thrower, {}) != EXIT_FAILURE)
+  {
+    std::cerr << "An exception is not a failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The benchmarks share one fixture.
+  if (CountingFixture::Constructions != 1 || registry.GetFixture<CountingFixture>().Runs != 3)
+  {
+    std::cerr << "The fixture is set up " << CountingFixture::Constructions << " times" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A thin wrapper only links one benchmark.
+  char   name[] = "Wrapper";
+  char * argv[] = { name, nullptr };
+  if (itk::BenchmarkRegistry::Main(1, argv) != EXIT_FAILURE)
+  {
+    std::cerr << "Several benchmarks run as one" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include "itkBenchmarkRobustStatistics.h"
+
+namespace
+{
+bool
+AlmostEqual(double a, double b)
+{
+  return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+}
+} // namespace
+
+int
+itkBenchmarkRobustStatisticsTest(int, char *[])
+{
+  using RobustStatistics = itk::BenchmarkRobustStatistics;
+
+  if (std::abs(RobustStatistics::GetStudentT95(1) - 12.706) > 1e-3 ||
+      std::abs(RobustStatistics::GetStudentT95(1000) - 1.962) > 1e-3 ||
+      RobustStatistics::GetStudentT95(31) > RobustStatistics::GetStudentT95(30))
+  {
+    std::cerr << "Unexpected quantiles of Student's t distribution" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Type 7 quantiles interpolate between the closest ranks.
+  const std::vector<int> sortedValues = { 1, 2, 3, 4 };
+  if (!AlmostEqual(RobustStatistics::GetQuantile(sortedValues, 0.5), 2.5) ||
+      !AlmostEqual(RobustStatistics::GetQuantile(sortedValues, 0.9), 3.7) ||
+      !AlmostEqual(RobustStatistics::GetQuantile(sortedValues, 1.5), 4.0) ||
+      RobustStatistics::GetQuantile(std::vector<double>(), 0.5) != 0.0)
+  {
+    std::cerr << "Unexpected quantiles" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A preemption moves the mean far more than the median.
+  const std::vector<double> values = { 9, 1, 8, 2, 7, 3, 100, 6, 4, 5 };
+  const RobustStatistics    statistics = RobustStatistics::Compute(values);
+  std::cout << "Median:           " << statistics.GetMedian() << std::endl;
+  std::cout << "MAD:              " << statistics.GetMedianAbsoluteDeviation() << std::endl;
+  std::cout << "IQR:              " << statistics.GetInterquartileRange() << std::endl;
+  std::cout << "Mean CI:          [" << statistics.GetMeanConfidenceInterval().first << ", "
+            << statistics.GetMeanConfidenceInterval().second << "]" << std::endl;
+  std::cout << "Median CI:        [" << statistics.GetMedianConfidenceInterval().first << ", "
+            << statistics.GetMedianConfidenceInterval().second << "]" << std::endl;
+  if (statistics.GetNumberOfValues() != 10 || !AlmostEqual(statistics.GetMedian(), 5.5) ||
+      !AlmostEqual(statistics.GetMedianAbsoluteDeviation(), 2.5) || !AlmostEqual(statistics.GetFirstQuartile(), 3.25) ||
+      !AlmostEqual(statistics.GetThirdQuartile(), 7.75) || !AlmostEqual(statistics.GetInterquartileRange(), 4.5))
+  {
+    std::cerr << "Unexpected robust statistics" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (statistics.GetNumberOfSevereOutliers() != 1 || statistics.GetNumberOfMildOutliers() != 0)
+  {
+    std::cerr << "Unexpected outliers: " << statistics.GetNumberOfMildOutliers() << " mild, "
+              << statistics.GetNumberOfSevereOutliers() << " severe" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The intervals contain the estimates, and the mean interval is widened by
+  // the outlier. The median interval lies between the 2nd and the 9th values,
+  // for P(B(10, 1/2) <= 1) = 11 / 1024 <= 0.025 < P(B(10, 1/2) <= 2).
+  const RobustStatistics::IntervalType & meanInterval = statistics.GetMeanConfidenceInterval();
+  const RobustStatistics::IntervalType & medianInterval = statistics.GetMedianConfidenceInterval();
+  if (meanInterval.first > 14.5 || meanInterval.second < 14.5 || medianInterval.first > 5.5 ||
+      medianInterval.second < 5.5 ||
+      medianInterval != RobustStatistics::IntervalType(2.0, 9.0) ||
+      medianInterval.second - medianInterval.first >= meanInterval.second - meanInterval.first)
+  {
+    std::cerr << "Unexpected confidence intervals" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // 15 is beyond the inner fence at 7.75 + 1.5 * 4.5, within the outer one.
+  const RobustStatistics mild = RobustStatistics::Compute({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 15 });
+  if (mild.GetNumberOfMildOutliers() != 1 || mild.GetNumberOfSevereOutliers() != 0)
+  {
+    std::cerr << "Unexpected mild outliers" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Of 1, ..., 100, P(B(100, 1/2) <= 39) = 0.018 and P(B(100, 1/2) <= 40) = 0.028.
+  std::vector<double> hundred(100);
+  std::iota(hundred.begin(), hundred.end(), 1.0);
+  if (RobustStatistics::Compute(hundred).GetMedianConfidenceInterval() != RobustStatistics::IntervalType(40.0, 61.0))
+  {
+    std::cerr << "Unexpected median interval of 100 values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const RobustStatistics empty = RobustStatistics::Compute({});
+  const RobustStatistics single = RobustStatistics::Compute({ 2.0 });
+  if (empty.GetNumberOfValues() != 0 || empty.GetMedian() != 0.0 || single.GetMedian() != 2.0 ||
+      single.GetMedianConfidenceInterval() != RobustStatistics::IntervalType(2.0, 2.0) ||
+      single.GetNumberOfSevereOutliers() != 0)
+  {
+    std::cerr << "Unexpected statistics of fewer than two values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "itkBenchmarkSteadyStateDetector.h"
+#include "itkScriptedProbe.h"
+
+namespace
+{
+// Values around 1 with a deterministic 1% noise, after the given warm-up.
+std::vector<double>
+MakeValues(const std::vector<double> & warmUp, unsigned int numberOfSteadyValues)
+{
+  std::vector<double> values(warmUp);
+  for (unsigned int ii = 0; ii < numberOfSteadyValues; ++ii)
+  {
+    values.push_back(1.0 + 0.01 * std::sin(1.7 * ii));
+  }
+  return values;
+}
+} // namespace
+
+int
+itkBenchmarkSteadyStateDetectorTest(int, char *[])
+{
+  using Detector = itk::BenchmarkSteadyStateDetector;
+
+  const std::vector<std::pair<std::vector<double>, itk::SizeValueType>> cases = {
+    { MakeValues({}, 50), 0 },
+    { MakeValues({ 10.0 }, 49), 1 },
+    { MakeValues({ 3.0, 2.0, 1.5 }, 20), 3 },
+    // A step down is a warm-up, a step up is not.
+    { MakeValues(std::vector<double>(10, 2.0), 40), 10 },
+    { MakeValues(std::vector<double>(10, 0.5), 40), 0 },
+    { MakeValues({ 2.0 }, 2), 1 },
+    { MakeValues({ 10.0 }, 1), 0 },
+    { std::vector<double>(10, 1.0), 0 },
+    { {}, 0 },
+  };
+  for (size_t ii = 0; ii < cases.size(); ++ii)
+  {
+    const itk::SizeValueType warmUp = Detector::GetNumberOfWarmUpValues(cases[ii].first);
+    if (warmUp != cases[ii].second)
+    {
+      std::cerr << "Case " << ii << ": " << warmUp << " warm-up values instead of " << cases[ii].second << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The warm-up is excluded from the summary statistics, not from the values.
+  itk::ScriptedProbe probe;
+  for (const double value : MakeValues({ 10.0 }, 20))
+  {
+    probe.Measure(value);
+  }
+  std::cout << "Warm-up: " << probe.GetNumberOfWarmUpIterations() << ", first: " << probe.GetFirstValue()
+            << ", mean: " << probe.GetMean() << ", maximum: " << probe.GetMaximum() << std::endl;
+  if (probe.GetNumberOfWarmUpIterations() != 1 || probe.GetFirstValue() != 10.0 || probe.GetMaximum() > 1.01 ||
+      std::abs(probe.GetMean() - 1.0) > 0.01 || probe.GetQuantile(1.0) > 1.01 || probe.GetTotal() < 10.0 ||
+      probe.GetProbeValueList().size() != 21 || probe.GetNumberOfIteration() != 21)
+  {
+    std::cerr << "The warm-up is not excluded from the summary statistics" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ostringstream json;
+  probe.JSONReport(json);
+  std::cout << json.str() << std::endl;
+  if (json.str().find("\"WarmUpIterations\": 1,") == std::string::npos ||
+      json.str().find("\"FirstIteration\": 10,") == std::string::npos)
+  {
+    std::cerr << "The warm-up is not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  probe.SetExcludeWarmUp(false);
+  if (probe.GetNumberOfWarmUpIterations() != 0 || probe.GetMaximum() != 10.0 || probe.GetQuantile(1.0) != 10.0)
+  {
+    std::cerr << "The warm-up is excluded when it should not" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merged values are not in measurement order, so the warm-up is not detected.
+  probe.SetExcludeWarmUp(true);
+  itk::ScriptedProbe otherProbe;
+  otherProbe.Measure(1.0);
+  probe.Merge(otherProbe);
+  if (probe.GetNumberOfWarmUpIterations() != 0 || probe.GetMaximum() != 10.0)
+  {
+    std::cerr << "The warm-up of merged probes is excluded" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
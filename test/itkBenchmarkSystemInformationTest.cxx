@@ -0,0 +1,97 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "itkBenchmarkSystemInformation.h"
+#include "itkHighPriorityRealTimeProbe.h"
+#include "jsonxx.h"
+
+int
+itkBenchmarkSystemInformationTest(int, char *[])
+{
+  const itk::BenchmarkSystemInformation & systemInformation = itk::BenchmarkSystemInformation::GetInstance();
+  systemInformation.Print(std::cout);
+
+  if (&systemInformation != &itk::BenchmarkSystemInformation::GetInstance())
+  {
+    std::cerr << "The system information is not shared" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The probes print the shared snapshot.
+  itk::HighPriorityRealTimeProbe probe;
+  std::ostringstream             probeJSON;
+  probe.PrintJSONSystemInformation(probeJSON);
+  std::ostringstream json;
+  systemInformation.PrintJSON(json);
+  std::cout << json.str() << std::endl;
+  if (probeJSON.str() != json.str())
+  {
+    std::cerr << "The probe does not print the shared system information" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  jsonxx::Object parsed;
+  if (!parsed.parse(json.str()) || !parsed.has<jsonxx::Object>("Processor") ||
+      !parsed.get<jsonxx::Object>("Processor").has<jsonxx::String>("TurboBoost") ||
+      !parsed.get<jsonxx::Object>("Processor").has<jsonxx::Array>("Caches") ||
+      !parsed.get<jsonxx::Object>("OperatingSystem").has<jsonxx::String>("TransparentHugePages") ||
+      !parsed.has<jsonxx::String>("ITKVersion"))
+  {
+    std::cerr << "The system information is not valid JSON" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (const auto & flag : systemInformation.GetCPUFlags())
+  {
+    if (!systemInformation.HasCPUFlag(flag))
+    {
+      std::cerr << "Flag " << flag << " is listed but not found" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (systemInformation.HasCPUFlag("not-a-flag"))
+  {
+    std::cerr << "Unexpected flag" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A byte fits in the first level, and no cache holds a petabyte.
+  const std::string smallRegime = systemInformation.GetCacheRegime(1);
+  const std::string largeRegime = systemInformation.GetCacheRegime(itk::SizeValueType{ 1 } << 50);
+  std::cout << "Cache regimes: " << smallRegime << ", " << largeRegime << std::endl;
+  if (systemInformation.GetCaches().empty() ? smallRegime != "Unknown" || largeRegime != "Unknown"
+                                            : smallRegime != "L1" || largeRegime != "DRAM")
+  {
+    std::cerr << "Unexpected cache regimes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<unsigned int> expected{ 0, 1, 2, 3, 8, 10, 11 };
+  if (itk::BenchmarkSystemInformation::ParseCPUList("0-3,8,10-11") != expected ||
+      !itk::BenchmarkSystemInformation::ParseCPUList("").empty())
+  {
+    std::cerr << "The CPU list is not parsed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include "itkBenchmarkThreadPlacement.h"
+
+namespace
+{
+
+using PlacementType = itk::BenchmarkThreadPlacement;
+using PolicyEnum = PlacementType::ThreadPlacementEnum;
+
+bool
+CheckOrder(const char * name, const std::vector<unsigned int> & order, const std::vector<unsigned int> & expected)
+{
+  if (order != expected)
+  {
+    std::cerr << name << " order:";
+    for (const unsigned int cpu : order)
+    {
+      std::cerr << ' ' << cpu;
+    }
+    std::cerr << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkBenchmarkThreadPlacementTest(int, char *[])
+{
+  // Two packages with two last level caches of two cores each, numbered
+  // as Linux does on x86: CPU n and n + 8 are the hardware threads of
+  // core n.
+  std::vector<PlacementType::CPUTopology> topology;
+  std::vector<unsigned int>               cpus;
+  for (unsigned int cpu = 0; cpu < 16; ++cpu)
+  {
+    PlacementType::CPUTopology cpuTopology;
+    cpuTopology.m_CPU = cpu;
+    cpuTopology.m_Package = (cpu % 8) / 4;
+    cpuTopology.m_Core = cpu % 4;
+    cpuTopology.m_LastLevelCache = 2 * ((cpu % 8) / 2);
+    topology.push_back(cpuTopology);
+    cpus.push_back(15 - cpu);
+  }
+
+  bool passed = true;
+  passed &= CheckOrder("None", PlacementType::GetCPUOrder(PolicyEnum::None, cpus, topology), cpus);
+  passed &= CheckOrder("Compact",
+                       PlacementType::GetCPUOrder(PolicyEnum::Compact, cpus, topology),
+                       { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+  passed &= CheckOrder("ScatterCores",
+                       PlacementType::GetCPUOrder(PolicyEnum::ScatterCores, cpus, topology),
+                       { 0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15 });
+  passed &= CheckOrder("ScatterCaches",
+                       PlacementType::GetCPUOrder(PolicyEnum::ScatterCaches, cpus, topology),
+                       { 0, 4, 2, 6, 1, 5, 3, 7, 8, 12, 10, 14, 9, 13, 11, 15 });
+  passed &= CheckOrder("SMTSiblings",
+                       PlacementType::GetCPUOrder(PolicyEnum::SMTSiblings, cpus, topology),
+                       { 0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15 });
+
+  // Only the given CPUs are ordered; those of unknown topology come last.
+  passed &= CheckOrder("Subset",
+                       PlacementType::GetCPUOrder(PolicyEnum::Compact, { 20, 9, 8, 1 }, topology),
+                       { 1, 8, 9, 20 });
+
+  PolicyEnum policy;
+  if (!PlacementType::FromString("scatter-caches", policy) || policy != PolicyEnum::ScatterCaches ||
+      !PlacementType::FromString("SMT", policy) || policy != PolicyEnum::SMTSiblings ||
+      PlacementType::FromString("spread", policy))
+  {
+    std::cerr << "Unexpected policy names" << std::endl;
+    passed = false;
+  }
+
+  // The topology of the running system places all its CPUs.
+  const std::vector<unsigned int> order = PlacementType::GetCPUOrder(PolicyEnum::Compact, { 0 });
+  if (order.size() != 1 || order[0] != 0)
+  {
+    std::cerr << "The running system does not place CPU 0" << std::endl;
+    passed = false;
+  }
+
+  if (!passed)
+  {
+    return EXIT_FAILURE;
+  }
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include "itkBenchmarkThreadScaling.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include <itksys/SystemTools.hxx>
+
+int
+itkBenchmarkThreadScalingTest(int, char *[])
+{
+  // Times that follow Amdahl's law with a serial fraction of 0.1.
+  itk::BenchmarkThreadScaling amdahl;
+  if (amdahl.GetReferenceThreads() != 0 || amdahl.GetAmdahlSerialFraction() != 0.0)
+  {
+    std::cerr << "Unexpected scaling without measurements" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int threads = 8; threads >= 1; threads /= 2)
+  {
+    amdahl.AddMeasurement(threads, 2.0 * (0.1 + 0.9 / threads));
+  }
+  if (amdahl.GetThreads() != std::vector<unsigned int>{ 1, 2, 4, 8 } || amdahl.GetReferenceThreads() != 1 ||
+      std::abs(amdahl.GetSpeedup(8) - 1.0 / 0.2125) > 1e-9 ||
+      std::abs(amdahl.GetEfficiency(8) - 1.0 / 0.2125 / 8.0) > 1e-9 || amdahl.GetSpeedup(3) != 0.0 ||
+      std::abs(amdahl.GetAmdahlSerialFraction() - 0.1) > 1e-9)
+  {
+    std::cerr << "Unexpected Amdahl scaling: " << amdahl.GetSpeedup(8) << " " << amdahl.GetAmdahlSerialFraction()
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const unsigned int threads : { 2u, 4u, 8u })
+  {
+    if (std::abs(amdahl.GetKarpFlattSerialFraction(threads) - 0.1) > 1e-9)
+    {
+      std::cerr << "Unexpected Karp-Flatt metric with " << threads << " threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Perfect scaling has no serial fraction, and slower threads one of 1.
+  itk::BenchmarkThreadScaling perfect;
+  itk::BenchmarkThreadScaling slower;
+  for (const unsigned int threads : { 1u, 2u, 4u })
+  {
+    perfect.AddMeasurement(threads, 1.0 / threads);
+    slower.AddMeasurement(threads, threads);
+  }
+  if (perfect.GetAmdahlSerialFraction() != 0.0 || slower.GetAmdahlSerialFraction() != 1.0)
+  {
+    std::cerr << "Unexpected serial fractions of the bounds" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ostringstream json;
+  amdahl.PrintJSON(json);
+  jsonxx::Object scalingObject;
+  if (!scalingObject.parse(json.str()) || !scalingObject.has<jsonxx::Object>("Threads") ||
+      !scalingObject.get<jsonxx::Object>("Threads").has<jsonxx::Object>("8") ||
+      !scalingObject.has<jsonxx::Number>("AmdahlMaximumSpeedup"))
+  {
+    std::cerr << "Invalid JSON: " << json.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << json.str() << std::endl;
+
+  // The unbounded maximum speedup of perfect scaling is null.
+  std::ostringstream perfectJSON;
+  perfect.PrintJSON(perfectJSON);
+  jsonxx::Object perfectObject;
+  if (!perfectObject.parse(perfectJSON.str()) || !perfectObject.has<jsonxx::Null>("AmdahlMaximumSpeedup"))
+  {
+    std::cerr << "Invalid JSON: " << perfectJSON.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The sweeps override the threads of the benchmarks.
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_PREFLIGHT=Off");
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_THREADS=3");
+  const bool setUp = SetUpBenchmarkEnvironment(1);
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_THREADS");
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_PREFLIGHT");
+  if (!setUp || MultiThreaderName::GetGlobalDefaultNumberOfThreads() != 3)
+  {
+    std::cerr << "The threads of the sweep are not applied" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The sweeps read the probes back from the last report.
+  itk::HighPriorityRealTimeProbesCollector collector;
+  collector.Start("Scaled");
+  collector.Stop("Scaled");
+  WriteExpandedReport("itkBenchmarkThreadScalingTest.json", collector, false, false, false);
+  std::remove("itkBenchmarkThreadScalingTest.json");
+  jsonxx::Object report;
+  if (!report.parse(GetLastBenchmarkReport()) || !report.has<jsonxx::Array>("Probes") ||
+      report.get<jsonxx::Array>("Probes").get<jsonxx::Object>(0).get<jsonxx::String>("Name") != "Scaled")
+  {
+    std::cerr << "Unexpected last report: " << GetLastBenchmarkReport() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include "itkBenchmarkVariantScheduler.h"
+#include "PerformanceBenchmarkingUtilities.h"
+#include <itksys/SystemTools.hxx>
+
+int
+itkBenchmarkVariantSchedulerTest(int, char *[])
+{
+  // Each block is a permutation of the variants, drawn reproducibly.
+  itk::BenchmarkVariantScheduler first(4, 7);
+  itk::BenchmarkVariantScheduler second(4, 7);
+  bool                           reordered = false;
+  for (int block = 0; block < 3000; ++block)
+  {
+    const itk::BenchmarkVariantScheduler::OrderType order = first.NextBlock();
+    std::vector<bool>                               seen(4, false);
+    for (const unsigned int variant : order)
+    {
+      seen[variant] = true;
+    }
+    if (std::find(seen.begin(), seen.end(), false) != seen.end() || order != second.NextBlock())
+    {
+      std::cerr << "Unexpected order of block " << block << std::endl;
+      return EXIT_FAILURE;
+    }
+    reordered = reordered || order[0] != 0;
+  }
+  if (!reordered)
+  {
+    std::cerr << "The variants are never reordered" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Every variant is in every position equally often, on average.
+  for (unsigned int variant = 0; variant < 4; ++variant)
+  {
+    if (std::abs(first.GetMeanPosition(variant) - 1.5) > 0.1)
+    {
+      std::cerr << "Unbalanced position of variant " << variant << ": " << first.GetMeanPosition(variant) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A drift common to a block cancels in the paired ratios: the second
+  // variant takes twice as long as the first, the third half as long.
+  constexpr double               costs[] = { 1.0, 2.0, 0.5 };
+  itk::BenchmarkVariantScheduler scheduler(3);
+  for (int block = 0; block < 25; ++block)
+  {
+    const double drift = 1.0 + 0.1 * block;
+    for (const unsigned int variant : scheduler.NextBlock())
+    {
+      scheduler.AddSample(variant, costs[variant] * drift);
+    }
+  }
+  const itk::BenchmarkRobustStatistics slower = scheduler.GetPairedRatioStatistics(1, 0);
+  const itk::BenchmarkRobustStatistics faster = scheduler.GetPairedRatioStatistics(2, 0);
+  if (scheduler.GetNumberOfBlocks() != 25 || std::abs(slower.GetMedian() - 2.0) > 1e-12 ||
+      std::abs(slower.GetMedianConfidenceInterval().second - 2.0) > 1e-12 ||
+      std::abs(faster.GetMedian() - 0.5) > 1e-12 || scheduler.GetNumberOfFasterBlocks(1, 0) != 0 ||
+      scheduler.GetNumberOfFasterBlocks(2, 0) != 25)
+  {
+    std::cerr << "Unexpected paired ratios: " << slower.GetMedian() << ", " << faster.GetMedian() << std::endl;
+    return EXIT_FAILURE;
+  }
+  scheduler.PrintJSON(std::cout, { "One", "Two", "Half" });
+  std::cout << std::endl;
+
+  // The variants of a benchmark are interleaved, and compared in the reports.
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS=5");
+  itksys::SystemTools::PutEnv("ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS=5");
+  itk::HighPriorityRealTimeProbesCollector collector;
+  std::string                              sequence;
+  TimeVariants(collector,
+               "Letters",
+               { { "A", [&sequence]() { sequence += 'A'; } }, { "B", [&sequence]() { sequence += 'B'; } } },
+               2);
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_MIN_ITERATIONS");
+  itksys::SystemTools::UnPutEnv("ITKPERFORMANCEBENCHMARK_MAX_ITERATIONS");
+  jsonxx::Object decorated;
+  decorated.parse(DecorateWithBuildInformation("{}"));
+  // One untimed run of each variant, then 5 blocks of one run of each.
+  if (sequence.size() != 12 || std::count(sequence.begin(), sequence.end(), 'A') != 6 ||
+      collector.GetProbe("B").GetNumberOfStops() != 5 ||
+      !decorated.has<jsonxx::Object>("VariantComparison") ||
+      decorated.get<jsonxx::Object>("VariantComparison").get<jsonxx::Object>("Letters").get<jsonxx::Number>(
+        "Blocks") != 5)
+  {
+    std::cerr << "The variants are not interleaved or not reported: " << sequence << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << sequence << std::endl;
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "itkCPUTimeProbesCollector.h"
+
+int
+itkCPUTimeProbeTest(int, char *[])
+{
+  constexpr unsigned int iterations = 5;
+
+  itk::CPUTimeProbesCollector collector;
+  const auto                  busy = collector.GetProbeHandle("Busy");
+  const auto                  sleeping = collector.GetProbeHandle("Sleeping");
+
+  double sum = 0.0;
+  for (unsigned int it = 0; it < iterations; ++it)
+  {
+    collector.Start(busy);
+    for (unsigned int ii = 0; ii < 10000000; ++ii)
+    {
+      sum += ii;
+    }
+    collector.Stop(busy);
+
+    collector.Start(sleeping);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    collector.Stop(sleeping);
+  }
+  std::cout << "Sum: " << sum << std::endl;
+
+  collector.Report();
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport, false);
+  std::cout << jsonReport.str();
+
+  const itk::CPUTimeProbe & busyProbe = collector.GetProbe(busy);
+  const itk::CPUTimeProbe & sleepingProbe = collector.GetProbe(sleeping);
+  std::cout << "Busy utilization:     " << busyProbe.GetCPUUtilization() << std::endl;
+  std::cout << "Sleeping utilization: " << sleepingProbe.GetCPUUtilization() << std::endl;
+
+  // One thread computing is busy all the time, a sleeping one is not.
+  if (busyProbe.GetWallTimeValues().size() != iterations || !(busyProbe.GetTotal() > 0.0) ||
+      busyProbe.GetCPUUtilization() < 0.5 || busyProbe.GetCPUUtilization() > 1.5)
+  {
+    std::cerr << "Unexpected CPU time of a busy thread" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (sleepingProbe.GetTotalWallTime() < iterations * 0.02 || sleepingProbe.GetCPUUtilization() > 0.5)
+  {
+    std::cerr << "Unexpected CPU time of a sleeping thread" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!(busyProbe.GetParallelEfficiency() > 0.0) ||
+      jsonReport.str().find("\"ParallelEfficiency\"") == std::string::npos ||
+      jsonReport.str().find("\"VoluntaryContextSwitches\"") == std::string::npos)
+  {
+    std::cerr << "The efficiency is not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "itkHighPriorityRealTimeProbesCollector.h"
+
+int
+itkConcurrentProbesCollectorTest(int, char *[])
+{
+  constexpr unsigned int numberOfThreads = 4;
+  constexpr unsigned int iterations = 1000;
+
+  itk::HighPriorityRealTimeConcurrentProbesCollector collector;
+  const auto                                         workUnit = collector.GetProbeHandle("WorkUnit");
+
+  std::vector<std::thread> threads;
+  for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+  {
+    threads.emplace_back([&collector, workUnit, thread]() {
+      double sum = 0.0;
+      for (unsigned int ii = 0; ii < iterations; ++ii)
+      {
+        collector.Start(workUnit);
+        // Uneven work, so that the threads are imbalanced.
+        for (unsigned int jj = 0; jj < 100 * (thread + 1); ++jj)
+        {
+          sum += jj;
+        }
+        collector.Stop(workUnit);
+
+        // Probes can also be addressed by name, or by scope, from any thread.
+        collector.Start("Named");
+        collector.Stop("Named");
+        itk::HighPriorityRealTimeConcurrentProbesCollector::ScopedProbe scope(collector, "Scope");
+      }
+      // Use the sum, so that the loop is not optimized away.
+      if (sum < 0.0)
+      {
+        std::cout << sum << std::endl;
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+
+  collector.Report();
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport, false);
+  std::cout << jsonReport.str();
+
+  std::cout << "Threads: " << collector.GetNumberOfThreads() << std::endl;
+  if (collector.GetNumberOfThreads() != numberOfThreads)
+  {
+    std::cerr << "Unexpected number of threads" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (const char * name : { "WorkUnit", "Named", "Scope" })
+  {
+    if (collector.GetProbe(name).GetNumberOfIteration() != numberOfThreads * iterations ||
+        collector.GetProbe(name).GetProbeValueList().size() != numberOfThreads * iterations)
+    {
+      std::cerr << "The probes of the threads are not merged: " << name << " has "
+                << collector.GetProbe(name).GetNumberOfIteration() << " iterations" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (jsonReport.str().find("\"ThreadStatistics\"") == std::string::npos ||
+      jsonReport.str().find("\"LoadImbalance\"") == std::string::npos)
+  {
+    std::cerr << "The thread statistics are missing from the JSON report" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merging again does not count the values twice.
+  collector.MergeThreadProbes();
+  if (collector.GetProbe(workUnit).GetNumberOfIteration() != numberOfThreads * iterations)
+  {
+    std::cerr << "MergeThreadProbes() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  collector.Clear();
+  collector.Start("AfterClear");
+  collector.Stop("AfterClear");
+  collector.MergeThreadProbes();
+  if (collector.GetProbe("AfterClear").GetNumberOfIteration() != 1)
+  {
+    std::cerr << "Clear() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The overhead is calibrated when the first probe is registered.
+  itk::HighPriorityRealTimeConcurrentProbesCollector calibrated;
+  calibrated.GetProbeHandle("Calibrated");
+  std::cout << "Probe overhead: " << calibrated.GetProbeOverhead() << " s, minimum "
+            << calibrated.GetMinimumProbeOverhead() << " s" << std::endl;
+  if (!std::isfinite(calibrated.GetProbeOverhead()) || calibrated.GetProbeOverhead() < 0.0 ||
+      calibrated.GetMinimumProbeOverhead() > calibrated.GetProbeOverhead())
+  {
+    std::cerr << "Overhead calibration failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
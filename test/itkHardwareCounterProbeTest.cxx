@@ -0,0 +1,81 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <sstream>
+#include "itkHardwareCounterProbesCollector.h"
+
+int
+itkHardwareCounterProbeTest(int, char *[])
+{
+  using CounterEnum = itk::HardwareCounterProbe::HardwareCounterEnum;
+
+  constexpr unsigned int iterations = 10;
+
+  itk::HardwareCounterProbesCollector collector;
+  const auto                          loop = collector.GetProbeHandle("Loop");
+  double                              sum = 0.0;
+  for (unsigned int it = 0; it < iterations; ++it)
+  {
+    collector.Start(loop);
+    for (unsigned int ii = 0; ii < 1000000; ++ii)
+    {
+      sum += ii;
+    }
+    collector.Stop(loop);
+  }
+  std::cout << "Sum: " << sum << std::endl;
+
+  collector.Report();
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport);
+  std::cout << jsonReport.str();
+
+  const itk::HardwareCounterProbe & probe = collector.GetProbe(loop);
+  if (probe.GetNumberOfIteration() != iterations || probe.GetCounterValues(CounterEnum::Cycles).size() != iterations)
+  {
+    std::cerr << "The counters are not recorded for every iteration" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!collector.IsAvailable())
+  {
+    // The probe must still work, and measure nothing.
+    std::cout << "Hardware counters are not available: " << probe.GetUnavailabilityReason() << std::endl;
+    if (probe.GetTotal() != 0.0 || probe.GetUnavailabilityReason().empty() ||
+        jsonReport.str().find("\"HardwareCountersAvailable\": false") == std::string::npos)
+    {
+      std::cerr << "The unavailable counters do not fall back cleanly" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "[PASSED]" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  std::cout << "Instructions per cycle: " << probe.GetInstructionsPerCycle() << std::endl;
+  if (probe.GetCounterTotal(CounterEnum::Instructions) < iterations * 1000000.0 ||
+      !(probe.GetInstructionsPerCycle() > 0.0) ||
+      jsonReport.str().find("\"InstructionsPerCycle\"") == std::string::npos)
+  {
+    std::cerr << "Unexpected counter values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "itkHeapAllocationProbesCollector.h"
+#include "itkHighPriorityRealTimeProbesCollector.h"
+
+namespace
+{
+// Not inlined, so that it is a call site of its own.
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+std::unique_ptr<double>
+AllocateDouble(double value)
+{
+  return std::unique_ptr<double>(new double(value));
+}
+} // namespace
+
+int
+itkHeapAllocationProbeTest(int, char *[])
+{
+  constexpr unsigned int iterations = 4;
+  constexpr unsigned int allocations = 100;
+
+  std::cout << "Heap allocation tracking available: " << itk::HeapAllocationTracker::IsAvailable() << std::endl;
+
+  itk::HeapAllocationProbesCollector collector;
+  collector.SetRecordCallSites(true);
+  const auto allocate = collector.GetProbeHandle("Allocate");
+
+  double sum = 0.0;
+  for (unsigned int it = 0; it < iterations; ++it)
+  {
+    collector.Start(allocate);
+    for (unsigned int ii = 0; ii < allocations; ++ii)
+    {
+      sum += *AllocateDouble(ii);
+    }
+    collector.Stop(allocate);
+  }
+  std::cout << "Sum: " << sum << std::endl;
+
+  collector.Report();
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport, false);
+  std::cout << jsonReport.str();
+
+  const itk::HeapAllocationProbe & probe = collector.GetProbe(allocate);
+  if (probe.GetNumberOfStops() != iterations || probe.GetAllocatedBytesValues().size() != iterations ||
+      jsonReport.str().find("\"HeapAllocationTrackingAvailable\"") == std::string::npos)
+  {
+    std::cerr << "The allocations are not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (itk::HeapAllocationTracker::IsAvailable())
+  {
+    // Every iteration allocates and frees the doubles.
+    if (probe.GetMinimum() < allocations || probe.GetAllocatedBytesValues()[0] < allocations * sizeof(double) ||
+        probe.GetDeallocationsValues()[0] < allocations)
+    {
+      std::cerr << "The allocations are not counted" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const auto callSites = probe.GetTopCallSites(1);
+    if (callSites.empty() || callSites[0].m_Allocations < iterations * allocations)
+    {
+      std::cerr << "The call site of the allocations is not recorded" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "Top call site: " << itk::HeapAllocationTracker::GetCallSiteName(callSites[0].m_Address)
+              << std::endl;
+  }
+  else if (probe.GetTotal() != 0.0)
+  {
+    std::cerr << "Allocations are counted without tracking" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The time probes are paired with allocation probes on request.
+  itk::HighPriorityRealTimeProbesCollector timeCollector;
+  timeCollector.SetAllocationProbesEnabled(true);
+  timeCollector.Start("Allocate");
+  sum += *AllocateDouble(1.0);
+  timeCollector.Stop("Allocate");
+  std::ostringstream timeJSONReport;
+  timeCollector.JSONReport(timeJSONReport, false);
+  if (timeCollector.GetAllocationProbes().GetProbe("Allocate").GetNumberOfStops() != 1 ||
+      timeJSONReport.str().find("\"AllocationProbes\"") == std::string::npos)
+  {
+    std::cerr << "The allocation probes of the time probes are not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
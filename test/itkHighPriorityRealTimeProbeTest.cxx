@@ -16,9 +16,12 @@
  *
  *=========================================================================*/
 
+#include <cmath>
 #include <iostream>
 #include "itkHighPriorityRealTimeProbe.h"
 #include "itkMath.h"
+#include "jsonxx.h"
+#include <sstream>
 
 // Check the validation of resource probe's result
 bool
@@ -99,6 +102,26 @@ itkHighPriorityRealTimeProbeTest(int, char *[])
   std::cout << std::endl << "Print an expanded report" << std::endl;
   localTimer.ExpandedReport();
 
+  // The throughput of the median is reported with the workload.
+  localTimer.SetWorkload(1000, 8000);
+  std::ostringstream json;
+  localTimer.JSONReport(json);
+  jsonxx::Object report;
+  if (!report.parse(json.str()) || !report.has<jsonxx::Number>("VoxelsPerSecond") ||
+      !report.has<jsonxx::Number>("BytesPerSecond") || !report.has<jsonxx::String>("CacheRegime") ||
+      report.get<jsonxx::Number>("WorkloadBytes") != 8000)
+  {
+    std::cerr << "The workload is not reported: " << json.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const double median = report.get<jsonxx::Number>("Median");
+  if (std::abs(report.get<jsonxx::Number>("VoxelsPerSecond") * median / 1000 - 1) > 1e-3 ||
+      std::abs(report.get<jsonxx::Number>("BytesPerSecond") * median / 8000 - 1) > 1e-3)
+  {
+    std::cerr << "Unexpected throughput: " << json.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // invoke reset
   localTimer.Reset();
 
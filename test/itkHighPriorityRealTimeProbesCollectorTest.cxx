@@ -23,6 +23,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 template <typename T>
 void
@@ -180,6 +181,138 @@ itkHighPriorityRealTimeProbesCollectorTest(int, char *[])
   std::cout << std::endl << "Print normal reports from all probes to the standard error" << std::endl;
   collector.Report(std::cerr);
 
+  // Handles address the same probes as their names
+  const auto loop1 = collector.GetProbeHandle("Loop1");
+  if (loop1 != collector.GetProbeHandle("Loop1") || &collector.GetProbe(loop1) != &collector.GetProbe("Loop1"))
+  {
+    std::cerr << "GetProbeHandle() does not identify the named probe" << std::endl;
+    return EXIT_FAILURE;
+  }
+  collector.Start(loop1);
+  collector.Stop(loop1);
+  if (collector.GetProbe("Loop1").GetNumberOfStops() != iteration + 1)
+  {
+    std::cerr << "Start/Stop through a handle failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto handleProbe = collector.GetProbeHandle("HandleOnly");
+  collector.Start(handleProbe);
+  collector.Stop("HandleOnly");
+  if (collector.GetProbe(handleProbe).GetNumberOfStops() != 1)
+  {
+    std::cerr << "Probe registered with GetProbeHandle() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The empty Start()/Stop() cost is calibrated with the first probe.
+  std::cout << "Probe overhead: " << collector.GetProbeOverhead() << " s (minimum "
+            << collector.GetMinimumProbeOverhead() << " s)" << std::endl;
+  if (collector.GetProbeOverhead() < collector.GetMinimumProbeOverhead() || collector.GetMinimumProbeOverhead() < 0 ||
+      collector.GetSubtractOverhead())
+  {
+    std::cerr << "Overhead calibration failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport, false);
+  if (jsonReport.str().find("\"ProbeOverhead\"") == std::string::npos)
+  {
+    std::cerr << "The probe overhead is missing from the JSON report" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Subtracting the overhead brings empty regions down to about zero.
+  collector.SetSubtractOverhead(true);
+  const auto emptyProbe = collector.GetProbeHandle("Empty");
+  for (unsigned int it = 0; it < 1000; ++it)
+  {
+    collector.Start(emptyProbe);
+    collector.Stop(emptyProbe);
+  }
+  std::cout << "Corrected empty region: " << collector.GetProbe(emptyProbe).GetQuantile(0.5) << " s" << std::endl;
+  if (collector.GetProbe(emptyProbe).GetMinimum() < 0 ||
+      collector.GetProbe(emptyProbe).GetOverheadCorrection() != collector.GetProbeOverhead() ||
+      collector.GetProbe("Loop1").GetOverheadCorrection() != collector.GetProbeOverhead())
+  {
+    std::cerr << "Overhead subtraction failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  collector.SetSubtractOverhead(false);
+  if (collector.GetProbe(emptyProbe).GetOverheadCorrection() != 0)
+  {
+    std::cerr << "Overhead subtraction is not disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Scoped probes are named after, and nested in, their enclosing scopes.
+  itk::HighPriorityRealTimeProbesCollector scopedCollector;
+  for (unsigned int it = 0; it < iteration; ++it)
+  {
+    itk::HighPriorityRealTimeProbesCollector::ScopedProbe outer(scopedCollector, "Outer");
+    {
+      itk::HighPriorityRealTimeProbesCollector::ScopedProbe inner(scopedCollector, "Inner");
+      auto *                                                 dummy = new char[M];
+      for (unsigned int j = 0; j < M; j++)
+      {
+        dummy[j] = j;
+      }
+      delete[] dummy;
+    }
+  }
+  const auto outer = scopedCollector.GetProbeHandle("Outer");
+  const auto inner = scopedCollector.GetProbeHandle("Outer/Inner");
+  scopedCollector.CallTreeReport();
+  if (scopedCollector.GetParentHandle(inner) != outer ||
+      scopedCollector.GetParentHandle(outer) != itk::HighPriorityRealTimeProbesCollector::NoParentHandle ||
+      scopedCollector.GetProbe(inner).GetNumberOfStops() != iteration ||
+      scopedCollector.GetExclusiveTotal(outer) > scopedCollector.GetProbe(outer).GetTotal() ||
+      scopedCollector.GetExclusiveTotal(inner) != scopedCollector.GetProbe(inner).GetTotal())
+  {
+    std::cerr << "Scoped probes failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::ostringstream callTreeReport;
+  scopedCollector.JSONReport(callTreeReport, false);
+  std::cout << callTreeReport.str();
+  if (callTreeReport.str().find("\"CallTree\"") == std::string::npos)
+  {
+    std::cerr << "The call tree is missing from the JSON report" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A scope open across Clear() does not stop the new probe with its handle.
+  {
+    itk::HighPriorityRealTimeProbesCollector::ScopedProbe stale(scopedCollector, "Stale");
+    scopedCollector.Clear();
+    scopedCollector.Start("Fresh");
+    scopedCollector.Stop("Fresh");
+  }
+  if (scopedCollector.GetProbe("Fresh").GetNumberOfStarts() != 1 ||
+      scopedCollector.GetProbe("Fresh").GetNumberOfStops() != 1)
+  {
+    std::cerr << "A stale scope stopped another probe" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Only the current scope can be stopped.
+  const auto current = scopedCollector.StartScope("Current");
+  bool       caught = false;
+  try
+  {
+    scopedCollector.StopScope(scopedCollector.GetProbeHandle("Fresh"));
+  }
+  catch (const itk::ExceptionObject &)
+  {
+    caught = true;
+  }
+  scopedCollector.StopScope(current);
+  if (!caught || scopedCollector.GetProbe(current).GetNumberOfStops() != 1)
+  {
+    std::cerr << "StopScope() of a scope that is not the current one failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
 
   return EXIT_SUCCESS;
 }
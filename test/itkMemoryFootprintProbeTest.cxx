@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "itkMemoryFootprintProbesCollector.h"
+#include "itkHighPriorityRealTimeProbesCollector.h"
+
+int
+itkMemoryFootprintProbeTest(int, char *[])
+{
+  constexpr unsigned int iterations = 3;
+  constexpr size_t       bufferSize = 64 * 1024 * 1024;
+
+  itk::MemoryFootprintProbesCollector collector;
+  const auto                          allocate = collector.GetProbeHandle("Allocate");
+
+  std::vector<char> kept;
+  for (unsigned int it = 0; it < iterations; ++it)
+  {
+    collector.Start(allocate);
+    std::vector<char> buffer(bufferSize);
+    std::memset(buffer.data(), static_cast<int>(it + 1), buffer.size());
+    if (it == 0)
+    {
+      kept.swap(buffer);
+    }
+    collector.Stop(allocate);
+  }
+  std::cout << "Kept: " << static_cast<int>(kept[bufferSize / 2]) << std::endl;
+
+  collector.Report();
+  std::ostringstream jsonReport;
+  collector.JSONReport(jsonReport, false);
+  std::cout << jsonReport.str();
+
+  const itk::MemoryFootprintProbe & probe = collector.GetProbe(allocate);
+  if (probe.GetNumberOfStops() != iterations ||
+      jsonReport.str().find("\"PeakResidentSetSize\"") == std::string::npos ||
+      jsonReport.str().find("\"MinorPageFaults\"") == std::string::npos)
+  {
+    std::cerr << "The memory footprint is not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The peak and the page faults are only measured where /proc is available.
+  if (std::ifstream("/proc/self/status").good())
+  {
+    constexpr double bufferSizeInKB = bufferSize / 1024.0;
+    std::cout << "Peak: " << probe.GetPeak() << " kB, increase: " << probe.GetPeakIncrease() << " kB" << std::endl;
+    if (probe.GetPeakValues().size() != iterations || probe.GetMinorPageFaultValues().size() != iterations)
+    {
+      std::cerr << "Missing peak or page fault values" << std::endl;
+      return EXIT_FAILURE;
+    }
+    // The kept buffer stays resident, the others are released.
+    if (probe.GetProbeValueList()[0] < 0.5 * bufferSizeInKB)
+    {
+      std::cerr << "The resident set size of the kept buffer is not measured" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (probe.GetPeakResetAvailable() && probe.GetPeakIncrease() < 0.5 * bufferSizeInKB)
+    {
+      std::cerr << "The peak resident set size is not measured" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (probe.GetMinorPageFaultValues()[0] == 0)
+    {
+      std::cerr << "The page faults of the touched buffer are not counted" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The time probes are paired with memory probes on request.
+  itk::HighPriorityRealTimeProbesCollector timeCollector;
+  timeCollector.SetMemoryProbesEnabled(true);
+  timeCollector.Start("Touch");
+  std::vector<char> touched(bufferSize / 4, 1);
+  timeCollector.Stop("Touch");
+  std::ostringstream timeJSONReport;
+  timeCollector.JSONReport(timeJSONReport, false);
+  std::cout << timeJSONReport.str();
+  if (timeCollector.GetMemoryProbes().GetProbe("Touch").GetNumberOfStops() != 1 ||
+      timeJSONReport.str().find("\"MemoryProbes\"") == std::string::npos)
+  {
+    std::cerr << "The memory probes of the time probes are not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  timeCollector.Clear();
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
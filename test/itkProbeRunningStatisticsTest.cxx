@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "itkProbeRunningStatistics.h"
+#include "itkHighPriorityRealTimeProbe.h"
+#include "itkScriptedProbe.h"
+
+namespace
+{
+bool
+AlmostEqual(double a, double b)
+{
+  return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b));
+}
+} // namespace
+
+int
+itkProbeRunningStatisticsTest(int, char *[])
+{
+  // Compare the streaming moments with a two-pass computation.
+  const std::vector<double> values = { 1.5, 2.25, 0.75, 4.0, 3.5, 2.0, 1.0, 5.25 };
+
+  itk::ProbeRunningStatistics<double, double> statistics;
+  for (const double value : values)
+  {
+    statistics.AddValue(value);
+  }
+
+  double total = 0.0;
+  for (const double value : values)
+  {
+    total += value;
+  }
+  const double mean = total / values.size();
+  double       sumOfSquares = 0.0;
+  for (const double value : values)
+  {
+    sumOfSquares += (value - mean) * (value - mean);
+  }
+  const double standardDeviation = std::sqrt(sumOfSquares / (values.size() - 1));
+
+  std::cout << "Count:              " << statistics.GetCount() << std::endl;
+  std::cout << "Total:              " << statistics.GetTotal() << std::endl;
+  std::cout << "Mean:               " << statistics.GetMean() << std::endl;
+  std::cout << "Standard deviation: " << statistics.GetStandardDeviation() << std::endl;
+
+  if (statistics.GetCount() != values.size() || !AlmostEqual(statistics.GetTotal(), total) ||
+      !AlmostEqual(statistics.GetMean(), mean) || !AlmostEqual(statistics.GetStandardDeviation(), standardDeviation) ||
+      !AlmostEqual(statistics.GetStandardError(), standardDeviation / std::sqrt(values.size())))
+  {
+    std::cerr << "Running statistics differ from the two-pass computation" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Merging the statistics of two halves gives the statistics of the whole.
+  itk::ProbeRunningStatistics<double, double> firstHalf;
+  itk::ProbeRunningStatistics<double, double> secondHalf;
+  for (size_t ii = 0; ii < values.size(); ++ii)
+  {
+    (ii < 3 ? firstHalf : secondHalf).AddValue(values[ii]);
+  }
+  firstHalf.Merge(secondHalf);
+  if (firstHalf.GetCount() != values.size() || !AlmostEqual(firstHalf.GetTotal(), total) ||
+      !AlmostEqual(firstHalf.GetMean(), mean) || !AlmostEqual(firstHalf.GetStandardDeviation(), standardDeviation))
+  {
+    std::cerr << "Merge() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  statistics.Reset();
+  if (statistics.GetCount() != 0 || statistics.GetStandardDeviation() != 0.0 || statistics.GetStandardError() != 0.0)
+  {
+    std::cerr << "Reset() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Percentiles of 1, 2, ..., 101 interpolate between the closest ranks.
+  // The decreasing values would otherwise be taken for a warm-up.
+  itk::ScriptedProbe scriptedProbe;
+  scriptedProbe.SetExcludeWarmUp(false);
+  for (unsigned int ii = 101; ii > 0; --ii)
+  {
+    scriptedProbe.Measure(ii);
+  }
+  std::cout << "P50:                " << scriptedProbe.GetQuantile(0.5) << std::endl;
+  std::cout << "P99.9:              " << scriptedProbe.GetQuantile(0.999) << std::endl;
+  if (!AlmostEqual(scriptedProbe.GetQuantile(0.0), 1.0) || !AlmostEqual(scriptedProbe.GetQuantile(0.5), 51.0) ||
+      !AlmostEqual(scriptedProbe.GetQuantile(0.9), 91.0) || !AlmostEqual(scriptedProbe.GetQuantile(0.999), 100.9) ||
+      !AlmostEqual(scriptedProbe.GetQuantile(1.0), 101.0))
+  {
+    std::cerr << "GetQuantile() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const itk::BenchmarkRobustStatistics & robustStatistics = scriptedProbe.GetRobustStatistics();
+  if (!AlmostEqual(scriptedProbe.GetMedian(), 51.0) ||
+      !AlmostEqual(robustStatistics.GetMedianAbsoluteDeviation(), 25.0) ||
+      !AlmostEqual(robustStatistics.GetInterquartileRange(), 50.0) || robustStatistics.GetNumberOfMildOutliers() != 0 ||
+      robustStatistics.GetNumberOfSevereOutliers() != 0)
+  {
+    std::cerr << "GetRobustStatistics() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Negative values, e.g. memory that was released, have a negative maximum.
+  itk::ScriptedProbe negativeProbe;
+  negativeProbe.SetExcludeWarmUp(false);
+  for (const double value : { -3.0, -1.0, -2.0 })
+  {
+    negativeProbe.Measure(value);
+  }
+  if (!AlmostEqual(negativeProbe.GetMinimum(), -3.0) || !AlmostEqual(negativeProbe.GetMaximum(), -1.0))
+  {
+    std::cerr << "Minimum or maximum of negative values failure: " << negativeProbe.GetMinimum() << ", "
+              << negativeProbe.GetMaximum() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // A bounded probe keeps a fixed size sample but accounts for every stop.
+  constexpr itk::SizeValueType   maximumNumberOfStoredValues = 16;
+  constexpr unsigned int         iterations = 1000;
+  itk::HighPriorityRealTimeProbe probe;
+  probe.SetMaximumNumberOfStoredValues(maximumNumberOfStoredValues);
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    probe.Start();
+    probe.Stop();
+  }
+  std::cout << "Stored values:      " << probe.GetProbeValueList().size() << " of " << probe.GetNumberOfIteration()
+            << std::endl;
+  if (probe.GetProbeValueList().size() != maximumNumberOfStoredValues || probe.GetNumberOfIteration() != iterations)
+  {
+    std::cerr << "Reservoir sampling failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (probe.GetMean() < probe.GetMinimum() || probe.GetMaximum() < probe.GetMean() || probe.GetStandardDeviation() < 0)
+  {
+    std::cerr << "Inconsistent statistics of the bounded probe" << std::endl;
+    return EXIT_FAILURE;
+  }
+  probe.JSONReport(std::cout);
+  std::cout << std::endl;
+
+  // Lowering the bound keeps a uniform sample of 1, 2, ..., 1000, not the
+  // first values.
+  itk::ScriptedProbe lowered;
+  for (unsigned int ii = 1; ii <= iterations; ++ii)
+  {
+    lowered.Measure(ii);
+  }
+  lowered.SetMaximumNumberOfStoredValues(100);
+  double sumOfStoredValues = 0.0;
+  for (const double value : lowered.GetProbeValueList())
+  {
+    sumOfStoredValues += value;
+  }
+  std::cout << "Lowered bound mean: " << sumOfStoredValues / 100.0 << std::endl;
+  if (lowered.GetProbeValueList().size() != 100 || sumOfStoredValues / 100.0 < 400.0 ||
+      sumOfStoredValues / 100.0 > 600.0)
+  {
+    std::cerr << "SetMaximumNumberOfStoredValues() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // 900 values of 1 merged with 100 values of 2 keep about 10% of 2.
+  itk::ScriptedProbe ones;
+  itk::ScriptedProbe twos;
+  ones.SetMaximumNumberOfStoredValues(100);
+  twos.SetMaximumNumberOfStoredValues(100);
+  for (unsigned int ii = 0; ii < 900; ++ii)
+  {
+    ones.Measure(1.0);
+  }
+  for (unsigned int ii = 0; ii < 100; ++ii)
+  {
+    twos.Measure(2.0);
+  }
+  ones.Merge(twos);
+  unsigned int numberOfTwos = 0;
+  for (const double value : ones.GetProbeValueList())
+  {
+    numberOfTwos += value == 2.0 ? 1 : 0;
+  }
+  std::cout << "Merged values of 2: " << numberOfTwos << " of " << ones.GetProbeValueList().size() << std::endl;
+  if (ones.GetProbeValueList().size() != 100 || numberOfTwos > 25)
+  {
+    std::cerr << "Weighted Merge() failure" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "[PASSED]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,58 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkScriptedProbe_h
+#define itkScriptedProbe_h
+
+#include "LOCAL_itkResourceProbe.h"
+
+namespace itk
+{
+/** \class ScriptedProbe
+ * \brief A probe of the tests, whose measured values are chosen by the test.
+ *
+ * \ingroup PerformanceBenchmarking
+ */
+class ScriptedProbe : public LOCAL_ResourceProbe<double, double>
+{
+public:
+  ScriptedProbe()
+    : LOCAL_ResourceProbe<double, double>("Scripted", "u")
+  {}
+
+  /** Records one iteration whose value is value. */
+  void
+  Measure(double value)
+  {
+    m_Now = 0.0;
+    this->Start();
+    m_Now = value;
+    this->Stop();
+  }
+
+  double
+  GetInstantValue() const override
+  {
+    return m_Now;
+  }
+
+private:
+  double m_Now{ 0.0 };
+};
+} // end namespace itk
+
+#endif // itkScriptedProbe_h